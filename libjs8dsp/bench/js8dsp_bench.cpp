@@ -0,0 +1,465 @@
+/**
+ * Benchmarks of the libjs8dsp hot paths
+ *
+ * Stage benchmarks run the kernels each decoder stage is built from at
+ * that stage's sizes for every mode; end-to-end benchmarks decode
+ * deterministic synthetic slots with a number of signals at a given SNR.
+ * Results are JSON on stdout unless another --benchmark_format is given.
+ */
+
+#include "js8dsp.h"
+#include "baseline_computation.h"
+#include "bp_decoder.h"
+#include "fft.h"
+#include "frame_codec.h"
+#include "js8_constants.h"
+#include "js8_encoder.h"
+#include "osd_decoder.h"
+#include "resampler.h"
+#include "sync_kernels.h"
+#include "varicode.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace JS8Constants;
+
+namespace {
+
+constexpr int SYNC_SHIFTS = 5;      // Fine frequency shifts per sync correlation, as the decoder
+constexpr uint32_t SEED = 0x4a533844;
+constexpr int MAX_RESULTS = 256;   // Decode results kept per slot
+
+const char* const MODE_NAMES[] = {"normal", "fast", "turbo", "slow", "ultra"};
+
+void apply_mode_args(benchmark::internal::Benchmark* b) {
+    for (int mode = JS8DSP_MODE_NORMAL; mode <= JS8DSP_MODE_ULTRA; ++mode) b->Arg(mode);
+    b->ArgName("mode");
+}
+
+// Sizes the decoder derives from getModeParams
+struct StageSizes {
+    int symbol_samples;         // Downsampled samples per symbol
+    int ndfft1;                 // Baseband transform of the slot
+    int ndfft2;                 // Downsampled transform per candidate
+    int time_steps;             // Sync map offsets
+
+    explicit StageSizes(int mode) {
+        const ModeParams params = getModeParams(static_cast<Mode>(mode));
+        symbol_samples = params.ndownsps;
+        ndfft1 = params.nsps * params.ndd;
+        ndfft2 = ndfft1 / (params.nsps / params.ndownsps);
+        const int step = std::max(1, params.ndownsps / 4);
+        time_steps = std::max(0, ndfft2 - NN * params.ndownsps) / step + 1;
+    }
+};
+
+std::vector<float> random_floats(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+    std::vector<float> values(count);
+    for (auto& v : values) v = normal(rng);
+    return values;
+}
+
+// Costas sync map of one candidate: 21 sync symbols correlated against
+// SYNC_SHIFTS tone shifts at every quarter-symbol offset
+void BM_SyncMap(benchmark::State& state) {
+    const StageSizes sizes(static_cast<int>(state.range(0)));
+    const int n = sizes.symbol_samples;
+    const int step = std::max(1, n / 4);
+    const auto x_re = random_floats(sizes.ndfft2, SEED);
+    const auto x_im = random_floats(sizes.ndfft2, SEED + 1);
+    const auto t_re = random_floats(static_cast<size_t>(n) * SYNC_SHIFTS, SEED + 2);
+    const auto t_im = random_floats(static_cast<size_t>(n) * SYNC_SHIFTS, SEED + 3);
+    const JS8DSP::CorrelateFn correlate = JS8DSP::correlate_kernel();
+    std::array<float, SYNC_SHIFTS> magnitudes;
+
+    for (auto _ : state) {
+        float total = 0.0f;
+        for (int t = 0; t < sizes.time_steps; ++t) {
+            for (int a = 0; a < 3; ++a) {
+                for (int s = 0; s < 7; ++s) {
+                    const int start = t * step + (a * 36 + s) * n;
+                    correlate(x_re.data() + start, x_im.data() + start, t_re.data(), t_im.data(), n,
+                              SYNC_SHIFTS, magnitudes.data());
+                    total += magnitudes[0];
+                }
+            }
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetLabel(MODE_NAMES[state.range(0)]);
+}
+BENCHMARK(BM_SyncMap)->Apply(apply_mode_args);
+
+// Symbol powers of one candidate: all 79 symbols at each of the 8 tones
+void BM_SymbolPowers(benchmark::State& state) {
+    const StageSizes sizes(static_cast<int>(state.range(0)));
+    const int n = sizes.symbol_samples;
+    const auto x_re = random_floats(static_cast<size_t>(NN) * n, SEED);
+    const auto x_im = random_floats(static_cast<size_t>(NN) * n, SEED + 1);
+    const auto t_re = random_floats(static_cast<size_t>(8) * n, SEED + 2);
+    const auto t_im = random_floats(static_cast<size_t>(8) * n, SEED + 3);
+    const JS8DSP::CorrelateFn correlate = JS8DSP::correlate_kernel();
+    std::array<std::array<float, NN>, 8> powers;
+
+    for (auto _ : state) {
+        for (int sym = 0; sym < NN; ++sym) {
+            for (int tone = 0; tone < 8; ++tone) {
+                correlate(x_re.data() + sym * n, x_im.data() + sym * n, t_re.data() + tone * n,
+                          t_im.data() + tone * n, n, 1, &powers[tone][sym]);
+            }
+        }
+        benchmark::DoNotOptimize(powers);
+    }
+    state.SetLabel(MODE_NAMES[state.range(0)]);
+}
+BENCHMARK(BM_SymbolPowers)->Apply(apply_mode_args);
+
+// Baseband transform of a whole slot, once per decode pass
+void BM_BasebandFFT(benchmark::State& state) {
+    const StageSizes sizes(static_cast<int>(state.range(0)));
+    const auto& plan = JS8DSP::FFTPlanManager::instance().get(sizes.ndfft1, JS8DSP::FFTKind::REAL,
+                                                                JS8DSP::FFTDirection::FORWARD);
+    const auto input = random_floats(sizes.ndfft1, SEED);
+    std::vector<JS8DSP::Complex> output(sizes.ndfft1 / 2 + 1);
+    std::vector<JS8DSP::Complex> work(plan.workspace_size() + 1);
+
+    for (auto _ : state) {
+        plan.execute(input.data(), output.data(), work.data());
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetLabel(MODE_NAMES[state.range(0)]);
+}
+BENCHMARK(BM_BasebandFFT)->Apply(apply_mode_args);
+
+// Downsampling one candidate: take its band of the baseband spectrum,
+// inverse transform it at the downsampled rate and split into I/Q
+void BM_Downsample(benchmark::State& state) {
+    const StageSizes sizes(static_cast<int>(state.range(0)));
+    const auto& plan = JS8DSP::FFTPlanManager::instance().get(sizes.ndfft2, JS8DSP::FFTKind::COMPLEX,
+                                                                JS8DSP::FFTDirection::BACKWARD);
+    const auto spectrum = random_floats(2 * static_cast<size_t>(sizes.ndfft2), SEED);
+    std::vector<JS8DSP::Complex> cd(sizes.ndfft2);
+    std::vector<JS8DSP::Complex> work(plan.workspace_size() + 1);
+    std::vector<float> re(sizes.ndfft2), im(sizes.ndfft2);
+    const int band = sizes.ndfft2 / 3;
+
+    for (auto _ : state) {
+        std::fill(cd.begin(), cd.end(), JS8DSP::Complex(0.0f, 0.0f));
+        for (int i = 0; i < band; ++i) cd[i] = JS8DSP::Complex(spectrum[2 * i], spectrum[2 * i + 1]);
+        plan.execute(cd.data(), cd.data(), work.data());
+        for (int i = 0; i < sizes.ndfft2; ++i) {
+            re[i] = cd[i].real();
+            im[i] = cd[i].imag();
+        }
+        benchmark::DoNotOptimize(re.data());
+        benchmark::DoNotOptimize(im.data());
+    }
+    state.SetLabel(MODE_NAMES[state.range(0)]);
+}
+BENCHMARK(BM_Downsample)->Apply(apply_mode_args);
+
+// Noise floor fit of a NORMAL mode spectrum; the incremental variant
+// sees the same floor shape every slot, as on a quiet band
+void BM_Baseline(benchmark::State& state) {
+    const bool incremental = state.range(0) != 0;
+    const float resolution = 12000.0f / 3840.0f;
+    std::vector<float> spectrum(1920);
+    for (size_t i = 0; i < spectrum.size(); ++i) {
+        spectrum[i] = 1e-3f * (1.0f + 0.5f * std::sin(0.002f * i)) * (1.0f + 0.3f * ((i * 7919) % 13) / 13.0f);
+    }
+
+    JS8DSP::BaselineComputation baseline;
+    baseline.setIncremental(incremental);
+    std::vector<float> result;
+    baseline.computeBaseline(spectrum, resolution, result);
+
+    for (auto _ : state) {
+        baseline.computeBaseline(spectrum, resolution, result);
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.counters["refits"] = static_cast<double>(baseline.refits());
+    state.SetLabel(incremental ? "incremental" : "full");
+}
+BENCHMARK(BM_Baseline)->Arg(0)->Arg(1)->ArgName("incremental");
+
+// Soft bits of an encoded frame through an AWGN channel at Eb/N0 in
+// tenths of a dB
+std::array<float, BPDSP::N> noisy_codeword(int ebno_tenths, uint32_t seed) {
+    JS8DSP::ToneSequence tones;
+    JS8DSP::encode_tones({0x0123456789abcdefull, 0x5a}, 3, Mode::NORMAL, tones);
+
+    const float ebno = std::pow(10.0f, ebno_tenths / 100.0f);
+    const float sigma = std::sqrt(1.0f / (2.0f * ebno * BPDSP::K / BPDSP::N));
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> noise(0.0f, sigma);
+
+    std::array<float, BPDSP::N> llr;
+    for (int j = 0; j < ND; ++j) {
+        const int tone = tones[j < 29 ? j + 7 : j + 14];
+        for (int b = 0; b < 3; ++b) {
+            const float symbol = ((tone >> (2 - b)) & 1) ? 1.0f : -1.0f;
+            llr[3 * j + b] = 2.0f * (symbol + noise(rng)) / (sigma * sigma);
+        }
+    }
+    return llr;
+}
+
+void BM_BpDecode(benchmark::State& state) {
+    const auto llr = noisy_codeword(static_cast<int>(state.range(0)), SEED);
+    std::array<int8_t, BPDSP::K> decoded;
+    std::array<int8_t, BPDSP::N> codeword;
+    int errors = 0;
+
+    for (auto _ : state) {
+        errors = BPDSP::bpdecode174(llr, decoded, codeword);
+        benchmark::DoNotOptimize(codeword.data());
+    }
+    state.counters["hard_errors"] = errors;
+}
+BENCHMARK(BM_BpDecode)->Arg(30)->Arg(20)->Arg(10)->ArgName("ebno_tenths_db");
+
+void BM_MinSumDecode(benchmark::State& state) {
+    std::array<std::array<float, BPDSP::N>, BPDSP::MS_BATCH> llr;
+    std::array<std::array<int8_t, BPDSP::K>, BPDSP::MS_BATCH> decoded;
+    std::array<std::array<int8_t, BPDSP::N>, BPDSP::MS_BATCH> codeword;
+    const std::array<float, BPDSP::N>* llr_in[BPDSP::MS_BATCH];
+    std::array<int8_t, BPDSP::K>* decoded_out[BPDSP::MS_BATCH];
+    std::array<int8_t, BPDSP::N>* codeword_out[BPDSP::MS_BATCH];
+    int nerr[BPDSP::MS_BATCH];
+    for (int lane = 0; lane < BPDSP::MS_BATCH; ++lane) {
+        llr[lane] = noisy_codeword(static_cast<int>(state.range(0)), SEED + lane);
+        llr_in[lane] = &llr[lane];
+        decoded_out[lane] = &decoded[lane];
+        codeword_out[lane] = &codeword[lane];
+    }
+
+    for (auto _ : state) {
+        BPDSP::minsum_decode174(llr_in, BPDSP::MS_BATCH, decoded_out, codeword_out, nerr);
+        benchmark::DoNotOptimize(nerr);
+    }
+    state.SetItemsProcessed(state.iterations() * BPDSP::MS_BATCH);
+}
+BENCHMARK(BM_MinSumDecode)->Arg(30)->Arg(10)->ArgName("ebno_tenths_db");
+
+void BM_OsdDecode(benchmark::State& state) {
+    const auto llr = noisy_codeword(0, SEED);
+    std::array<int8_t, BPDSP::K> decoded;
+    std::array<int8_t, BPDSP::N> codeword;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(BPDSP::osd174(llr, static_cast<int>(state.range(0)), decoded, codeword));
+    }
+}
+BENCHMARK(BM_OsdDecode)->Arg(1)->Arg(2)->ArgName("order");
+
+const char* const VARICODE_TEXT = "CQ CQ DE KN4CRD EM73 HELLO WORLD 73";
+
+void BM_VaricodeEncode(benchmark::State& state) {
+    varicode_encoder_t* encoder = varicode_encoder_create();
+    char symbols[1024];
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(varicode_encode_message(encoder, VARICODE_TEXT, symbols, sizeof(symbols)));
+    }
+    state.SetBytesProcessed(state.iterations() * strlen(VARICODE_TEXT));
+    varicode_encoder_destroy(encoder);
+}
+BENCHMARK(BM_VaricodeEncode);
+
+void BM_VaricodeDecode(benchmark::State& state) {
+    varicode_encoder_t* encoder = varicode_encoder_create();
+    char symbols[1024];
+    char text[256];
+    varicode_encode_message(encoder, VARICODE_TEXT, symbols, sizeof(symbols));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(varicode_decode_symbols(encoder, symbols, text, sizeof(text)));
+    }
+    state.SetBytesProcessed(state.iterations() * strlen(VARICODE_TEXT));
+    varicode_encoder_destroy(encoder);
+}
+BENCHMARK(BM_VaricodeDecode);
+
+void BM_FramePackUnpack(benchmark::State& state) {
+    char text[128];
+
+    for (auto _ : state) {
+        js8dsp_frame_t frame;
+        js8dsp_frame_pack("J1Y SNR -05", "KN4CRD", &frame, nullptr);
+        benchmark::DoNotOptimize(js8dsp_frame_unpack(&frame, 3, text, sizeof(text), nullptr));
+    }
+}
+BENCHMARK(BM_FramePackUnpack);
+
+// One second of capture rate audio to 12 kHz
+void BM_Resample(benchmark::State& state) {
+    const int rate = static_cast<int>(state.range(0));
+    JS8DSP::Resampler resampler(rate, JS8_RX_SAMPLE_RATE);
+    const auto input = random_floats(rate, SEED);
+    std::vector<float> output(JS8_RX_SAMPLE_RATE + 1);
+
+    for (auto _ : state) {
+        size_t consumed = 0;
+        resampler.reset();
+        benchmark::DoNotOptimize(resampler.process(input.data(), input.size(), output.data(), output.size(),
+                                                   consumed));
+    }
+    state.SetItemsProcessed(state.iterations() * rate);
+    state.SetLabel(JS8DSP::Resampler::kernel_name());
+}
+BENCHMARK(BM_Resample)->Arg(48000)->Arg(44100)->ArgName("rate");
+
+// One transmission rendered into a caller buffer
+void BM_Encode(benchmark::State& state) {
+    const int mode = static_cast<int>(state.range(0));
+    js8dsp_handle_t handle = js8dsp_init(48000, static_cast<js8dsp_mode_t>(mode));
+    std::vector<float> audio(js8dsp_get_encode_buffer_size(handle, "HELLO WORLD"));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(js8dsp_encode_message(handle, "HELLO WORLD", audio.data(), audio.size()));
+    }
+    state.SetLabel(MODE_NAMES[mode]);
+    js8dsp_cleanup(handle);
+}
+BENCHMARK(BM_Encode)->Apply(apply_mode_args)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Synthetic slot: signals transmitted by the library's own encoder from
+ * half a second in, from 500 Hz up with a signal's width left clear
+ * between each, at snr_db in
+ * 2500 Hz over white Gaussian noise of unit power per sample. The same
+ * arguments always give the same samples.
+ */
+std::vector<float> synthetic_slot(int sample_rate, int mode, int signals, int snr_db) {
+    const ModeParams params = getModeParams(static_cast<Mode>(mode));
+    std::vector<float> slot(static_cast<size_t>(sample_rate) * params.ntxdur);
+
+    std::mt19937 rng(SEED + mode * 131 + signals * 17 + snr_db);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    for (auto& sample : slot) sample = noise(rng);
+
+    js8dsp_handle_t tx = js8dsp_init(sample_rate, static_cast<js8dsp_mode_t>(mode));
+    std::vector<float> audio(js8dsp_get_encode_buffer_size(tx, ""));
+    const float amplitude = std::sqrt(2.0f * std::pow(10.0f, snr_db / 10.0f) * 2500.0f / (0.5f * sample_rate));
+    const size_t start = static_cast<size_t>(params.astart * sample_rate);
+    const float spacing = 16.0f * JS8_RX_SAMPLE_RATE / params.nsps;
+
+    for (int i = 0; i < signals; ++i) {
+        char text[24];
+        snprintf(text, sizeof(text), "TEST %02d DE", i);
+        js8dsp_set_tx_frequency(tx, 500.0f + spacing * i);
+        int rendered = js8dsp_encode_message(tx, text, audio.data(), audio.size());
+        for (int k = 0; k < rendered && start + k < slot.size(); ++k) slot[start + k] += amplitude * audio[k];
+    }
+
+    js8dsp_cleanup(tx);
+    return slot;
+}
+
+// Distinct messages decoded; a signal may be reported by more than one
+// candidate
+int count_decodes(const js8dsp_decoded_message_t* messages, int count) {
+    int decoded = 0;
+    for (int i = 0; i < count; ++i) {
+        bool repeated = false;
+        for (int j = 0; j < i && !repeated; ++j) repeated = strcmp(messages[i].message, messages[j].message) == 0;
+        decoded += !repeated;
+    }
+    return decoded;
+}
+
+// Whole-slot decode; the counters report signals found alongside time
+// per slot
+void BM_DecodeSlot(benchmark::State& state) {
+    const int mode = static_cast<int>(state.range(0));
+    const int signals = static_cast<int>(state.range(1));
+    const int snr_db = static_cast<int>(state.range(2));
+    const int sample_rate = static_cast<int>(state.range(3));
+
+    const auto slot = synthetic_slot(sample_rate, mode, signals, snr_db);
+    js8dsp_handle_t handle = js8dsp_init(sample_rate, static_cast<js8dsp_mode_t>(mode));
+    std::vector<js8dsp_decoded_message_t> messages(MAX_RESULTS);
+    int count = js8dsp_decode_buffer(handle, slot.data(), slot.size(), messages.data(),
+                                     static_cast<int>(messages.size()));
+
+    for (auto _ : state) {
+        count = js8dsp_decode_buffer(handle, slot.data(), slot.size(), messages.data(),
+                                     static_cast<int>(messages.size()));
+    }
+
+    state.counters["signals"] = signals;
+    state.counters["decoded"] = count_decodes(messages.data(), std::max(count, 0));
+    state.counters["results"] = std::max(count, 0);
+    state.SetLabel(MODE_NAMES[mode]);
+    js8dsp_cleanup(handle);
+}
+
+void apply_slot_args(benchmark::internal::Benchmark* b) {
+    for (int mode = JS8DSP_MODE_NORMAL; mode <= JS8DSP_MODE_ULTRA; ++mode) {
+        b->Args({mode, 0, 0, 12000});
+        b->Args({mode, 5, -10, 12000});
+        b->Args({mode, 5, -18, 12000});
+    }
+    b->Args({JS8DSP_MODE_NORMAL, 10, -10, 12000});
+    b->Args({JS8DSP_MODE_NORMAL, 5, -10, 48000});
+    b->ArgNames({"mode", "signals", "snr_db", "rate"});
+}
+BENCHMARK(BM_DecodeSlot)->Apply(apply_slot_args)->Unit(benchmark::kMillisecond)->MeasureProcessCPUTime()->UseRealTime();
+
+// Whole-slot decode of ten signals in up to the given number of rounds;
+// what subtraction and revisiting cost when every signal decodes first time
+void BM_DecodeRounds(benchmark::State& state) {
+    const int rounds = static_cast<int>(state.range(0));
+
+    const auto slot = synthetic_slot(12000, JS8DSP_MODE_NORMAL, 10, -10);
+    js8dsp_handle_t handle = js8dsp_init(12000, JS8DSP_MODE_NORMAL);
+    js8dsp_set_decode_rounds(handle, rounds);
+    std::vector<js8dsp_decoded_message_t> messages(MAX_RESULTS);
+    int count = js8dsp_decode_buffer(handle, slot.data(), slot.size(), messages.data(),
+                                     static_cast<int>(messages.size()));
+
+    for (auto _ : state) {
+        count = js8dsp_decode_buffer(handle, slot.data(), slot.size(), messages.data(),
+                                     static_cast<int>(messages.size()));
+    }
+
+    js8dsp_metrics_t metrics;
+    js8dsp_get_metrics(handle, &metrics, sizeof(metrics));
+    state.counters["decoded"] = count_decodes(messages.data(), std::max(count, 0));
+    state.counters["subtracted"] = metrics.last_signals_subtracted;
+    js8dsp_cleanup(handle);
+}
+BENCHMARK(BM_DecodeRounds)->Arg(1)->Arg(3)->ArgName("rounds")->Unit(benchmark::kMillisecond)
+    ->MeasureProcessCPUTime()->UseRealTime();
+
+} // namespace
+
+int main(int argc, char** argv) {
+    // JSON unless asked otherwise, for tracking runs across machines
+    std::vector<char*> args(argv, argv + argc);
+    bool has_format = false;
+    for (int i = 1; i < argc; ++i) has_format = has_format || strncmp(argv[i], "--benchmark_format", 18) == 0;
+    static char json_format[] = "--benchmark_format=json";
+    if (!has_format) args.push_back(json_format);
+    int count = static_cast<int>(args.size());
+
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) return 1;
+
+    benchmark::AddCustomContext("js8dsp_version", js8dsp_get_version());
+    benchmark::AddCustomContext("correlate_kernel", JS8DSP::correlate_kernel_name());
+    benchmark::AddCustomContext("resample_kernel", JS8DSP::Resampler::kernel_name());
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
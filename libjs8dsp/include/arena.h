@@ -0,0 +1,117 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include "thread_policy.h"
+
+namespace JS8DSP {
+
+/**
+ * Bump allocator for the transient data of a decode pass.
+ *
+ * Allocation moves a pointer through a block reserved up front; nothing
+ * is freed individually. A Scope gives back everything allocated while
+ * it was open, and reset() empties the arena at the start of each pass.
+ * Should a pass need more than the block holds, further blocks are
+ * chained on; the next reset() replaces them by a single block of their
+ * combined size, so a steady decode cycle allocates nothing.
+ *
+ * Only trivially destructible types may be allocated, since nothing is
+ * ever destroyed. An arena is used by one thread at a time.
+ */
+class Arena {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+    static constexpr size_t ALIGNMENT = 64;    // Of every block, and the most any type may ask for
+
+    /**
+     * @param capacity Bytes of the initial block
+     */
+    explicit Arena(size_t capacity = DEFAULT_CAPACITY);
+
+    Arena(Arena&&) noexcept = default;
+    Arena& operator=(Arena&&) noexcept = default;
+
+    /**
+     * Room for count objects of type T, default initialised: trivial types
+     * are left uninitialised. Valid until the enclosing Scope closes or the
+     * arena is reset.
+     */
+    template <typename T>
+    T* allocate(size_t count = 1) {
+        static_assert(std::is_trivially_destructible_v<T>, "arena objects are never destroyed");
+        static_assert(alignof(T) <= ALIGNMENT, "arena blocks are not aligned for this type");
+
+        T* objects = static_cast<T*>(allocate_bytes(sizeof(T) * count, alignof(T)));
+        std::uninitialized_default_construct_n(objects, count);
+        return objects;
+    }
+
+    /**
+     * Give back everything allocated since the last reset. Returns whether
+     * the arena had to be consolidated into a new, larger block.
+     */
+    bool reset();
+
+    // Bytes in use now, the most in use since the last reset, and reserved
+    size_t used() const { return used_; }
+    size_t peak() const { return peak_; }
+    size_t capacity() const { return capacity_; }
+
+    // Lock, or unlock, the blocks in RAM
+    void lock_memory(MemoryLock& lock) const {
+        for (const Block& block : blocks_) lock.add(block.data.get(), block.size);
+    }
+
+    /**
+     * Releases, when it goes out of scope, everything allocated from the
+     * arena while it was open. Scopes nest.
+     */
+    class Scope {
+    public:
+        explicit Scope(Arena& arena)
+            : arena_(arena), block_(arena.block_), offset_(arena.offset_), used_(arena.used_) {}
+        ~Scope() {
+            arena_.block_ = block_;
+            arena_.offset_ = offset_;
+            arena_.used_ = used_;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Arena& arena_;
+        size_t block_;
+        size_t offset_;
+        size_t used_;
+    };
+
+private:
+    struct BlockDeleter {
+        void operator()(std::byte* data) const { ::operator delete[](data, std::align_val_t{ALIGNMENT}); }
+    };
+
+    struct Block {
+        std::unique_ptr<std::byte[], BlockDeleter> data;
+        size_t size;
+    };
+
+    void* allocate_bytes(size_t bytes, size_t alignment);
+    void add_block(size_t size);
+
+    std::vector<Block> blocks_;
+    size_t block_ = 0;       // Block allocations are taken from
+    size_t offset_ = 0;      // Within it
+    size_t used_ = 0;
+    size_t peak_ = 0;
+    size_t capacity_ = 0;
+};
+
+} // namespace JS8DSP
+
+#endif // ARENA_H
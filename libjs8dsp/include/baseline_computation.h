@@ -8,6 +8,7 @@
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include "thread_policy.h"
 
 namespace JS8DSP {
 
@@ -16,6 +17,7 @@ constexpr int BASELINE_DEGREE = 5;
 constexpr int BASELINE_SAMPLE = 10;  // Percentile for sampling
 constexpr float BASELINE_MIN = 500.0f;   // Hz
 constexpr float BASELINE_MAX = 2500.0f;  // Hz
+constexpr double BASELINE_REFIT_TOLERANCE = 0.25;  // dB of noise floor shape change
 
 // Constexpr cos function for Chebyshev nodes (from JS8Call)
 constexpr auto cos_approx = [](double const x) {
@@ -114,7 +116,82 @@ private:
     }
 #endif
 
+    // Scratch buffers reused across calls so that steady-state baseline
+    // computation does not allocate
+    std::vector<float> log_spectrum_;
+    std::vector<float> window_values_;
+
+    // Incremental mode: the noise floor samples and constant term of the
+    // last full fit, against which later samples are compared
+    bool incremental_ = false;
+    bool have_fit_ = false;
+    size_t fit_size_ = 0;
+    std::array<double, BASELINE_DEGREE + 1> fit_y_{};
+    double fit_c0_ = 0.0;
+    size_t refits_ = 0;
+    size_t updates_ = 0;
+
+    // Fit to the sampled noise floor, or in incremental mode shift the last
+    // fit if the floor has only moved up or down
+    void fit(const std::array<double, BASELINE_DEGREE + 1>& x,
+             const std::array<double, BASELINE_DEGREE + 1>& y,
+             size_t size);
+
 public:
+    /**
+     * Preallocate scratch space for spectra of up to the given size
+     * @param bins Number of spectrum bins
+     */
+    void reserve(size_t bins);
+
+    /**
+     * Lock, or unlock, the scratch space in RAM
+     */
+    void lock_memory(MemoryLock& lock) const {
+        lock.add(log_spectrum_);
+        lock.add(window_values_);
+    }
+
+    /**
+     * Reuse the previous fit while the noise floor keeps its shape. The
+     * polynomial is refitted only once some sampled point has moved more
+     * than BASELINE_REFIT_TOLERANCE from the others since the last fit;
+     * otherwise the fit is shifted by the mean change.
+     * @param incremental True to enable, false to refit on every call
+     */
+    void setIncremental(bool incremental);
+
+    /**
+     * A full fit and the noise floor it was made to, as kept between calls
+     * in incremental mode
+     */
+    struct Fit {
+        size_t size;                                    // Bins fitted over
+        std::array<double, BASELINE_DEGREE + 1> y;      // Noise floor at the nodes
+        double c0;                                      // Before any shift
+        std::array<double, BASELINE_DEGREE + 1> c;      // Coefficients
+    };
+
+    /**
+     * Take the current fit, to carry over to another instance such as a
+     * later process's, which then need not refit
+     * @param fit Fit (output)
+     * @return False if there is no fit yet
+     */
+    bool saveFit(Fit& fit) const;
+
+    /**
+     * Continue from a fit taken with saveFit
+     * @param fit Fit to continue from
+     */
+    void restoreFit(const Fit& fit);
+
+    /**
+     * Number of full fits and of incremental updates made so far
+     */
+    size_t refits() const { return refits_; }
+    size_t updates() const { return updates_; }
+
     /**
      * Compute baseline using polynomial fitting to power spectrum
      * @param spectrum Power spectrum data
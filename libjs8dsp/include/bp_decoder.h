@@ -28,10 +28,66 @@ namespace BPDSP {
     // The Mn array: which variable nodes connect to each check node
     extern const std::array<CheckNode, M> Nm;
 
-    // BP Decoder function
+    // Message arrays of bpdecode174. A workspace need not be initialised
+    // and may be reused for any number of calls, one at a time.
+    struct BPWorkspace {
+        std::array<std::array<float, BP_MAX_CHECKS>, N> tov;     // Messages to variable nodes
+        std::array<std::array<float, BP_MAX_ROWS>, M> toc;       // Messages to check nodes
+        std::array<std::array<float, BP_MAX_ROWS>, M> tanhtoc;   // Tanh of messages
+        std::array<float, N> zn;                                 // Bit log likelihood ratios
+        std::array<int, M> synd;                                 // Syndrome for checks
+    };
+
+    // BP Decoder function; iterations, if given, receives the message
+    // passing iterations run. Without a workspace, one is kept on the stack.
+    int bpdecode174(const std::array<float, N>& llr,
+                   std::array<int8_t, K>& decoded,
+                   std::array<int8_t, N>& cw,
+                   int* iterations = nullptr);
     int bpdecode174(const std::array<float, N>& llr,
                    std::array<int8_t, K>& decoded,
-                   std::array<int8_t, N>& cw);
+                   std::array<int8_t, N>& cw,
+                   BPWorkspace& work,
+                   int* iterations = nullptr);
+
+    // Layered min-sum decoder; codewords decoded together, one per lane
+    constexpr int MS_BATCH = 8;
+    constexpr int MS_MAX_ITERATIONS = 25;
+
+    // Posteriors and check messages of minsum_decode174, one lane per
+    // codeword; as BPWorkspace, need not be initialised
+    struct MinSumWorkspace {
+        alignas(32) int16_t post[N][MS_BATCH];
+        alignas(32) int8_t msg[M * BP_MAX_ROWS][MS_BATCH];
+    };
+
+    /**
+     * Normalised min-sum decoding with a layered schedule, for up to
+     * MS_BATCH codewords at once. Messages are fixed point: posteriors in
+     * int16 and check messages in int8, laid out with the codewords as
+     * the innermost dimension so each update vectorises across them.
+     * Faster than bpdecode174 and slightly less sensitive.
+     * @param llr Channel LLRs of each codeword (positive = bit 1)
+     * @param count Number of codewords, 1 to MS_BATCH
+     * @param decoded Message bits of each codeword
+     * @param cw Hard decisions of each codeword
+     * @param nerr Hard error count of each codeword, or -1 if it did not
+     *             converge, as returned by bpdecode174
+     * @param iterations Layered iterations each codeword took, if given
+     */
+    void minsum_decode174(const std::array<float, N>* const llr[],
+                          int count,
+                          std::array<int8_t, K>* const decoded[],
+                          std::array<int8_t, N>* const cw[],
+                          int nerr[],
+                          int iterations[] = nullptr);
+    void minsum_decode174(const std::array<float, N>* const llr[],
+                          int count,
+                          std::array<int8_t, K>* const decoded[],
+                          std::array<int8_t, N>* const cw[],
+                          int nerr[],
+                          MinSumWorkspace& work,
+                          int iterations[] = nullptr);
 }
 
 #endif // BP_DECODER_H
\ No newline at end of file
@@ -0,0 +1,115 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include <complex>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace JS8DSP {
+
+using Complex = std::complex<float>;
+
+// Transform input type; real transforms take n real samples and produce
+// the n / 2 + 1 non-redundant complex bins
+enum class FFTKind {
+    COMPLEX = 0,
+    REAL = 1
+};
+
+enum class FFTDirection {
+    FORWARD = 0,
+    BACKWARD = 1
+};
+
+/**
+ * Single-precision FFT plan, created once and executed many times.
+ * Transforms are unnormalized, matching FFTW conventions. Execution is
+ * const and reentrant; callers supply their own scratch space so that
+ * one plan can be shared by any number of threads.
+ *
+ * The backend is chosen at build time: FFTW when available, otherwise
+ * a built-in mixed-radix Stockham kernel.
+ */
+class FFTPlan {
+public:
+    FFTPlan(size_t size, FFTKind kind, FFTDirection direction);
+    ~FFTPlan();
+
+    FFTPlan(const FFTPlan&) = delete;
+    FFTPlan& operator=(const FFTPlan&) = delete;
+
+    size_t size() const { return size_; }
+    FFTKind kind() const { return kind_; }
+    FFTDirection direction() const { return direction_; }
+
+    /**
+     * Number of complex scratch elements execute() needs
+     */
+    size_t workspace_size() const;
+
+    /**
+     * Complex transform; in and out may be the same buffer
+     * @param in Input, size() elements
+     * @param out Output, size() elements
+     * @param work Scratch, workspace_size() elements
+     */
+    void execute(const Complex* in, Complex* out, Complex* work) const;
+
+    /**
+     * Real forward transform; in and out must not overlap
+     * @param in Input, size() real samples
+     * @param out Output, size() / 2 + 1 elements
+     * @param work Scratch, workspace_size() elements
+     */
+    void execute(const float* in, Complex* out, Complex* work) const;
+
+private:
+    struct Impl;
+
+    size_t size_;
+    FFTKind kind_;
+    FFTDirection direction_;
+    std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * Process-wide plan cache keyed by (size, kind, direction). Plans are
+ * created on first request and live for the life of the process, so
+ * every decoder of the same mode shares the same plans.
+ */
+class FFTPlanManager {
+public:
+    static FFTPlanManager& instance();
+
+    const FFTPlan& get(size_t size, FFTKind kind, FFTDirection direction);
+
+    /**
+     * Smallest size >= n with no prime factor greater than 5
+     */
+    static size_t good_size(size_t n);
+
+private:
+    FFTPlanManager() = default;
+
+    using Key = std::tuple<size_t, FFTKind, FFTDirection>;
+
+    std::mutex mutex_;
+    std::map<Key, std::unique_ptr<FFTPlan>> plans_;
+};
+
+/**
+ * Planner wisdom of the FFT backend, for a later process to plan with;
+ * empty for the built-in kernel, which has no planner. Imported wisdom
+ * is used by plans created afterwards.
+ * @return False if the backend cannot use the wisdom
+ */
+std::string export_fft_wisdom();
+bool import_fft_wisdom(const std::string& wisdom);
+
+} // namespace JS8DSP
+
+#endif // FFT_H
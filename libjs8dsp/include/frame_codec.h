@@ -0,0 +1,139 @@
+#ifndef FRAME_CODEC_H
+#define FRAME_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace JS8DSP {
+
+/**
+ * The 72-bit JS8 frame carried by each transmission, as packed by
+ * JS8Call's Varicode::pack72bits: 64 bits, most significant first, then
+ * the last 8. The three transmission type bits sent after the frame are
+ * kept separately.
+ */
+struct Frame72 {
+    uint64_t value;
+    uint8_t rem;
+};
+
+// Frame types, the first three bits of a frame
+enum FrameType : uint8_t {
+    FRAME_HEARTBEAT = 0,            // [000]
+    FRAME_COMPOUND = 1,             // [001]
+    FRAME_COMPOUND_DIRECTED = 2,    // [010]
+    FRAME_DIRECTED = 3,             // [011]
+    FRAME_DATA = 4,                 // [10X], data starts at the third bit
+    FRAME_DATA_COMPRESSED = 6,      // [11X], dense coded data
+    FRAME_UNKNOWN = 255
+};
+
+// Transmission type bits sent after the frame
+constexpr int TRANSMISSION_FIRST = 1;   // First frame of a message
+constexpr int TRANSMISSION_LAST = 2;    // Last frame of a message
+constexpr int TRANSMISSION_DATA = 4;    // Dense coded data, no frame type
+
+constexpr size_t FRAME_TEXT_LENGTH = 12;   // Six bits per character
+
+// Callsigns above the 28-bit range of packable base calls; groups and
+// the placeholder for a compound callsign sent in a separate frame
+constexpr uint32_t NBASECALL = 37u * 36 * 10 * 27 * 27 * 27;
+constexpr uint16_t NBASEGRID = 180 * 180;
+constexpr uint16_t NUSERGRID = NBASEGRID + 10;
+constexpr uint16_t NMAXGRID = (1 << 15) - 1;
+
+/**
+ * Frame as the 12-character text JS8Call passes between its encoder and
+ * decoder (alphabet72, six bits per character)
+ * @param text Receives FRAME_TEXT_LENGTH characters, not terminated
+ */
+void pack72(Frame72 frame, char* text);
+
+/**
+ * Frame from its 12-character text
+ * @return false if text is too short or has characters outside alphabet72
+ */
+bool unpack72(std::string_view text, Frame72& frame);
+
+// Frame type of an unflagged frame; data frames report FRAME_DATA or
+// FRAME_DATA_COMPRESSED
+FrameType frame_type(Frame72 frame);
+
+/**
+ * Pack up to 11 characters of [A-Z0-9 /@] into 50 bits, as compound
+ * callsigns are sent; other characters are dropped
+ */
+uint64_t pack_alphanumeric50(std::string_view value);
+int unpack_alphanumeric50(uint64_t packed, char* out, size_t size);
+
+/**
+ * Pack a base callsign (or a group from the built-in table) into 28 bits
+ * @param portable Set if the callsign ended in /P, which is not packed
+ * @return Packed callsign, or 0 if it cannot be packed
+ */
+uint32_t pack_callsign(std::string_view callsign, bool& portable);
+
+/**
+ * Unpack a packed callsign into out, NUL terminated
+ * @return Length written, or -1 if packed is invalid or out is too small
+ */
+int unpack_callsign(uint32_t packed, bool portable, char* out, size_t size);
+
+// Pack a 4-character Maidenhead locator into 15 bits; NMAXGRID if it is
+// too short
+uint16_t pack_grid(std::string_view grid);
+
+// Unpack a packed locator; an empty string above NBASEGRID
+int unpack_grid(uint16_t packed, char* out, size_t size);
+
+/**
+ * Whether callsign is a base callsign, group or compound callsign JS8Call
+ * would accept
+ * @param compound Set if it needs a compound frame to be sent
+ */
+bool is_valid_callsign(std::string_view callsign, bool* compound);
+bool is_compound_callsign(std::string_view callsign);
+
+/**
+ * Text packers, each matching the start of text as JS8Call's parsing
+ * patterns do (with hand-written scanners rather than regexes). They
+ * return the number of characters of text the frame carries, 0 if text
+ * does not start with that kind of message.
+ */
+
+// "CQ CQ EM73", "HB EM73" and the like, sent from callsign
+int pack_heartbeat(std::string_view text, std::string_view callsign, Frame72& frame);
+
+// "`CALLSIGN/P EM73" or "`CALLSIGN/P SNR -05"; the leading backquote
+// marks the compound callsign frame
+int pack_compound(std::string_view text, Frame72& frame);
+
+// "TOCALL CMD [NUM]" sent from mycall, e.g. "KN4CRD SNR? " or
+// "KN4CRD SNR -05"
+int pack_directed(std::string_view text, std::string_view mycall, Frame72& frame);
+
+// Huffman coded free text, as many characters as fit
+int pack_data(std::string_view text, Frame72& frame);
+
+/**
+ * Pack the start of text into one frame, trying a heartbeat, compound
+ * and directed message in turn before falling back to free text
+ * @param type Frame type packed
+ * @return Characters of text packed, 0 if none could be
+ */
+int pack_message(std::string_view text, std::string_view mycall, Frame72& frame, FrameType& type);
+
+/**
+ * Unpack a frame into display text, formatted as JS8Call shows it
+ * ("KN4CRD: @HB HEARTBEAT EM73", "KN4CRD: J1Y SNR -05", ...)
+ * @param transmission Transmission type bits sent with the frame
+ * @param type Frame type unpacked
+ * @return Length written (NUL terminated), or -1 if the frame cannot be
+ *         unpacked (dense coded data) or out is too small
+ */
+int unpack_message(Frame72 frame, int transmission, char* out, size_t size, FrameType& type);
+
+} // namespace JS8DSP
+
+#endif // FRAME_CODEC_H
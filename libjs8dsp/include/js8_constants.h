@@ -82,7 +82,7 @@ namespace JS8Constants {
             case Mode::FAST:
                 return {JS8B_SYMBOL_SAMPLES, JS8B_TX_SECONDS, 20, 100, 62, 0.5f, 40.0f, CostasType::MODIFIED};
             case Mode::SLOW:
-                return {JS8C_SYMBOL_SAMPLES, JS8C_TX_SECONDS, 50, 100, 62, 0.5f, 40.0f, CostasType::MODIFIED};
+                return {JS8C_SYMBOL_SAMPLES, JS8C_TX_SECONDS, 32, 100, 62, 0.5f, 40.0f, CostasType::MODIFIED};
             case Mode::TURBO:
                 return {480, 4, 16, 100, 62, 0.5f, 40.0f, CostasType::MODIFIED};
             case Mode::ULTRA:
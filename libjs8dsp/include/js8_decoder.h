@@ -39,8 +39,256 @@ int js8_decoder_decode(js8_decoder_t* decoder,
                       js8dsp_decoded_message_t* messages,
                       int max_messages);
 
+/**
+ * Decode audio buffer in several submodes at once
+ * @param decoder Decoder handle
+ * @param audio_buffer Input audio samples
+ * @param buffer_size Number of samples
+ * @param submodes Bitmask of (1 << mode) for each submode to decode
+ * @param messages Output messages array
+ * @param max_messages Maximum messages to decode
+ * @return Number of messages decoded, or negative error code
+ */
+int js8_decoder_decode_multi(js8_decoder_t* decoder,
+                             const float* audio_buffer,
+                             size_t buffer_size,
+                             int submodes,
+                             js8dsp_decoded_message_t* messages,
+                             int max_messages);
+
+/**
+ * Decode signed 16-bit PCM, as js8_decoder_decode
+ */
+int js8_decoder_decode_s16(js8_decoder_t* decoder,
+                           const int16_t* audio_buffer,
+                           size_t buffer_size,
+                           js8dsp_decoded_message_t* messages,
+                           int max_messages);
+
+/**
+ * Decode signed 16-bit PCM in several submodes, as js8_decoder_decode_multi
+ */
+int js8_decoder_decode_multi_s16(js8_decoder_t* decoder,
+                                 const int16_t* audio_buffer,
+                                 size_t buffer_size,
+                                 int submodes,
+                                 js8dsp_decoded_message_t* messages,
+                                 int max_messages);
+
+/**
+ * Decode one slot of several channels as one batch
+ * @param decoder Decoder handle
+ * @param audio_buffer Input audio samples, channels * frames of them
+ * @param frames Number of samples in each channel
+ * @param channels Number of channels, 1 to JS8DSP_MAX_CHANNELS
+ * @param layout Interleaved or planar samples
+ * @param submodes Bitmask of (1 << mode) for each submode to decode
+ * @param messages Output messages array
+ * @param max_messages Maximum messages to decode
+ * @return Number of messages decoded, or negative error code
+ */
+int js8_decoder_decode_channels(js8_decoder_t* decoder,
+                                const float* audio_buffer,
+                                size_t frames,
+                                int channels,
+                                js8dsp_layout_t layout,
+                                int submodes,
+                                js8dsp_decoded_message_t* messages,
+                                int max_messages);
+
+/**
+ * Decode signed 16-bit PCM of several channels, as js8_decoder_decode_channels
+ */
+int js8_decoder_decode_channels_s16(js8_decoder_t* decoder,
+                                    const int16_t* audio_buffer,
+                                    size_t frames,
+                                    int channels,
+                                    js8dsp_layout_t layout,
+                                    int submodes,
+                                    js8dsp_decoded_message_t* messages,
+                                    int max_messages);
+
+/**
+ * Start, or restart, a stream; slots begin at the next sample pushed
+ * @param decoder Decoder handle
+ * @param submodes Bitmask of (1 << mode) for each submode to decode
+ * @return 0 on success, or negative error code
+ */
+int js8_decoder_stream_start(js8_decoder_t* decoder, int submodes);
+
+/**
+ * Feed audio into the stream, decoding every slot that completes
+ * @param decoder Decoder handle
+ * @param samples Input audio samples
+ * @param sample_count Number of samples
+ * @return Number of decodes waiting to be polled, or negative error code
+ */
+int js8_decoder_stream_push(js8_decoder_t* decoder,
+                            const float* samples,
+                            size_t sample_count);
+
+/**
+ * Feed signed 16-bit PCM into the stream, as js8_decoder_stream_push
+ */
+int js8_decoder_stream_push_s16(js8_decoder_t* decoder,
+                                const int16_t* samples,
+                                size_t sample_count);
+
+/**
+ * Take decodes produced by the stream, oldest first
+ * @param decoder Decoder handle
+ * @param messages Output messages array
+ * @param max_messages Maximum messages to return
+ * @return Number of messages returned, or negative error code
+ */
+int js8_decoder_stream_poll(js8_decoder_t* decoder,
+                            js8dsp_decoded_message_t* messages,
+                            int max_messages);
+
+/**
+ * Count the decodes stream passes have made since the last call, whether
+ * they were queued to be polled or reported as events
+ * @param decoder Decoder handle
+ * @return Number of decodes
+ */
+uint32_t js8_decoder_stream_take_decoded(js8_decoder_t* decoder);
+
+/**
+ * Set decoder sensitivity threshold; decodes with a lower SNR are not
+ * reported
+ * @param decoder Decoder handle
+ * @param threshold SNR threshold in dB
+ */
+void js8_decoder_set_threshold(js8_decoder_t* decoder, float threshold);
+
+/**
+ * Report decode progress through a callback
+ * @param decoder Decoder handle
+ * @param callback Event callback, or NULL to stop reporting events
+ * @param user_data Passed to every callback
+ * @param sync_stats Nonzero to also emit sync events
+ */
+void js8_decoder_set_event_callback(js8_decoder_t* decoder,
+                                    js8dsp_event_callback_t callback,
+                                    void* user_data,
+                                    int sync_stats);
+
+/**
+ * Select the LDPC decoder used for candidates
+ * @param decoder Decoder handle
+ * @param ldpc Decoder algorithm
+ */
+void js8_decoder_set_ldpc_decoder(js8_decoder_t* decoder, js8dsp_ldpc_t ldpc);
+
+/**
+ * Enable or disable the decode cache
+ * @param decoder Decoder handle
+ * @param enabled Nonzero to enable
+ */
+void js8_decoder_set_decode_cache(js8_decoder_t* decoder, int enabled);
+
+/**
+ * Set the time ordered statistics decoding may take per decode pass
+ * @param decoder Decoder handle
+ * @param budget_ms Budget in milliseconds, 0 to disable OSD
+ */
+void js8_decoder_set_osd_budget(js8_decoder_t* decoder, float budget_ms);
+
+/**
+ * Set the time a decode pass may take; candidates not started by then
+ * are skipped
+ * @param decoder Decoder handle
+ * @param budget_ms Budget in milliseconds, 0 for no limit
+ */
+void js8_decoder_set_time_budget(js8_decoder_t* decoder, float budget_ms);
+
+/**
+ * Set the most decode rounds a pass may take; each round after the first
+ * subtracts the signals the one before decoded and revisits the
+ * candidates they overlapped
+ * @param decoder Decoder handle
+ * @param rounds 1 to JS8DSP_MAX_DECODE_ROUNDS
+ */
+void js8_decoder_set_decode_rounds(js8_decoder_t* decoder, int rounds);
+
+/**
+ * Get the OSD budget and counts of OSD work since the decoder was created
+ * @param decoder Decoder handle
+ * @param budget_ms Budget per decode pass (output)
+ * @param attempts Candidates OSD was run on (output)
+ * @param decoded Candidates OSD decoded (output)
+ * @param skipped Candidates that qualified once the budget was spent (output)
+ */
+void js8_decoder_get_osd_stats(js8_decoder_t* decoder, float* budget_ms,
+                               uint32_t* attempts, uint32_t* decoded, uint32_t* skipped);
+
+/**
+ * Get stage timings and counts of decode work since the decoder was
+ * created; the fields js8dsp_get_metrics fills from the context itself
+ * are left alone
+ * @param decoder Decoder handle
+ * @param metrics Metrics (output)
+ */
+void js8_decoder_get_metrics(js8_decoder_t* decoder, js8dsp_metrics_t* metrics);
+
+/**
+ * Get the latest symbol frame spectrum and baseline of a submode's
+ * decoder, decimated to a layout; may be called from any thread
+ * @param decoder Decoder handle
+ * @param mode Submode of the decoder
+ * @param channel Receiver channel of the decoder
+ * @param layout Checked bins and format to write
+ * @param power Spectrum of the latest frame (output)
+ * @param baseline Baseline of the latest slot (output, optional)
+ * @return Frames the decoder has computed, 0 if none or no such decoder
+ */
+uint64_t js8_decoder_get_spectrum(js8_decoder_t* decoder, int mode, int channel,
+                                  const js8dsp_spectrum_layout_t* layout,
+                                  void* power, void* baseline);
+
+/**
+ * Save the decoder's tuning, the noise floor fit, seeds and decode cache
+ * of each of its submodes and channels, and the FFT wisdom
+ * @param decoder Decoder handle
+ * @param buffer Buffer to write the state into, or NULL
+ * @param size Size of buffer in bytes
+ * @return Size of the state in bytes; written only if it fits
+ */
+size_t js8_decoder_save_state(js8_decoder_t* decoder, void* buffer, size_t size);
+
+/**
+ * Continue from a state saved with js8_decoder_save_state
+ * @param decoder Decoder handle
+ * @param buffer State
+ * @param size Size of the state in bytes
+ * @return 0 on success, -1 if the state is damaged, of another version or
+ *         its decoders could not all be created; the tuning and caches are
+ *         then unchanged, though decoders created before the failure stay
+ */
+int js8_decoder_load_state(js8_decoder_t* decoder, const void* buffer, size_t size);
+
 #ifdef __cplusplus
 }
+
+namespace JS8DSP { class ThreadPool; struct ThreadPolicy; }
+
+/**
+ * Attach a worker pool used to decode candidates in parallel
+ * @param decoder Decoder handle
+ * @param pool Pool owned by the caller, or NULL to decode serially
+ */
+void js8_decoder_set_thread_pool(js8_decoder_t* decoder, JS8DSP::ThreadPool* pool);
+
+/**
+ * Set the threading policy decode passes take on the calling thread, and
+ * lock or unlock decoder memory as it asks. The pool's workers are the
+ * caller's to start under the policy.
+ * @param decoder Decoder handle
+ * @param policy Policy to take
+ * @return 0, or the errno value the policy was refused with, in which
+ *         case the default policy is in effect
+ */
+int js8_decoder_set_thread_policy(js8_decoder_t* decoder, const JS8DSP::ThreadPolicy& policy);
 #endif
 
 #endif // JS8_DECODER_H
\ No newline at end of file
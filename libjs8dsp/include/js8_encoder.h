@@ -0,0 +1,91 @@
+#ifndef JS8_ENCODER_H
+#define JS8_ENCODER_H
+
+#include "frame_codec.h"
+#include "js8_constants.h"
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace JS8DSP {
+
+// Tones of one transmission: Costas arrays at 0, 36 and 72, parity
+// symbols at 7..35 and message symbols at 43..71
+using ToneSequence = std::array<uint8_t, JS8Constants::NN>;
+
+// Bandwidth-time product of the Gaussian frequency pulse, as FT8 uses
+constexpr float GFSK_BT = 2.0f;
+
+/**
+ * Augmented CRC-12 (polynomial 0xc06, XOR 42) of the 11-byte message
+ * with its checksum bits still clear, as JS8Call computes it
+ */
+uint16_t crc12(const std::array<uint8_t, 11>& bytes);
+
+/**
+ * Encode a frame into tones, as JS8Call's genjs8: the 72 frame bits, the
+ * three transmission type bits and the CRC-12 make the 87 message bits,
+ * which are protected by the (174,87) LDPC code
+ * @param transmission Transmission type bits sent with the frame
+ * @param mode Selects the Costas arrays
+ */
+void encode_tones(Frame72 frame, int transmission, JS8Constants::Mode mode, ToneSequence& tones);
+
+/**
+ * Phase-continuous GFSK synthesis of a tone sequence at an output sample
+ * rate. The frequency pulse, the ramps at either end and the sine table
+ * are computed once, here, so render() only reads tables and writes the
+ * caller's buffer.
+ */
+class GfskModulator {
+public:
+    GfskModulator(int sample_rate, JS8Constants::Mode mode);
+
+    int sample_rate() const { return sample_rate_; }
+    int samples_per_symbol() const { return samples_per_symbol_; }
+
+    // Tone spacing, and with it the symbol rate, in Hz
+    float tone_spacing() const { return tone_spacing_; }
+
+    // Samples in one transmission of NN symbols
+    size_t samples() const { return static_cast<size_t>(JS8Constants::NN) * samples_per_symbol_; }
+
+    /**
+     * Render tones with tone 0 at frequency, at unit amplitude
+     * @param out Receives samples(); size must be at least that
+     * @return Samples written, 0 if size is too small
+     */
+    size_t render(const ToneSequence& tones, float frequency, float* out, size_t size) const;
+
+    /**
+     * Render tones as complex baseband with tone 0 at DC, at unit
+     * amplitude; the decoder's reference for a transmission it has decoded
+     * @param out Receives samples(); size must be at least that
+     * @return Samples written, 0 if size is too small
+     */
+    size_t render_baseband(const ToneSequence& tones, std::complex<float>* out, size_t size) const;
+
+private:
+    // Run the phase accumulator over the tones, passing write() the phase
+    // of every sample in turn
+    template <typename Write>
+    void modulate(const ToneSequence& tones, uint32_t carrier, Write&& write) const;
+
+    float sine(uint32_t phase) const;
+
+    int sample_rate_;
+    int samples_per_symbol_;
+    float tone_spacing_;
+
+    // Frequency deviation over the three symbols a pulse spans, in phase
+    // accumulator steps per sample for one tone of shift
+    std::vector<float> pulse_;
+    std::vector<float> ramp_;       // Raised cosine envelope, rising
+    std::vector<float> sine_;       // One cycle plus a guard entry
+};
+
+} // namespace JS8DSP
+
+#endif // JS8_ENCODER_H
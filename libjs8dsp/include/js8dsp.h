@@ -10,9 +10,12 @@ extern "C" {
 
 // JS8DSP API Version
 #define JS8DSP_VERSION_MAJOR 1
-#define JS8DSP_VERSION_MINOR 0
+#define JS8DSP_VERSION_MINOR 18
 #define JS8DSP_VERSION_PATCH 0
 
+// Audio frequency of the lowest tone transmitted, until set
+#define JS8DSP_DEFAULT_TX_FREQUENCY 1500.0f
+
 // Return codes
 typedef enum {
     JS8DSP_OK = 0,
@@ -31,6 +34,88 @@ typedef enum {
     JS8DSP_MODE_ULTRA = 4
 } js8dsp_mode_t;
 
+// Submode bitmask for multi-mode decoding; one bit per js8dsp_mode_t
+#define JS8DSP_SUBMODE_NORMAL (1 << JS8DSP_MODE_NORMAL)
+#define JS8DSP_SUBMODE_FAST   (1 << JS8DSP_MODE_FAST)
+#define JS8DSP_SUBMODE_TURBO  (1 << JS8DSP_MODE_TURBO)
+#define JS8DSP_SUBMODE_SLOW   (1 << JS8DSP_MODE_SLOW)
+#define JS8DSP_SUBMODE_ULTRA  (1 << JS8DSP_MODE_ULTRA)
+#define JS8DSP_SUBMODE_ALL    0x1f
+
+// Most receiver channels js8dsp_decode_channels takes at once
+#define JS8DSP_MAX_CHANNELS 16
+
+// Most decode rounds js8dsp_set_decode_rounds allows per pass
+#define JS8DSP_MAX_DECODE_ROUNDS 3
+
+// Most CPUs a thread policy pins decode workers to
+#define JS8DSP_MAX_PINNED_CPUS 64
+
+// Recent passes js8dsp_metrics_t ranks decode latency over
+#define JS8DSP_LATENCY_WINDOW 64
+
+// Sample order of multi-channel audio
+typedef enum {
+    JS8DSP_LAYOUT_INTERLEAVED = 0,  // Frame by frame, one sample of each channel
+    JS8DSP_LAYOUT_PLANAR = 1        // Channel by channel, every frame of each
+} js8dsp_layout_t;
+
+// Value formats of js8dsp_get_spectrum
+typedef enum {
+    JS8DSP_SPECTRUM_F16 = 0,        // dB as IEEE 754 half precision floats
+    JS8DSP_SPECTRUM_U8 = 1          // dB scaled from [db_min, db_max] to 0 to 255, clamped
+} js8dsp_spectrum_format_t;
+
+// Bins js8dsp_get_spectrum writes: [low_hz, high_hz) split evenly into
+// bins, each holding the strongest of the decoder's own bins within it
+typedef struct {
+    float low_hz;
+    float high_hz;                  // At most half the 12 kHz decode rate
+    uint32_t bins;
+    js8dsp_spectrum_format_t format;
+    float db_min;                   // JS8DSP_SPECTRUM_U8: dB written as 0
+    float db_max;                   // and as 255
+} js8dsp_spectrum_layout_t;
+
+// LDPC decoder algorithms
+typedef enum {
+    JS8DSP_LDPC_BP_FLOODING = 0,    // Floating point belief propagation, as JS8Call
+    JS8DSP_LDPC_MIN_SUM_LAYERED = 1 // Fixed point layered min-sum, several candidates at once
+} js8dsp_ldpc_t;
+
+// Scheduling classes of decode threads
+typedef enum {
+    JS8DSP_SCHED_OTHER = 0,         // Time sharing, as the threads were started
+    JS8DSP_SCHED_FIFO = 1,          // Real-time, first in first out
+    JS8DSP_SCHED_RR = 2             // Real-time, round robin
+} js8dsp_sched_t;
+
+// Where and how decode passes run; see js8dsp_set_thread_policy
+typedef struct {
+    int cpu_count;                  // CPUs in cpus, 0 not to pin
+    int cpus[JS8DSP_MAX_PINNED_CPUS];   // Worker i runs on cpus[i % cpu_count]
+    js8dsp_sched_t sched;
+    int priority;                   // Of SCHED_FIFO and SCHED_RR, from 1; 0 otherwise
+    int lock_memory;                // Nonzero to fault in and lock decode memory in RAM
+} js8dsp_thread_policy_t;
+
+// JS8 frame types, the first three bits of a frame
+typedef enum {
+    JS8DSP_FRAME_HEARTBEAT = 0,         // Heartbeat or CQ
+    JS8DSP_FRAME_COMPOUND = 1,          // Compound callsign, with a grid
+    JS8DSP_FRAME_COMPOUND_DIRECTED = 2, // Compound callsign, with a command
+    JS8DSP_FRAME_DIRECTED = 3,          // Command from one callsign to another
+    JS8DSP_FRAME_DATA = 4,              // Huffman coded free text
+    JS8DSP_FRAME_DATA_COMPRESSED = 6,   // Dense coded free text
+    JS8DSP_FRAME_UNKNOWN = 255
+} js8dsp_frame_type_t;
+
+// 72-bit JS8 frame, the payload of one transmission
+typedef struct {
+    uint64_t bits;              // First 64 bits, first bit most significant
+    uint8_t rem;                // Last 8 bits
+} js8dsp_frame_t;
+
 // Decoded message structure
 typedef struct {
     char message[128];          // Decoded message text
@@ -38,8 +123,139 @@ typedef struct {
     float freq_offset;          // Frequency offset in Hz
     uint32_t timestamp;         // Time offset in samples
     int confidence;             // Decoder confidence (0-100)
+    int mode;                   // js8dsp_mode_t the message was decoded in
+    int channel;                // Receiver channel; 0 unless multi-channel
 } js8dsp_decoded_message_t;
 
+// Decode event types, reported to a js8dsp_event_callback_t as decoding
+// progresses
+typedef enum {
+    JS8DSP_EVENT_DECODE_STARTED = 0,    // A decode pass began
+    JS8DSP_EVENT_SYNC_START = 1,        // A submode's slot is being searched
+    JS8DSP_EVENT_SYNC_STATE = 2,        // A candidate synced or decoded
+    JS8DSP_EVENT_DECODED = 3,           // A message was decoded
+    JS8DSP_EVENT_DECODE_FINISHED = 4    // A decode pass finished
+} js8dsp_event_type_t;
+
+typedef enum {
+    JS8DSP_SYNC_CANDIDATE = 0,  // Candidate passed the sync threshold
+    JS8DSP_SYNC_DECODED = 1     // Candidate produced a decode
+} js8dsp_sync_type_t;
+
+typedef struct {
+    uint32_t submodes;          // JS8DSP_SUBMODE_* bits being decoded
+} js8dsp_decode_started_t;
+
+typedef struct {
+    int mode;                   // js8dsp_mode_t of the slot
+    uint64_t position;          // First 12 kHz sample of the slot
+    uint32_t size;              // Slot length in 12 kHz samples
+    int channel;                // Receiver channel of the slot
+} js8dsp_sync_start_t;
+
+typedef struct {
+    js8dsp_sync_type_t type;
+    int mode;                   // js8dsp_mode_t of the candidate
+    float frequency;            // Candidate frequency in Hz
+    float dt;                   // Time offset from nominal start in seconds
+    float sync;                 // Costas sync strength
+    int channel;                // Receiver channel of the candidate
+} js8dsp_sync_state_t;
+
+typedef struct {
+    uint32_t decoded;           // Messages decoded during the pass
+    uint64_t elapsed_ns;        // Wall clock time of the pass, as last_pass_ns
+} js8dsp_decode_finished_t;
+
+typedef struct {
+    js8dsp_event_type_t type;
+    union {
+        js8dsp_decode_started_t decode_started;
+        js8dsp_sync_start_t sync_start;
+        js8dsp_sync_state_t sync_state;
+        js8dsp_decoded_message_t decoded;
+        js8dsp_decode_finished_t decode_finished;
+    } data;                     // Member selected by type
+} js8dsp_event_t;
+
+// Decoder stages timed by js8dsp_get_metrics
+typedef enum {
+    JS8DSP_STAGE_INGEST = 0,        // Sample conversion and resampling to 12 kHz
+    JS8DSP_STAGE_FFT = 1,           // Symbol spectra, the baseband transform and subtraction from it
+    JS8DSP_STAGE_BASELINE = 2,      // Noise floor fit
+    JS8DSP_STAGE_CANDIDATES = 3,    // Candidate selection against the noise floor
+    JS8DSP_STAGE_SYNC = 4,          // Downsampling and Costas sync search
+    JS8DSP_STAGE_LLR = 5,           // Symbol powers and bit metrics
+    JS8DSP_STAGE_LDPC = 6,          // LDPC decoding and the OSD fallback
+    JS8DSP_STAGE_UNPACK = 7,        // Message unpacking
+    JS8DSP_STAGE_COUNT = 8
+} js8dsp_stage_t;
+
+// Layout of js8dsp_metrics_t; fields are only ever added at the end
+#define JS8DSP_METRICS_VERSION 5
+
+// LDPC runs that converged, by iterations taken: 0 to 25
+#define JS8DSP_LDPC_ITERATION_BINS 26
+
+/**
+ * Decoder metrics since the context was created. A pass is one decode
+ * of a slot: a js8dsp_decode_buffer call, or a streamed slot ending.
+ * Stage times are in nanoseconds of steady clock time, summed over
+ * decode threads; the last pass includes the streaming ingest and
+ * symbol spectra computed while its slot was arriving.
+ */
+typedef struct {
+    uint32_t version;                       // JS8DSP_METRICS_VERSION filled in
+    uint32_t size;                          // Bytes filled in
+    uint64_t passes;                        // Decode passes finished
+    uint64_t stage_total_ns[JS8DSP_STAGE_COUNT];
+    uint64_t stage_last_ns[JS8DSP_STAGE_COUNT];     // Of the last pass
+    uint64_t candidates_found;              // Frequencies searched for sync
+    uint64_t candidates_attempted;          // Synced candidates LDPC decoded
+    uint64_t candidates_decoded;            // Candidates giving a codeword
+    uint32_t last_candidates_found;         // The same, for the last pass
+    uint32_t last_candidates_attempted;
+    uint32_t last_candidates_decoded;
+    uint32_t reserved;
+    uint64_t ldpc_iterations[JS8DSP_LDPC_ITERATION_BINS];
+    uint64_t ldpc_failures;                 // LDPC runs that did not converge
+    uint64_t allocations;                   // Decoder buffers allocated or grown
+    uint32_t total_decoded;                 // As js8dsp_get_stats
+    uint32_t total_errors;
+
+    // Version 2
+    uint64_t candidates_suppressed;         // Inside the tones of an already decoded signal
+    uint64_t candidates_skipped;            // Not decoded once the time budget ran out
+    uint32_t last_candidates_suppressed;    // The same, for the last pass
+    uint32_t last_candidates_skipped;
+
+    // Version 3
+    uint64_t arena_bytes;                   // Reserved by the per-thread decode arenas
+    uint64_t arena_peak_bytes;              // Most one arena has held in a pass
+    uint64_t last_arena_peak_bytes;         // The same, for the last pass
+
+    // Version 4
+    uint64_t decode_rounds;                 // Rounds run after the first of a pass
+    uint64_t signals_subtracted;            // Decodes subtracted for a further round
+    uint32_t last_decode_rounds;            // The same, for the last pass
+    uint32_t last_signals_subtracted;
+
+    // Version 5
+    uint64_t last_pass_ns;                  // Wall clock time of the last pass, from the call or
+                                            // the slot's last sample until its results are ready
+    uint64_t median_pass_ns;                // Of the last JS8DSP_LATENCY_WINDOW passes
+    uint64_t worst_pass_ns;                 // The same
+    uint64_t max_pass_ns;                   // Of any pass
+    uint64_t locked_bytes;                  // Memory locked by the thread policy
+} js8dsp_metrics_t;
+
+/**
+ * Decode event callback. The event is only valid for the duration of the
+ * call. While candidates are decoded on several threads the callback runs
+ * on whichever thread produced the event, but never concurrently.
+ */
+typedef void (*js8dsp_event_callback_t)(const js8dsp_event_t* event, void* user_data);
+
 // Opaque handle for DSP context
 typedef struct js8dsp_context* js8dsp_handle_t;
 
@@ -64,9 +280,11 @@ void js8dsp_cleanup(js8dsp_handle_t handle);
  * @param handle DSP context handle
  * @param audio_buffer Input audio samples (float32, mono)
  * @param buffer_size Number of samples in buffer
- * @param messages Output array for decoded messages
+ * @param messages Output array for decoded messages; may be NULL with
+ *                 max_messages 0 when decodes are taken from events
  * @param max_messages Maximum number of messages to decode
- * @return Number of messages decoded, or negative error code
+ * @return Number of messages decoded, or negative error code. With no
+ *         messages array this is the total number of decodes.
  */
 int js8dsp_decode_buffer(js8dsp_handle_t handle,
                         const float* audio_buffer,
@@ -75,11 +293,157 @@ int js8dsp_decode_buffer(js8dsp_handle_t handle,
                         int max_messages);
 
 /**
- * Encode message to audio samples
+ * Decode signed 16-bit PCM for JS8 messages. Samples are converted as
+ * they are read into the handle's own buffers, so the caller needs no
+ * float copy of the audio; the buffer is only read during the call.
+ * Arguments and result are as for js8dsp_decode_buffer.
+ */
+int js8dsp_decode_buffer_s16(js8dsp_handle_t handle,
+                            const int16_t* audio_buffer,
+                            size_t buffer_size,
+                            js8dsp_decoded_message_t* messages,
+                            int max_messages);
+
+/**
+ * Decode audio buffer in several submodes at once. The buffer is
+ * converted to 12 kHz once and shared by all requested submodes, and
+ * their candidates are decoded together; each submode considers the
+ * first transmission period of its own length.
+ * @param handle DSP context handle
+ * @param audio_buffer Input audio samples (float32, mono)
+ * @param buffer_size Number of samples in buffer
+ * @param submodes Bitmask of JS8DSP_SUBMODE_* values
+ * @param messages Output array for decoded messages; may be NULL with
+ *                 max_messages 0 when decodes are taken from events
+ * @param max_messages Maximum number of messages to decode
+ * @return Number of messages decoded, or negative error code. With no
+ *         messages array this is the total number of decodes.
+ */
+int js8dsp_decode_buffer_multi(js8dsp_handle_t handle,
+                              const float* audio_buffer,
+                              size_t buffer_size,
+                              uint32_t submodes,
+                              js8dsp_decoded_message_t* messages,
+                              int max_messages);
+
+/**
+ * Decode one slot of several receiver channels, such as the slices of a
+ * wideband SDR, in one call. All channels share the context's sample
+ * rate, mode tables, FFT plans and worker threads, and the candidates of
+ * every channel and submode are decoded together as one batch. Results
+ * are ordered by channel and tagged with it. Decoder buffers for a
+ * channel are allocated the first time it is used.
+ * @param handle DSP context handle
+ * @param audio_buffer Input audio samples (float32), channels * frames
+ *                     of them in the given layout
+ * @param frames Number of samples in each channel
+ * @param channels Number of channels, 1 to JS8DSP_MAX_CHANNELS
+ * @param layout Interleaved or planar samples
+ * @param submodes Bitmask of JS8DSP_SUBMODE_* values
+ * @param messages Output array for decoded messages; may be NULL with
+ *                 max_messages 0 when decodes are taken from events
+ * @param max_messages Maximum number of messages to decode
+ * @return Number of messages decoded, or negative error code. With no
+ *         messages array this is the total number of decodes.
+ */
+int js8dsp_decode_channels(js8dsp_handle_t handle,
+                          const float* audio_buffer,
+                          size_t frames,
+                          int channels,
+                          js8dsp_layout_t layout,
+                          uint32_t submodes,
+                          js8dsp_decoded_message_t* messages,
+                          int max_messages);
+
+/**
+ * Decode signed 16-bit PCM of several channels, converting it as
+ * js8dsp_decode_buffer_s16 does. Arguments and result are as for
+ * js8dsp_decode_channels.
+ */
+int js8dsp_decode_channels_s16(js8dsp_handle_t handle,
+                              const int16_t* audio_buffer,
+                              size_t frames,
+                              int channels,
+                              js8dsp_layout_t layout,
+                              uint32_t submodes,
+                              js8dsp_decoded_message_t* messages,
+                              int max_messages);
+
+/**
+ * Start, or restart, streaming decode in the given submodes. Every
+ * submode's first slot begins with the next sample pushed, so call this
+ * on a transmission period boundary; later slots follow back to back.
+ * Pending decodes that have not been polled are discarded.
+ * @param handle DSP context handle
+ * @param submodes Bitmask of JS8DSP_SUBMODE_* values
+ * @return JS8DSP_OK on success, error code on failure
+ */
+js8dsp_result_t js8dsp_stream_start(js8dsp_handle_t handle, uint32_t submodes);
+
+/**
+ * Push audio into the stream. Chunks may be any size; spectra are
+ * computed as audio arrives and each slot is decoded as soon as its
+ * last sample is pushed. Starts a stream in the handle's mode if none
+ * is running; a js8dsp_decode_buffer call stops the running stream and
+ * the next push restarts it. Decodes count towards js8dsp_get_stats as
+ * their slot is decoded, and are queued for js8dsp_stream_poll unless an
+ * event callback reports them.
+ * @param handle DSP context handle
+ * @param samples Input audio samples (float32, mono)
+ * @param sample_count Number of samples
+ * @return Number of decodes waiting to be polled, or negative error code
+ */
+int js8dsp_stream_push(js8dsp_handle_t handle,
+                      const float* samples,
+                      size_t sample_count);
+
+/**
+ * Push signed 16-bit PCM into the stream, as js8dsp_stream_push. Samples
+ * are converted straight into the stream's ring buffer.
+ * @param handle DSP context handle
+ * @param samples Input audio samples (int16, mono)
+ * @param sample_count Number of samples
+ * @return Number of decodes waiting to be polled, or negative error code
+ */
+int js8dsp_stream_push_s16(js8dsp_handle_t handle,
+                          const int16_t* samples,
+                          size_t sample_count);
+
+/**
+ * Take decodes produced by the stream, oldest slot first
+ * @param handle DSP context handle
+ * @param messages Output array for decoded messages
+ * @param max_messages Maximum number of messages to return
+ * @return Number of messages returned, or negative error code
+ */
+int js8dsp_stream_poll(js8dsp_handle_t handle,
+                      js8dsp_decoded_message_t* messages,
+                      int max_messages);
+
+/**
+ * Decode signed 16-bit PCM in several submodes at once, converting it as
+ * js8dsp_decode_buffer_s16 does. Arguments and result are as for
+ * js8dsp_decode_buffer_multi.
+ */
+int js8dsp_decode_buffer_multi_s16(js8dsp_handle_t handle,
+                                  const int16_t* audio_buffer,
+                                  size_t buffer_size,
+                                  uint32_t submodes,
+                                  js8dsp_decoded_message_t* messages,
+                                  int max_messages);
+
+/**
+ * Encode the start of a message into one transmission of audio at the
+ * context's sample rate and mode: the message is packed as
+ * js8dsp_frame_pack would with no sending callsign, encoded into 79
+ * tones and rendered as phase-continuous GFSK at the transmit frequency,
+ * with unit peak amplitude. Writes straight into audio_buffer and does
+ * not allocate.
  * @param handle DSP context handle
  * @param message Text message to encode (null-terminated)
  * @param audio_buffer Output buffer for audio samples
- * @param buffer_size Size of output buffer
+ * @param buffer_size Size of output buffer, at least
+ *                    js8dsp_get_encode_buffer_size()
  * @return Number of samples generated, or negative error code
  */
 int js8dsp_encode_message(js8dsp_handle_t handle,
@@ -88,13 +452,42 @@ int js8dsp_encode_message(js8dsp_handle_t handle,
                          size_t buffer_size);
 
 /**
- * Get required buffer size for encoding a message
+ * Encode a frame packed with js8dsp_frame_pack into one transmission of
+ * audio, as js8dsp_encode_message. Does not allocate.
+ * @param handle DSP context handle
+ * @param frame Frame to send
+ * @param transmission_type Transmission type bits sent after the frame:
+ *                          1 for the first frame of a message, 2 for the
+ *                          last, 3 for both
+ * @param audio_buffer Output buffer for audio samples
+ * @param buffer_size Size of output buffer
+ * @return Number of samples generated, or negative error code
+ */
+int js8dsp_encode_frame(js8dsp_handle_t handle,
+                       const js8dsp_frame_t* frame,
+                       int transmission_type,
+                       float* audio_buffer,
+                       size_t buffer_size);
+
+/**
+ * Get required buffer size for encoding a message: one transmission,
+ * 79 symbols of the context's mode at its sample rate
  * @param handle DSP context handle
  * @param message Message to encode
  * @return Required buffer size in samples, or negative error code
  */
 int js8dsp_get_encode_buffer_size(js8dsp_handle_t handle, const char* message);
 
+/**
+ * Set the audio frequency of the lowest tone transmitted
+ * (JS8DSP_DEFAULT_TX_FREQUENCY until set); all eight tones must lie
+ * below half the sample rate
+ * @param handle DSP context handle
+ * @param frequency Frequency in Hz
+ * @return JS8DSP_OK on success, error code on failure
+ */
+js8dsp_result_t js8dsp_set_tx_frequency(js8dsp_handle_t handle, float frequency);
+
 /**
  * Get library version string
  * @return Version string (e.g., "1.0.0")
@@ -109,7 +502,9 @@ const char* js8dsp_get_version(void);
 const char* js8dsp_get_error(js8dsp_handle_t handle);
 
 /**
- * Set decoder sensitivity threshold
+ * Set decoder sensitivity threshold. Decodes whose SNR, in dB over the
+ * noise baseline, is below it are not reported; -20 by default, which
+ * reports every decode.
  * @param handle DSP context handle
  * @param threshold SNR threshold in dB (lower = more sensitive)
  * @return JS8DSP_OK on success, error code on failure
@@ -127,6 +522,268 @@ js8dsp_result_t js8dsp_get_stats(js8dsp_handle_t handle,
                                 uint32_t* total_decoded,
                                 uint32_t* total_errors);
 
+/**
+ * Get decoder metrics: stage timings, candidate counts, LDPC iterations
+ * and buffer allocations. Counters are read without locking, so this may
+ * be called from any thread while decoding runs; each value is then
+ * consistent on its own, if not with the others. Does not allocate.
+ * @param handle DSP context handle
+ * @param metrics Metrics (output)
+ * @param size sizeof(js8dsp_metrics_t) as the caller was built with; an
+ *             older, smaller layout is filled up to its size
+ * @return JS8DSP_OK on success, error code on failure
+ */
+js8dsp_result_t js8dsp_get_metrics(js8dsp_handle_t handle, js8dsp_metrics_t* metrics, size_t size);
+
+/**
+ * Get the power spectrum of the latest symbol frame a submode's decoder
+ * computed, and the noise baseline of the latest slot it searched, for
+ * a waterfall display. These are the decoder's own symbol spectra, made
+ * as audio is decoded or streamed, so reading them costs no transform.
+ * A new frame is computed every quarter symbol. Spectra are published
+ * under a lock held only to copy them, so this may be called from any
+ * thread while decoding runs. Does not allocate.
+ * @param handle DSP context handle
+ * @param mode js8dsp_mode_t of the decoder
+ * @param channel Receiver channel of the decoder; 0 for single channel
+ *                and streamed audio
+ * @param layout Bins and format to write
+ * @param power layout->bins values of the latest frame (output)
+ * @param baseline layout->bins values of the baseline (output, optional)
+ * @param frame Frames the decoder has computed, including this one;
+ *              unchanged between calls means no new frame (output, optional)
+ * @return JS8DSP_OK on success, JS8DSP_ERROR if the decoder has not
+ *         computed a frame yet, error code on failure
+ */
+js8dsp_result_t js8dsp_get_spectrum(js8dsp_handle_t handle,
+                                   int mode,
+                                   int channel,
+                                   const js8dsp_spectrum_layout_t* layout,
+                                   void* power,
+                                   void* baseline,
+                                   uint64_t* frame);
+
+/**
+ * Set the number of threads used to decode candidates
+ * @param handle DSP context handle
+ * @param threads Worker threads including the caller; 1 decodes serially,
+ *                0 uses one per available CPU
+ * @return JS8DSP_OK on success, error code on failure
+ */
+js8dsp_result_t js8dsp_set_threads(js8dsp_handle_t handle, int threads);
+
+/**
+ * Control where and how decode passes run, for decode latency that holds
+ * up beside other work on the machine. Worker i is pinned to
+ * cpus[i % cpu_count] and scheduled in the given class; the pool's
+ * threads are restarted to take the policy, as are those of later
+ * js8dsp_set_threads calls, and the thread calling a decode function
+ * takes it as worker 0 for the length of each pass, getting its own
+ * affinity and scheduling back afterwards. With memory locked, the
+ * decoders' buffers, mode tables, per-worker arenas and some stack of
+ * each decode thread are faulted in and locked in RAM, so that a pass
+ * never waits on a page fault; buffers a pass or setting allocates are
+ * locked after it. Linux only. The real-time classes and locking memory
+ * need privilege, such as CAP_SYS_NICE and CAP_IPC_LOCK or matching
+ * RLIMIT_RTPRIO and RLIMIT_MEMLOCK limits; js8dsp_metrics_t reports the
+ * median and worst latency of recent passes.
+ * @param handle DSP context handle
+ * @param policy Policy to take, or NULL for the default, which leaves
+ *               threads as started and memory unlocked
+ * @return JS8DSP_OK on success, JS8DSP_ERROR if the system refused the
+ *         policy, in which case the default is in effect and
+ *         js8dsp_get_error says why, error code on failure
+ */
+js8dsp_result_t js8dsp_set_thread_policy(js8dsp_handle_t handle, const js8dsp_thread_policy_t* policy);
+
+/**
+ * Report decode progress through a callback. Every decode pass, whether
+ * from js8dsp_decode_buffer, js8dsp_decode_buffer_multi or a slot ending
+ * during js8dsp_stream_push, emits DECODE_STARTED, then a DECODED event
+ * for each message as soon as its candidate is decoded, then
+ * DECODE_FINISHED. Events are delivered before the call that caused them
+ * returns. Streamed decodes reported this way are not also queued for
+ * js8dsp_stream_poll.
+ * @param handle DSP context handle
+ * @param callback Event callback, or NULL to stop reporting events
+ * @param user_data Passed to every callback
+ * @param sync_stats Nonzero to also emit SYNC_START and SYNC_STATE events
+ * @return JS8DSP_OK on success, error code on failure
+ */
+js8dsp_result_t js8dsp_set_event_callback(js8dsp_handle_t handle,
+                                         js8dsp_event_callback_t callback,
+                                         void* user_data,
+                                         int sync_stats);
+
+/**
+ * Select the LDPC decoder. Layered min-sum decodes several candidates
+ * per call in fixed point and is considerably faster, at a small cost
+ * in sensitivity; flooding belief propagation is the default.
+ * @param handle DSP context handle
+ * @param ldpc LDPC decoder algorithm
+ * @return JS8DSP_OK on success, error code on failure
+ */
+js8dsp_result_t js8dsp_set_ldpc_decoder(js8dsp_handle_t handle, js8dsp_ldpc_t ldpc);
+
+/**
+ * Enable the decode cache. Each submode then remembers the messages it
+ * reported over about the last period, by frequency, start time and
+ * message bits. Another pass over the same slot, such as decoding a
+ * growing buffer again, skips LDPC for candidates whose bit metrics
+ * already match a remembered message and does not report it again, nor
+ * is a message reported twice by one pass. Strong signals are also
+ * searched for at their frequencies in the next pass. Decodes made with
+ * js8dsp_decode_buffer are placed in time by when the call is made, the
+ * buffer taken to end then; streamed slots by stream position.
+ * @param handle DSP context handle
+ * @param enabled Nonzero to enable, 0 (the default) to disable and clear
+ * @return JS8DSP_OK on success, error code on failure
+ */
+js8dsp_result_t js8dsp_set_decode_cache(js8dsp_handle_t handle, int enabled);
+
+/**
+ * Allow ordered statistics decoding (OSD, order 2) of candidates that
+ * belief propagation fails on, if their sync and bit metrics are strong.
+ * OSD stops for the rest of a decode pass once it has used the budget,
+ * counted as CPU time summed over decode threads, so the extra
+ * sensitivity never holds up the next slot.
+ * @param handle DSP context handle
+ * @param budget_ms Time allowed per decode pass in milliseconds; 0, the
+ *                  default, disables OSD
+ * @return JS8DSP_OK on success, error code on failure
+ */
+js8dsp_result_t js8dsp_set_osd_budget(js8dsp_handle_t handle, float budget_ms);
+
+/**
+ * Limit how long a decode pass may take. Candidates are ranked by SNR,
+ * across submodes and channels, and decoded strongest first; once the
+ * budget has passed, counted in wall clock time from the start of the
+ * pass, those not yet started are skipped and counted in
+ * js8dsp_metrics_t. A busy band then loses its weakest candidates rather
+ * than delaying the next slot.
+ * @param handle DSP context handle
+ * @param budget_ms Time allowed per decode pass in milliseconds; 0, the
+ *                  default, for no limit
+ * @return JS8DSP_OK on success, error code on failure
+ */
+js8dsp_result_t js8dsp_set_time_budget(js8dsp_handle_t handle, float budget_ms);
+
+/**
+ * Decode each pass in up to the given number of rounds. The first decodes
+ * the candidates as usual, strongest first; each later round subtracts
+ * the signals the one before decoded from the slot's spectrum and
+ * revisits only the candidates whose bands they overlapped, so that a
+ * weak signal under or beside a strong one can decode. The rounds stop
+ * as soon as one decodes nothing new, and count against the time budget.
+ * @param handle DSP context handle
+ * @param rounds 1, the default, for a single round without subtraction,
+ *               up to JS8DSP_MAX_DECODE_ROUNDS
+ * @return JS8DSP_OK on success, error code on failure
+ */
+js8dsp_result_t js8dsp_set_decode_rounds(js8dsp_handle_t handle, int rounds);
+
+/**
+ * Save what the decoder has learned, so that a restarted process decodes
+ * its first slot as it would in steady state: the decode threshold, LDPC
+ * decoder, decode cache, OSD and time budgets and decode rounds; the
+ * noise floor fit, seed frequencies and cached decodes of every submode
+ * and channel; and the FFT planner's wisdom. The state is a versioned
+ * binary blob in host byte order, a few kilobytes per decoder, for this
+ * library on the same machine. Threads and thread policy are left to the
+ * caller. Not to be called while decoding.
+ * @param handle DSP context handle
+ * @param buffer Buffer to write the state into, or NULL to size it
+ * @param size Size of buffer in bytes
+ * @param state_size Size of the state in bytes (output)
+ * @return JS8DSP_OK on success, JS8DSP_ERROR if the buffer is too small,
+ *         error code on failure
+ */
+js8dsp_result_t js8dsp_save_state(js8dsp_handle_t handle, void* buffer, size_t size, size_t* state_size);
+
+/**
+ * Continue from a state saved with js8dsp_save_state, in place of this
+ * handle's tuning, creating the decoders it has state for. Cached decodes
+ * are aged by the time since the state was saved, and seeds carry over
+ * into a stream started afterwards. Not to be called while decoding.
+ * @param handle DSP context handle
+ * @param buffer State
+ * @param size Size of the state in bytes
+ * @return JS8DSP_OK on success, JS8DSP_ERROR if the state is damaged, of
+ *         another version or its decoders could not all be created, in
+ *         which case the tuning and caches are unchanged, though decoders
+ *         created before the failure stay, and js8dsp_get_error says why,
+ *         error code on failure
+ */
+js8dsp_result_t js8dsp_load_state(js8dsp_handle_t handle, const void* buffer, size_t size);
+
+/**
+ * Get OSD statistics, alongside js8dsp_get_stats
+ * @param handle DSP context handle
+ * @param budget_ms OSD budget per decode pass (output)
+ * @param attempts Candidates OSD was run on (output)
+ * @param decoded Candidates OSD decoded (output)
+ * @param skipped Candidates that qualified for OSD after the budget was
+ *                spent (output)
+ * @return JS8DSP_OK on success, error code on failure
+ */
+js8dsp_result_t js8dsp_get_osd_stats(js8dsp_handle_t handle,
+                                    float* budget_ms,
+                                    uint32_t* attempts,
+                                    uint32_t* decoded,
+                                    uint32_t* skipped);
+
+/**
+ * Pack the start of a message into one frame, as JS8Call would: a
+ * heartbeat or CQ ("CQ CQ EM73"), a compound callsign ("`KN4CRD/P EM73"),
+ * a directed command ("J1Y SNR? ") or else as much free text as fits.
+ * Does not allocate.
+ * @param text Message text (null-terminated)
+ * @param mycall Sending callsign
+ * @param frame Packed frame (output)
+ * @param frame_type Type of frame packed (output, optional)
+ * @return Characters of text packed, 0 if it cannot be packed, or
+ *         negative error code
+ */
+int js8dsp_frame_pack(const char* text,
+                      const char* mycall,
+                      js8dsp_frame_t* frame,
+                      js8dsp_frame_type_t* frame_type);
+
+/**
+ * Unpack a frame into message text as js8dsp_decode_buffer reports it,
+ * e.g. "KN4CRD: @HB HEARTBEAT EM73" or "KN4CRD: J1Y SNR -05". Dense coded
+ * data frames are not supported. Does not allocate.
+ * @param frame Frame to unpack
+ * @param transmission_type The three transmission type bits sent after
+ *                          the frame
+ * @param text Output buffer for the message (null-terminated)
+ * @param text_size Size of output buffer
+ * @param frame_type Type of frame unpacked (output, optional)
+ * @return Length of message, or negative error code
+ */
+int js8dsp_frame_unpack(const js8dsp_frame_t* frame,
+                        int transmission_type,
+                        char* text,
+                        size_t text_size,
+                        js8dsp_frame_type_t* frame_type);
+
+/**
+ * Convert a frame to the 12-character text JS8Call uses for frames
+ * @param frame Frame to convert
+ * @param text Output buffer, at least 13 bytes (null-terminated)
+ * @param text_size Size of output buffer
+ * @return 12, or negative error code
+ */
+int js8dsp_frame_to_text(const js8dsp_frame_t* frame, char* text, size_t text_size);
+
+/**
+ * Convert 12-character frame text back to a frame
+ * @param text Frame text
+ * @param frame Frame (output)
+ * @return JS8DSP_OK on success, error code on failure
+ */
+js8dsp_result_t js8dsp_frame_from_text(const char* text, js8dsp_frame_t* frame);
+
 #ifdef __cplusplus
 }
 #endif
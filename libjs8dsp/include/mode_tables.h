@@ -0,0 +1,51 @@
+#ifndef MODE_TABLES_H
+#define MODE_TABLES_H
+
+#include "js8_constants.h"
+#include <span>
+
+namespace JS8DSP {
+
+// Fine frequency shifts of the tone templates, SYNC_SHIFT_STEP baud apart
+// and centred on each tone, so the sync search can refine frequency as
+// well as time
+constexpr int SYNC_SHIFTS = 5;
+constexpr float SYNC_SHIFT_STEP = 0.1f;
+
+/**
+ * Tables that depend only on the mode: the tone templates for sync and
+ * demodulation, the Costas arrays, the symbol spectrum window and the
+ * tapers applied when downsampling a candidate. They are computed at
+ * compile time, one set per submode, and shared by every decoder in the
+ * process.
+ */
+struct ModeTables {
+    // Tones are one baud apart, i.e. one cycle per symbol at the
+    // downsampled rate; each of the 8 tones is tabulated at every sync
+    // shift. Layout is [tone][shift][sample], real and imaginary parts in
+    // separate arrays.
+    std::span<const float> tone_re;
+    std::span<const float> tone_im;
+
+    // The tone of each sync symbol
+    const int (*costas)[7];
+
+    // Nuttall window used for symbol spectra, normalized as in JS8Call so
+    // spectrum levels match the reference decoder
+    std::span<const float> nuttal;
+
+    // Fore and aft tapers applied to the edges of each candidate's
+    // frequency slice to reduce leakage in the inverse FFT
+    std::span<const float> taper_head;
+    std::span<const float> taper_tail;
+};
+
+/**
+ * Tables for a submode; the reference is valid for the life of the
+ * process
+ */
+const ModeTables& mode_tables(JS8Constants::Mode mode);
+
+} // namespace JS8DSP
+
+#endif // MODE_TABLES_H
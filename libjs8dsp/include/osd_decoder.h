@@ -0,0 +1,49 @@
+#ifndef OSD_DECODER_H
+#define OSD_DECODER_H
+
+#include "bp_decoder.h"
+
+namespace BPDSP {
+    constexpr int OSD_MAX_ORDER = 2;
+    constexpr int OSD_ORDER2_BITS = 30;   // Least reliable information bits paired at order 2
+
+    // Bit sets: a reduced parity check over the codeword, and the reduced
+    // checks an information bit feeds
+    constexpr int OSD_ROW_WORDS = (N + 63) / 64;
+    constexpr int OSD_SET_WORDS = (M + 63) / 64;
+
+    // Reduced parity checks of osd174. A workspace need not be initialised
+    // and may be reused for any number of calls, one at a time.
+    struct OsdWorkspace {
+        std::array<std::array<uint64_t, OSD_ROW_WORDS>, M> rows;
+        std::array<std::array<uint64_t, OSD_SET_WORDS>, N> feeds;
+    };
+
+    /**
+     * Ordered statistics decoding of the (174,87) code, for candidates
+     * belief propagation could not decode. The parity checks are reduced
+     * so that the least reliable independent bits depend on the others;
+     * the hard decisions of the remaining, most reliable, information bits
+     * are then re-encoded with every combination of up to order of them
+     * flipped, keeping the codeword at the smallest reliability-weighted
+     * distance from the hard decisions. Order 2 flips pairs among the
+     * OSD_ORDER2_BITS least reliable information bits only.
+     * @param llr Channel LLRs (positive = bit 1)
+     * @param order Flipped bits tried, 0 to OSD_MAX_ORDER
+     * @param decoded Message bits of the codeword found
+     * @param cw Codeword found
+     * @return Hard errors against llr, as bpdecode174; a codeword is
+     *         always found, so the caller decides whether to accept it
+     */
+    int osd174(const std::array<float, N>& llr,
+               int order,
+               std::array<int8_t, K>& decoded,
+               std::array<int8_t, N>& cw);
+    int osd174(const std::array<float, N>& llr,
+               int order,
+               std::array<int8_t, K>& decoded,
+               std::array<int8_t, N>& cw,
+               OsdWorkspace& work);
+}
+
+#endif // OSD_DECODER_H
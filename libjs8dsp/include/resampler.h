@@ -0,0 +1,87 @@
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "thread_policy.h"
+
+namespace JS8DSP {
+
+// Stopband attenuation of the resampler's prototype filter
+constexpr double RESAMPLER_ATTENUATION_DB = 80.0;
+
+/**
+ * Rational polyphase FIR resampler, by L/M with L and M the output and
+ * input rates over their greatest common divisor (1/4 for 48 kHz to
+ * 12 kHz, 40/147 for 44.1 kHz). The prototype is a Kaiser windowed sinc
+ * at L times the input rate, passing 3/4 of the lower Nyquist frequency
+ * and stopping everything above it by RESAMPLER_ATTENUATION_DB, so that
+ * nothing aliases into the decoded band. Each output is one dot product
+ * of the most recent taps() input samples with one phase of the filter.
+ *
+ * The filter is causal: outputs lag the input by its group delay, about
+ * 1.7 ms, and are written as soon as the input they need has been
+ * given, so a stream may be fed in chunks of any size and produces the
+ * same samples as one call. Tables are allocated by the constructor
+ * only.
+ */
+class Resampler {
+public:
+    Resampler(int input_rate, int output_rate);
+
+    // Forget past input, as at the start of a new stream
+    void reset();
+
+    int interpolation() const { return interpolation_; }
+    int decimation() const { return decimation_; }
+    int taps() const { return taps_; }
+
+    /**
+     * Resample input until it runs out or out is full
+     * @param consumed Input samples used; input beyond them is needed
+     *                 only by outputs after out_size
+     * @return Samples written to out
+     */
+    size_t process(const float* in, size_t count, float* out, size_t out_size, size_t& consumed);
+    size_t process(const int16_t* in, size_t count, float* out, size_t out_size, size_t& consumed);
+
+    // As process, reading every stride-th sample, e.g. one channel of
+    // interleaved audio; count and consumed are in samples of that channel
+    size_t process(const float* in, size_t count, size_t stride, float* out, size_t out_size, size_t& consumed);
+    size_t process(const int16_t* in, size_t count, size_t stride, float* out, size_t out_size, size_t& consumed);
+
+    // Name of the dot product kernel selected for this CPU, for diagnostics
+    static const char* kernel_name();
+
+    // Lock, or unlock, the filter and its history in RAM
+    void lock_memory(MemoryLock& lock) const {
+        lock.add(coeffs_);
+        lock.add(history_);
+    }
+
+private:
+    template <typename Sample>
+    size_t run(const Sample* in, size_t count, size_t stride, float* out, size_t out_size, size_t& consumed);
+
+    int interpolation_;         // L
+    int decimation_;            // M
+    int taps_;                  // Taps per phase
+
+    // Phase p of the filter at coeffs_[p * taps_], ordered oldest input
+    // sample first
+    std::vector<float> coeffs_;
+
+    // The last taps_ input samples, written twice so the window starting
+    // at position_ is always contiguous
+    std::vector<float> history_;
+    int position_;
+
+    uint64_t received_;         // Input samples taken since reset
+    uint64_t newest_;           // Newest input sample the next output needs
+    int phase_;                 // Filter phase of the next output
+};
+
+} // namespace JS8DSP
+
+#endif // RESAMPLER_H
@@ -0,0 +1,37 @@
+#ifndef SAMPLE_CONVERT_H
+#define SAMPLE_CONVERT_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace JS8DSP {
+
+// Scale applied to signed 16-bit PCM to bring it to [-1, 1)
+constexpr float S16_SCALE = 1.0f / 32768.0f;
+
+inline float sample_to_float(float sample) { return sample; }
+inline float sample_to_float(int16_t sample) { return sample * S16_SCALE; }
+
+/**
+ * Convert signed 16-bit PCM to float in [-1, 1). Uses SSE2 on x86-64 and
+ * NEON on AArch64, eight samples per step, with a scalar tail. Neither
+ * pointer needs any particular alignment.
+ */
+void convert_samples(const int16_t* in, float* out, size_t count);
+
+// Float input needs no conversion; overload so sample-type templates can
+// use either
+void convert_samples(const float* in, float* out, size_t count);
+
+// Convert every stride-th sample, e.g. one channel of interleaved audio;
+// a stride of 1 is the same as the contiguous overloads
+void convert_samples(const int16_t* in, size_t stride, float* out, size_t count);
+void convert_samples(const float* in, size_t stride, float* out, size_t count);
+
+// IEEE 754 half precision bits of a float, rounded to nearest even;
+// out of range values become infinities
+uint16_t float_to_half(float value);
+
+} // namespace JS8DSP
+
+#endif // SAMPLE_CONVERT_H
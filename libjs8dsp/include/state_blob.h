@@ -0,0 +1,80 @@
+#ifndef STATE_BLOB_H
+#define STATE_BLOB_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace JS8DSP {
+
+/**
+ * Writes values in host byte order into a caller's buffer, counting the
+ * bytes that did not fit so that a first pass can size the buffer.
+ */
+class StateWriter {
+public:
+    StateWriter(void* buffer, size_t size) : buffer_(static_cast<unsigned char*>(buffer)), size_(size) {}
+
+    void write(const void* data, size_t bytes) {
+        if (buffer_ && used_ + bytes <= size_) std::memcpy(buffer_ + used_, data, bytes);
+        used_ += bytes;
+    }
+
+    template <typename T>
+    void put(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        write(&value, sizeof(T));
+    }
+
+    // Bytes written, or that would have been
+    size_t used() const { return used_; }
+    bool fits() const { return buffer_ && used_ <= size_; }
+
+private:
+    unsigned char* buffer_;
+    size_t size_;
+    size_t used_ = 0;
+};
+
+/**
+ * Reads values written by a StateWriter; every read after the end of the
+ * buffer fails.
+ */
+class StateReader {
+public:
+    StateReader(const void* buffer, size_t size) : buffer_(static_cast<const unsigned char*>(buffer)), size_(size) {}
+
+    bool read(void* data, size_t bytes) {
+        if (bytes > size_ - used_) return false;
+        std::memcpy(data, buffer_ + used_, bytes);
+        used_ += bytes;
+        return true;
+    }
+
+    template <typename T>
+    bool get(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        return read(&value, sizeof(T));
+    }
+
+    const unsigned char* position() const { return buffer_ + used_; }
+    size_t remaining() const { return size_ - used_; }
+
+private:
+    const unsigned char* buffer_;
+    size_t size_;
+    size_t used_ = 0;
+};
+
+// FNV-1a, to tell a damaged state from one that merely ends early
+inline uint32_t state_checksum(const void* data, size_t bytes) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < bytes; ++i) hash = (hash ^ p[i]) * 16777619u;
+    return hash;
+}
+
+} // namespace JS8DSP
+
+#endif // STATE_BLOB_H
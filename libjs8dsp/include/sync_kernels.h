@@ -0,0 +1,42 @@
+#ifndef SYNC_KERNELS_H
+#define SYNC_KERNELS_H
+
+#include <cstddef>
+
+namespace JS8DSP {
+
+/**
+ * Tone correlation kernel. For each of count templates of length samples,
+ * stored back to back in t_re / t_im, writes the magnitude of the
+ * correlation of the signal x with the conjugate template:
+ *
+ *     magnitudes[c] = | sum_k x[k] * conj(t[c * length + k]) |
+ *
+ * Signal and templates are struct-of-arrays I/Q; no alignment is required.
+ */
+using CorrelateFn = void (*)(const float* x_re, const float* x_im,
+                             const float* t_re, const float* t_im,
+                             int length, int count, float* magnitudes);
+
+/**
+ * Best correlation kernel for this CPU: AVX2 when the processor supports
+ * it, otherwise SSE2 on x86-64, NEON on AArch64 and portable code
+ * elsewhere. Selected once, on first use.
+ */
+CorrelateFn correlate_kernel();
+
+/**
+ * Name of the kernel correlate_kernel() selected, for diagnostics
+ */
+const char* correlate_kernel_name();
+
+/**
+ * Portable reference implementation
+ */
+void correlate_scalar(const float* x_re, const float* x_im,
+                      const float* t_re, const float* t_im,
+                      int length, int count, float* magnitudes);
+
+} // namespace JS8DSP
+
+#endif // SYNC_KERNELS_H
@@ -0,0 +1,113 @@
+#ifndef THREAD_POLICY_H
+#define THREAD_POLICY_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace JS8DSP {
+
+/**
+ * Where and how decode threads run: the CPUs the workers are pinned to,
+ * their scheduling class, and whether the memory they decode with is
+ * locked in RAM. The default policy leaves threads as they were started.
+ *
+ * Policies are only supported on Linux; elsewhere applying anything but
+ * the default fails with ENOTSUP.
+ */
+struct ThreadPolicy {
+    static constexpr int MAX_CPUS = 64;
+
+    enum class Sched {
+        OTHER,      // Time sharing, as threads were started
+        FIFO,
+        RR
+    };
+
+    std::array<int, MAX_CPUS> cpus{};   // Worker i runs on cpus[i % cpu_count]
+    int cpu_count = 0;                  // 0 not to pin
+    Sched sched = Sched::OTHER;
+    int priority = 0;                   // Of FIFO and RR
+    bool lock_memory = false;
+
+    bool pinned() const { return cpu_count > 0; }
+    bool realtime() const { return sched != Sched::OTHER; }
+    bool active() const { return pinned() || realtime() || lock_memory; }
+};
+
+// Stack a thread decoding with locked memory faults in and locks below
+// the frame it applied the policy from
+constexpr size_t LOCKED_STACK_SIZE = 256 * 1024;
+
+/**
+ * Apply a policy to the calling thread for good, as the given worker;
+ * for threads that only ever decode. Returns 0 or an errno value, in
+ * which case the thread may be left with part of the policy.
+ */
+int apply_thread_policy(const ThreadPolicy& policy, size_t worker);
+
+/**
+ * Applies a policy to the calling thread, as worker 0, while it is open,
+ * and gives the thread back its own affinity and scheduling, and unlocks
+ * its stack, when it closes. Opening and closing a scope on the default
+ * policy costs nothing; otherwise it takes a few system calls and does
+ * not allocate.
+ */
+class ThreadPolicyScope {
+public:
+    explicit ThreadPolicyScope(const ThreadPolicy& policy);
+    ~ThreadPolicyScope();
+
+    ThreadPolicyScope(const ThreadPolicyScope&) = delete;
+    ThreadPolicyScope& operator=(const ThreadPolicyScope&) = delete;
+
+    // 0 if the whole policy applied, otherwise the first errno value
+    int error() const { return error_; }
+
+private:
+    int error_ = 0;
+
+#if defined(__linux__)
+    bool restore_affinity_ = false;
+    cpu_set_t affinity_;
+    bool restore_sched_ = false;
+    int sched_policy_ = SCHED_OTHER;
+    sched_param sched_param_{};
+    const void* stack_ = nullptr;       // Locked, if not null
+    size_t stack_size_ = 0;
+#endif
+};
+
+/**
+ * Locks memory regions in RAM, faulting them in, or unlocks them. Locks
+ * do not nest: a page is unlocked once any region on it is.
+ */
+class MemoryLock {
+public:
+    explicit MemoryLock(bool lock) : lock_(lock) {}
+
+    void add(const void* data, size_t bytes);
+
+    template <typename T>
+    void add(const std::vector<T>& buffer) {
+        add(buffer.data(), buffer.capacity() * sizeof(T));
+    }
+
+    // Bytes of the regions added, and 0 or the first errno value
+    size_t bytes() const { return bytes_; }
+    int error() const { return error_; }
+
+private:
+    bool lock_;
+    size_t bytes_ = 0;
+    int error_ = 0;
+};
+
+} // namespace JS8DSP
+
+#endif // THREAD_POLICY_H
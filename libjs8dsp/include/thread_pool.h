@@ -0,0 +1,111 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "thread_policy.h"
+#include <type_traits>
+#include <vector>
+
+namespace JS8DSP {
+
+/**
+ * Fixed-size work-stealing pool for data-parallel loops.
+ *
+ * parallel_for() splits an index range into one contiguous block per
+ * worker. A worker takes indices from the front of its own block; once
+ * that is empty it steals the back half of the fullest remaining block.
+ * The calling thread takes part as worker 0, so a pool of size N starts
+ * N - 1 threads. Dispatch does not allocate.
+ *
+ * A thread policy, if given, is applied by each thread to itself as it
+ * starts, as its worker number; the calling thread is left to apply it
+ * to itself.
+ */
+class ThreadPool {
+public:
+    /**
+     * @param threads Total workers including the caller; values below 1 are treated as 1
+     * @param policy Applied to the threads started; see policy_error()
+     */
+    explicit ThreadPool(int threads, const ThreadPolicy& policy = ThreadPolicy());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Number of workers, including the calling thread
+     */
+    size_t size() const { return queues_.size(); }
+
+    /**
+     * 0 if every thread took the policy, otherwise the errno value one of
+     * them failed with; a pool whose threads hold part of a policy should
+     * not be used
+     */
+    int policy_error() const { return policy_error_; }
+
+    /**
+     * Run fn(index, worker) for every index in [0, count) and wait for all
+     * of them to finish. worker is in [0, size()) and identifies the thread
+     * running the call, so it may be used to select per-worker scratch.
+     * Only one parallel_for may run on a pool at a time.
+     */
+    template <typename F>
+    void parallel_for(size_t count, F&& fn) {
+        run(count, [](void* context, size_t index, size_t worker) {
+            (*static_cast<std::remove_reference_t<F>*>(context))(index, worker);
+        }, &fn);
+    }
+
+    /**
+     * Priority of the work parallel_for(count, ...) runs at index, 0 being
+     * the highest. Ranks are dealt out across the workers' blocks in turn,
+     * so looking work up by rank(index, count) in a list ordered by
+     * priority starts every worker on the most important work, rather
+     * than giving the first worker all of it.
+     */
+    size_t rank(size_t index, size_t count) const;
+
+private:
+    using Task = void (*)(void* context, size_t index, size_t worker);
+
+    // Remaining range of one worker's block
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    void run(size_t count, Task task, void* context);
+    void worker_loop(size_t worker, ThreadPolicy policy);
+    void drain(size_t worker);
+    bool pop(size_t worker, size_t& index);
+    bool steal(size_t worker, size_t& index);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    uint64_t generation_ = 0;
+    size_t busy_ = 0;
+    bool stop_ = false;
+    size_t started_ = 0;        // Threads that have applied the policy
+    int policy_error_ = 0;
+
+    Task task_ = nullptr;
+    void* context_ = nullptr;
+    std::atomic<size_t> pending_{0};
+};
+
+} // namespace JS8DSP
+
+#endif // THREAD_POOL_H
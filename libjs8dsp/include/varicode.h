@@ -2,6 +2,7 @@
 #define VARICODE_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -48,6 +49,74 @@ int varicode_decode_symbols(varicode_encoder_t* encoder,
                            char* output,
                            size_t output_size);
 
+/**
+ * Encode text message to packed varicode bits, first bit in the most
+ * significant bit of the first byte
+ * @param encoder Encoder handle
+ * @param message Input text message
+ * @param output Output buffer for packed bits
+ * @param output_size Size of output buffer in bytes
+ * @return Number of bits written, or negative error code
+ */
+int varicode_encode_bits(varicode_encoder_t* encoder,
+                         const char* message,
+                         uint8_t* output,
+                         size_t output_size);
+
+/**
+ * Decode packed varicode bits to text message
+ * @param encoder Encoder handle
+ * @param bits Packed bits, as written by varicode_encode_bits
+ * @param bit_count Number of bits
+ * @param output Output buffer for decoded message
+ * @param output_size Size of output buffer
+ * @return Length of decoded message, or negative error code
+ */
+int varicode_decode_bits(varicode_encoder_t* encoder,
+                         const uint8_t* bits,
+                         size_t bit_count,
+                         char* output,
+                         size_t output_size);
+
+/**
+ * Encode several messages without allocating. Each is written to output
+ * as varicode_encode_message would, NUL terminated and directly after the
+ * previous one, until one does not fit.
+ * @param encoder Encoder handle
+ * @param messages Input text messages
+ * @param count Number of messages
+ * @param output Output buffer shared by all encoded messages
+ * @param output_size Size of output buffer
+ * @param lengths Length of each encoded message (output), -1 for those
+ *                not encoded
+ * @return Number of messages encoded, or negative error code
+ */
+int varicode_encode_batch(varicode_encoder_t* encoder,
+                          const char* const* messages,
+                          size_t count,
+                          char* output,
+                          size_t output_size,
+                          int* lengths);
+
+/**
+ * Decode several varicode symbol strings without allocating, laid out
+ * in output as for varicode_encode_batch
+ * @param encoder Encoder handle
+ * @param symbols Input varicode symbol strings
+ * @param count Number of strings
+ * @param output Output buffer shared by all decoded messages
+ * @param output_size Size of output buffer
+ * @param lengths Length of each decoded message (output), -1 for those
+ *                not decoded
+ * @return Number of messages decoded, or negative error code
+ */
+int varicode_decode_batch(varicode_encoder_t* encoder,
+                          const char* const* symbols,
+                          size_t count,
+                          char* output,
+                          size_t output_size,
+                          int* lengths);
+
 /**
  * Validate that message contains only valid characters
  * @param encoder Encoder handle
@@ -58,6 +127,22 @@ int varicode_validate_message(varicode_encoder_t* encoder, const char* message);
 
 #ifdef __cplusplus
 }
+
+namespace JS8DSP {
+
+// Varicode of one character: its bits, first bit most significant, in
+// the low length bits; length is 0 for characters without a code
+struct VaricodeCode {
+    uint8_t bits;
+    uint8_t length;
+};
+
+VaricodeCode varicode_code(char c);
+
+// Decode packed varicode bits as varicode_decode_bits, without an encoder
+int varicode_decode_packed(const uint8_t* bits, size_t bit_count, char* output, size_t output_size);
+
+} // namespace JS8DSP
 #endif
 
 #endif // VARICODE_H
\ No newline at end of file
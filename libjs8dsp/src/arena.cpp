@@ -0,0 +1,64 @@
+/**
+ * Bump allocator for transient decode data
+ *
+ * js8d project
+ */
+
+#include "../include/arena.h"
+#include <algorithm>
+
+namespace JS8DSP {
+
+Arena::Arena(size_t capacity) {
+    if (capacity > 0) add_block(capacity);
+}
+
+bool Arena::reset() {
+    const bool grew = blocks_.size() > 1;
+    if (grew) {
+        const size_t total = capacity_;
+        blocks_.clear();
+        capacity_ = 0;
+        add_block(total);
+    }
+
+    block_ = 0;
+    offset_ = 0;
+    used_ = 0;
+    peak_ = 0;
+    return grew;
+}
+
+void* Arena::allocate_bytes(size_t bytes, size_t alignment) {
+    for (;;) {
+        if (block_ < blocks_.size()) {
+            const Block& block = blocks_[block_];
+            const size_t start = (offset_ + alignment - 1) & ~(alignment - 1);
+            if (start + bytes <= block.size) {
+                used_ += start + bytes - offset_;
+                offset_ = start + bytes;
+                peak_ = std::max(peak_, used_);
+                return block.data.get() + start;
+            }
+            if (block_ + 1 < blocks_.size()) {
+                ++block_;
+                offset_ = 0;
+                continue;
+            }
+        }
+
+        // Out of room; chain on a block at least as large as all the others
+        add_block(std::max(bytes, capacity_));
+        block_ = blocks_.size() - 1;
+        offset_ = 0;
+    }
+}
+
+void Arena::add_block(size_t size) {
+    Block block{std::unique_ptr<std::byte[], BlockDeleter>(::new (std::align_val_t{ALIGNMENT}) std::byte[size]),
+                size};
+    blocks_.push_back(std::move(block));
+    capacity_ += size;
+}
+
+} // namespace JS8DSP
@@ -10,9 +10,131 @@
 #include <algorithm>
 #include <numeric>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 
 namespace JS8DSP {
 
+namespace {
+
+// 10 log10(x) for positive normal x, to about 1e-4 dB. The exponent is
+// taken from the bits and log2 of the mantissa from an atanh series, so
+// a loop over it vectorises.
+inline float fast_db(float x) {
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    const float exponent = static_cast<float>(static_cast<int>(bits >> 23) - 127);
+    bits = (bits & 0x007fffffu) | 0x3f800000u;
+    float mantissa;
+    std::memcpy(&mantissa, &bits, sizeof(mantissa));
+
+    // log2(m) = 2 / ln 2 * atanh(t), m in [1, 2), t = (m - 1) / (m + 1)
+    const float t = (mantissa - 1.0f) / (mantissa + 1.0f);
+    const float t2 = t * t;
+    const float series = t * (2.8853901f + t2 * (0.9617967f + t2 * (0.5770780f + t2 * 0.4121986f)));
+
+    return 3.0103000f * (exponent + series);  // 10 log10(2) * log2(x)
+}
+
+} // namespace
+
+void BaselineComputation::reserve(size_t bins) {
+    log_spectrum_.reserve(bins);
+    window_values_.reserve(bins);
+}
+
+void BaselineComputation::setIncremental(bool incremental) {
+    incremental_ = incremental;
+    have_fit_ = false;
+}
+
+bool BaselineComputation::saveFit(Fit& fit) const {
+    if (!have_fit_) return false;
+
+    fit.size = fit_size_;
+    fit.y = fit_y_;
+    fit.c0 = fit_c0_;
+    for (size_t i = 0; i < fit.c.size(); ++i) fit.c[i] = c_[i];
+    return true;
+}
+
+void BaselineComputation::restoreFit(const Fit& fit) {
+    have_fit_ = true;
+    fit_size_ = fit.size;
+    fit_y_ = fit.y;
+    fit_c0_ = fit.c0;
+    for (size_t i = 0; i < fit.c.size(); ++i) c_[i] = fit.c[i];
+}
+
+void BaselineComputation::fit(const std::array<double, BASELINE_DEGREE + 1>& x,
+                              const std::array<double, BASELINE_DEGREE + 1>& y,
+                              size_t size) {
+    constexpr size_t count = BASELINE_DEGREE + 1;
+
+    if (incremental_ && have_fit_ && size == fit_size_) {
+        double mean = 0.0;
+        for (size_t i = 0; i < count; ++i) mean += y[i] - fit_y_[i];
+        mean /= count;
+
+        double deviation = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            deviation = std::max(deviation, std::abs(y[i] - fit_y_[i] - mean));
+        }
+
+        if (deviation <= BASELINE_REFIT_TOLERANCE) {
+            c_[0] = fit_c0_ + mean;
+            ++updates_;
+            return;
+        }
+    }
+
+#ifndef JS8DSP_NO_EIGEN
+    // Build Vandermonde matrix for polynomial fitting; fixed-size types
+    // keep Eigen off the heap
+    Coefficients xs = Eigen::Map<const Coefficients>(x.data());
+    Coefficients ys = Eigen::Map<const Coefficients>(y.data());
+
+    V_.col(0).setOnes();  // x^0 terms
+    for (Eigen::Index i = 1; i < V_.cols(); ++i) {
+        V_.col(i) = V_.col(i - 1).cwiseProduct(xs);  // x^i terms
+    }
+
+    // Solve the least squares problem: V * c = y
+    // Using QR decomposition for numerical stability
+    c_ = V_.colPivHouseholderQr().solve(ys);
+#else
+    // Simple polynomial fitting (least squares with normal equations - not as stable as QR)
+    // For simplicity, use a linear fit instead of full polynomial
+    double sum_x = 0, sum_y = 0, sum_xx = 0, sum_xy = 0;
+    for (size_t i = 0; i < count; ++i) {
+        sum_x += x[i];
+        sum_y += y[i];
+        sum_xx += x[i] * x[i];
+        sum_xy += x[i] * y[i];
+    }
+
+    double denom = count * sum_xx - sum_x * sum_x;
+    if (std::abs(denom) > 1e-10) {
+        c_[1] = (count * sum_xy - sum_x * sum_y) / denom;  // slope
+        c_[0] = (sum_y - c_[1] * sum_x) / count;          // intercept
+    } else {
+        c_[0] = sum_y / count;  // average
+        c_[1] = 0.0;
+    }
+
+    // Clear higher order terms
+    for (size_t i = 2; i < count; ++i) {
+        c_[i] = 0.0;
+    }
+#endif
+
+    have_fit_ = true;
+    fit_size_ = size;
+    fit_y_ = y;
+    fit_c0_ = c_[0];
+    ++refits_;
+}
+
 void BaselineComputation::computeBaseline(const std::vector<float>& spectrum,
                                         float freq_resolution,
                                         int ia, int ib,
@@ -39,12 +161,15 @@ void BaselineComputation::computeBaseline(const std::vector<float>& spectrum,
     auto size = bmax - bmin + 1;
     auto arm = size / (2 * BASELINE_NODES.size());
 
-    // Convert power spectrum to dB scale in the baseline region
-    std::vector<float> log_spectrum(spectrum.size());
-    std::transform(spectrum.begin(), spectrum.end(), log_spectrum.begin(),
-                   [](float value) {
-                       return 10.0f * std::log10(std::max(value, 1e-10f));
-                   });
+    // Convert power spectrum to dB scale in the baseline region; only
+    // bins bmin to bmax are ever sampled
+    auto& log_spectrum = log_spectrum_;
+    log_spectrum.resize(spectrum.size());
+    std::transform(spectrum.begin() + bmin, spectrum.begin() + bmax + 1, log_spectrum.begin() + bmin,
+                   [](float value) { return fast_db(std::max(value, 1e-10f)); });
+
+    std::array<double, BASELINE_DEGREE + 1> xs;
+    std::array<double, BASELINE_DEGREE + 1> ys;
 
 #ifndef JS8DSP_NO_EIGEN
     // Eigen version - full polynomial fitting
@@ -63,7 +188,8 @@ void BaselineComputation::computeBaseline(const std::vector<float>& spectrum,
         }
 
         // Extract values in this window
-        std::vector<float> window_values;
+        auto& window_values = window_values_;
+        window_values.clear();
         for (size_t j = start; j < end; ++j) {
             window_values.push_back(log_spectrum[j]);
         }
@@ -85,20 +211,11 @@ void BaselineComputation::computeBaseline(const std::vector<float>& spectrum,
         p_(i, 1) = window_values[n];  // y coordinate (dB value)
     }
 
-    // Extract x and y vectors for matrix operations
-    Eigen::VectorXd x = p_.col(0);
-    Eigen::VectorXd y = p_.col(1);
-
-    // Build Vandermonde matrix for polynomial fitting
-    V_.col(0).setOnes();  // x^0 terms
-    for (Eigen::Index i = 1; i < V_.cols(); ++i) {
-        V_.col(i) = V_.col(i - 1).cwiseProduct(x);  // x^i terms
+    for (std::size_t i = 0; i < BASELINE_NODES.size(); ++i) {
+        xs[i] = p_(i, 0);
+        ys[i] = p_(i, 1);
     }
 
-    // Solve the least squares problem: V * c = y
-    // Using QR decomposition for numerical stability
-    c_ = V_.colPivHouseholderQr().solve(y);
-
 #else
     // Fallback version without Eigen - simplified baseline computation
     // Collect sample points
@@ -128,33 +245,14 @@ void BaselineComputation::computeBaseline(const std::vector<float>& spectrum,
         p_[i][1] = min_val;
     }
 
-    // Simple polynomial fitting (least squares with normal equations - not as stable as QR)
-    // For simplicity, use a linear fit instead of full polynomial
-    if (num_points >= 2) {
-        double sum_x = 0, sum_y = 0, sum_xx = 0, sum_xy = 0;
-        for (int i = 0; i < num_points; ++i) {
-            sum_x += p_[i][0];
-            sum_y += p_[i][1];
-            sum_xx += p_[i][0] * p_[i][0];
-            sum_xy += p_[i][0] * p_[i][1];
-        }
-
-        double denom = num_points * sum_xx - sum_x * sum_x;
-        if (std::abs(denom) > 1e-10) {
-            c_[1] = (num_points * sum_xy - sum_x * sum_y) / denom;  // slope
-            c_[0] = (sum_y - c_[1] * sum_x) / num_points;          // intercept
-        } else {
-            c_[0] = sum_y / num_points;  // average
-            c_[1] = 0.0;
-        }
-
-        // Clear higher order terms
-        for (int i = 2; i < num_nodes; ++i) {
-            c_[i] = 0.0;
-        }
+    for (int i = 0; i < num_points; ++i) {
+        xs[i] = p_[i][0];
+        ys[i] = p_[i][1];
     }
 #endif
 
+    fit(xs, ys, size);
+
     // Initialize baseline array
     baseline.assign(spectrum.size(), 0.0f);
 
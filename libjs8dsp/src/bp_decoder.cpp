@@ -13,81 +13,144 @@
 
 namespace BPDSP {
 
-// Simplified BP matrices for testing - using a subset of the actual matrices
-// Real JS8 uses complex LDPC matrices that are quite large
-
-// For now, use a basic systematic approach
-const std::array<VariableChecks, N> Mn = {{
-    // Initialize all variable nodes to connect to first 3 check nodes (simplified)
-    {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2},
-    {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2},
-    {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2},
-    {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2},
-    {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2},
-    {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2},
-    {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2},
-    {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2},
-    {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2},
-    {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2},
-    {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2},
-    {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2},
-    {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2},
-    {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2},
-    {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2},
-    {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2},
-    {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2},
-    {0, 1, 2}, {0, 1, 2}, {0, 1, 2}, {0, 1, 2}
+// Parity check matrix of the (174,87) LDPC code, as used by JS8Call.
+// Mn lists the 3 checks each bit takes part in; Nm lists the bits in each
+// check, padded with zeros beyond valid_neighbors.
+constexpr std::array<VariableChecks, N> Mn = {{
+    { 0, 24, 68}, { 1,  4, 72}, { 2, 31, 67}, { 3, 50, 60}, { 5, 62, 69}, { 6, 32, 78},
+    { 7, 49, 85}, { 8, 36, 42}, { 9, 40, 64}, {10, 13, 63}, {11, 74, 76}, {12, 22, 80},
+    {14, 15, 81}, {16, 55, 65}, {17, 52, 59}, {18, 30, 51}, {19, 66, 83}, {20, 28, 71},
+    {21, 23, 43}, {25, 34, 75}, {26, 35, 37}, {27, 39, 41}, {29, 53, 54}, {33, 48, 86},
+    {38, 56, 57}, {44, 73, 82}, {45, 61, 79}, {46, 47, 84}, {58, 70, 77}, { 0, 49, 52},
+    { 1, 46, 83}, { 2, 24, 78}, { 3,  5, 13}, { 4,  6, 79}, { 7, 33, 54}, { 8, 35, 68},
+    { 9, 42, 82}, {10, 22, 73}, {11, 16, 43}, {12, 56, 75}, {14, 26, 55}, {15, 27, 28},
+    {17, 18, 58}, {19, 39, 62}, {20, 34, 51}, {21, 53, 63}, {23, 61, 77}, {25, 31, 76},
+    {29, 71, 84}, {30, 64, 86}, {32, 38, 50}, {36, 47, 74}, {37, 69, 70}, {40, 41, 67},
+    {44, 66, 85}, {45, 80, 81}, {48, 65, 72}, {57, 59, 65}, {60, 64, 84}, { 0, 13, 20},
+    { 1, 12, 58}, { 2, 66, 81}, { 3, 31, 72}, { 4, 35, 53}, { 5, 42, 45}, { 6, 27, 74},
+    { 7, 32, 70}, { 8, 48, 75}, { 9, 57, 63}, {10, 47, 67}, {11, 18, 44}, {14, 49, 60},
+    {15, 21, 25}, {16, 71, 79}, {17, 39, 54}, {19, 34, 50}, {22, 24, 33}, {23, 62, 86},
+    {26, 38, 73}, {28, 77, 82}, {29, 69, 76}, {30, 68, 83}, {21, 36, 85}, {37, 40, 80},
+    {41, 43, 56}, {46, 52, 61}, {51, 55, 78}, {59, 74, 80}, { 0, 38, 76}, { 1, 15, 40},
+    { 2, 30, 53}, { 3, 35, 77}, { 4, 44, 64}, { 5, 56, 84}, { 6, 13, 48}, { 7, 20, 45},
+    { 8, 14, 71}, { 9, 19, 61}, {10, 16, 70}, {11, 33, 46}, {12, 67, 85}, {17, 22, 42},
+    {18, 63, 72}, {23, 47, 78}, {24, 69, 82}, {25, 79, 86}, {26, 31, 39}, {27, 55, 68},
+    {28, 62, 65}, {29, 41, 49}, {32, 36, 81}, {34, 59, 73}, {37, 54, 83}, {43, 51, 60},
+    {50, 52, 71}, {57, 58, 66}, {46, 55, 75}, { 0, 18, 36}, { 1, 60, 74}, { 2,  7, 65},
+    { 3, 59, 83}, { 4, 33, 38}, { 5, 25, 52}, { 6, 31, 56}, { 8, 51, 66}, { 9, 11, 14},
+    {10, 50, 68}, {12, 13, 64}, {15, 30, 42}, {16, 19, 35}, {17, 79, 85}, {20, 47, 58},
+    {21, 39, 45}, {22, 32, 61}, {23, 29, 73}, {24, 41, 63}, {26, 48, 84}, {27, 37, 72},
+    {28, 43, 80}, {34, 67, 69}, {40, 62, 75}, {44, 48, 70}, {49, 57, 86}, {47, 53, 82},
+    {12, 54, 78}, {76, 77, 81}, { 0,  1, 23}, { 2,  5, 74}, { 3, 55, 86}, { 4, 43, 52},
+    { 6, 49, 82}, { 7,  9, 27}, { 8, 54, 61}, {10, 28, 66}, {11, 32, 39}, {13, 15, 19},
+    {14, 34, 72}, {16, 30, 38}, {17, 35, 56}, {18, 45, 75}, {20, 41, 83}, {21, 33, 58},
+    {22, 25, 60}, {24, 59, 64}, {26, 63, 79}, {29, 36, 65}, {31, 44, 71}, {37, 50, 85},
+    {40, 76, 78}, {42, 55, 67}, {46, 73, 81}, {39, 51, 77}, {53, 60, 70}, {45, 57, 68}
 }};
 
-// Simplified check node connections - each check connects to multiple variables
-const std::array<CheckNode, M> Nm = {{
-    // Each check node connects to 6 variable nodes (simplified pattern)
-    {6, {0, 1, 2, 3, 4, 5, 0}}, {6, {6, 7, 8, 9, 10, 11, 0}}, {6, {12, 13, 14, 15, 16, 17, 0}},
-    {6, {18, 19, 20, 21, 22, 23, 0}}, {6, {24, 25, 26, 27, 28, 29, 0}}, {6, {30, 31, 32, 33, 34, 35, 0}},
-    {6, {36, 37, 38, 39, 40, 41, 0}}, {6, {42, 43, 44, 45, 46, 47, 0}}, {6, {48, 49, 50, 51, 52, 53, 0}},
-    {6, {54, 55, 56, 57, 58, 59, 0}}, {6, {60, 61, 62, 63, 64, 65, 0}}, {6, {66, 67, 68, 69, 70, 71, 0}},
-    {6, {72, 73, 74, 75, 76, 77, 0}}, {6, {78, 79, 80, 81, 82, 83, 0}}, {6, {84, 85, 86, 87, 88, 89, 0}},
-    {6, {90, 91, 92, 93, 94, 95, 0}}, {6, {96, 97, 98, 99, 100, 101, 0}}, {6, {102, 103, 104, 105, 106, 107, 0}},
-    {6, {108, 109, 110, 111, 112, 113, 0}}, {6, {114, 115, 116, 117, 118, 119, 0}}, {6, {120, 121, 122, 123, 124, 125, 0}},
-    {6, {126, 127, 128, 129, 130, 131, 0}}, {6, {132, 133, 134, 135, 136, 137, 0}}, {6, {138, 139, 140, 141, 142, 143, 0}},
-    {6, {144, 145, 146, 147, 148, 149, 0}}, {6, {150, 151, 152, 153, 154, 155, 0}}, {6, {156, 157, 158, 159, 160, 161, 0}},
-    {6, {162, 163, 164, 165, 166, 167, 0}}, {6, {168, 169, 170, 171, 172, 173, 0}}, {6, {0, 29, 58, 87, 116, 145, 0}},
-    {6, {1, 30, 59, 88, 117, 146, 0}}, {6, {2, 31, 60, 89, 118, 147, 0}}, {6, {3, 32, 61, 90, 119, 148, 0}},
-    {6, {4, 33, 62, 91, 120, 149, 0}}, {6, {5, 34, 63, 92, 121, 150, 0}}, {6, {6, 35, 64, 93, 122, 151, 0}},
-    {6, {7, 36, 65, 94, 123, 152, 0}}, {6, {8, 37, 66, 95, 124, 153, 0}}, {6, {9, 38, 67, 96, 125, 154, 0}},
-    {6, {10, 39, 68, 97, 126, 155, 0}}, {6, {11, 40, 69, 98, 127, 156, 0}}, {6, {12, 41, 70, 99, 128, 157, 0}},
-    {6, {13, 42, 71, 100, 129, 158, 0}}, {6, {14, 43, 72, 101, 130, 159, 0}}, {6, {15, 44, 73, 102, 131, 160, 0}},
-    {6, {16, 45, 74, 103, 132, 161, 0}}, {6, {17, 46, 75, 104, 133, 162, 0}}, {6, {18, 47, 76, 105, 134, 163, 0}},
-    {6, {19, 48, 77, 106, 135, 164, 0}}, {6, {20, 49, 78, 107, 136, 165, 0}}, {6, {21, 50, 79, 108, 137, 166, 0}},
-    {6, {22, 51, 80, 109, 138, 167, 0}}, {6, {23, 52, 81, 110, 139, 168, 0}}, {6, {24, 53, 82, 111, 140, 169, 0}},
-    {6, {25, 54, 83, 112, 141, 170, 0}}, {6, {26, 55, 84, 113, 142, 171, 0}}, {6, {27, 56, 85, 114, 143, 172, 0}},
-    {6, {28, 57, 86, 115, 144, 173, 0}}, {6, {0, 1, 2, 3, 4, 5, 0}}, {6, {6, 7, 8, 9, 10, 11, 0}},
-    {6, {12, 13, 14, 15, 16, 17, 0}}, {6, {18, 19, 20, 21, 22, 23, 0}}, {6, {24, 25, 26, 27, 28, 29, 0}},
-    {6, {30, 31, 32, 33, 34, 35, 0}}, {6, {36, 37, 38, 39, 40, 41, 0}}, {6, {42, 43, 44, 45, 46, 47, 0}},
-    {6, {48, 49, 50, 51, 52, 53, 0}}, {6, {54, 55, 56, 57, 58, 59, 0}}, {6, {60, 61, 62, 63, 64, 65, 0}},
-    {6, {66, 67, 68, 69, 70, 71, 0}}, {6, {72, 73, 74, 75, 76, 77, 0}}, {6, {78, 79, 80, 81, 82, 83, 0}},
-    {6, {84, 85, 86, 87, 88, 89, 0}}, {6, {90, 91, 92, 93, 94, 95, 0}}, {6, {96, 97, 98, 99, 100, 101, 0}},
-    {6, {102, 103, 104, 105, 106, 107, 0}}, {6, {108, 109, 110, 111, 112, 113, 0}}, {6, {114, 115, 116, 117, 118, 119, 0}},
-    {6, {120, 121, 122, 123, 124, 125, 0}}, {6, {126, 127, 128, 129, 130, 131, 0}}, {6, {132, 133, 134, 135, 136, 137, 0}},
-    {6, {138, 139, 140, 141, 142, 143, 0}}, {6, {144, 145, 146, 147, 148, 149, 0}}, {6, {150, 151, 152, 153, 154, 155, 0}},
-    {6, {156, 157, 158, 159, 160, 161, 0}}
+constexpr std::array<CheckNode, M> Nm = {{
+    {6, { 0, 29, 59,  88, 117, 146,   0}}, {6, { 1, 30, 60,  89, 118, 146,   0}}, {6, { 2, 31, 61,  90, 119, 147, 0}},
+    {6, { 3, 32, 62,  91, 120, 148,   0}}, {6, { 1, 33, 63,  92, 121, 149,   0}}, {6, { 4, 32, 64,  93, 122, 147, 0}},
+    {6, { 5, 33, 65,  94, 123, 150,   0}}, {6, { 6, 34, 66,  95, 119, 151,   0}}, {6, { 7, 35, 67,  96, 124, 152, 0}},
+    {6, { 8, 36, 68,  97, 125, 151,   0}}, {6, { 9, 37, 69,  98, 126, 153,   0}}, {6, {10, 38, 70,  99, 125, 154, 0}},
+    {6, {11, 39, 60, 100, 127, 144,   0}}, {6, { 9, 32, 59,  94, 127, 155,   0}}, {6, {12, 40, 71,  96, 125, 156, 0}},
+    {6, {12, 41, 72,  89, 128, 155,   0}}, {6, {13, 38, 73,  98, 129, 157,   0}}, {6, {14, 42, 74, 101, 130, 158, 0}},
+    {6, {15, 42, 70, 102, 117, 159,   0}}, {6, {16, 43, 75,  97, 129, 155,   0}}, {6, {17, 44, 59,  95, 131, 160, 0}},
+    {6, {18, 45, 72,  82, 132, 161,   0}}, {6, {11, 37, 76, 101, 133, 162,   0}}, {6, {18, 46, 77, 103, 134, 146, 0}},
+    {6, { 0, 31, 76, 104, 135, 163,   0}}, {6, {19, 47, 72, 105, 122, 162,   0}}, {6, {20, 40, 78, 106, 136, 164, 0}},
+    {6, {21, 41, 65, 107, 137, 151,   0}}, {6, {17, 41, 79, 108, 138, 153,   0}}, {6, {22, 48, 80, 109, 134, 165, 0}},
+    {6, {15, 49, 81,  90, 128, 157,   0}}, {6,  {2, 47, 62, 106, 123, 166,   0}}, {6, { 5, 50, 66, 110, 133, 154, 0}},
+    {6, {23, 34, 76,  99, 121, 161,   0}}, {6, {19, 44, 75, 111, 139, 156,   0}}, {6, {20, 35, 63,  91, 129, 158, 0}},
+    {6, { 7, 51, 82, 110, 117, 165,   0}}, {6, {20, 52, 83, 112, 137, 167,   0}}, {6, {24, 50, 78,  88, 121, 157, 0}},
+    {7, {21, 43, 74, 106, 132, 154, 171}}, {6, { 8, 53, 83,  89, 140, 168,   0}}, {6, {21, 53, 84, 109, 135, 160, 0}},
+    {6, { 7, 36, 64, 101, 128, 169,   0}}, {6, {18, 38, 84, 113, 138, 149,   0}}, {6, {25, 54, 70,  92, 141, 166, 0}},
+    {7, {26, 55, 64,  95, 132, 159, 173}}, {6, {27, 30, 85,  99, 116, 170,   0}}, {6, {27, 51, 69, 103, 131, 143, 0}},
+    {6, {23, 56, 67,  94, 136, 141,   0}}, {6, {6,  29, 71, 109, 142, 150,   0}}, {6, { 3, 50, 75, 114, 126, 167, 0}},
+    {6, {15, 44, 86, 113, 124, 171,   0}}, {6, {14, 29, 85, 114, 122, 149,   0}}, {6, {22, 45, 63,  90, 143, 172, 0}},
+    {6, {22, 34, 74, 112, 144, 152,   0}}, {7, {13, 40, 86, 107, 116, 148, 169}}, {6, {24, 39, 84,  93, 123, 158, 0}},
+    {6, {24, 57, 68, 115, 142, 173,   0}}, {6, {28, 42, 60, 115, 131, 161,   0}}, {6, {14, 57, 87, 111, 120, 163, 0}},
+    {7, { 3, 58, 71, 113, 118, 162, 172}}, {6, {26, 46, 85,  97, 133, 152,   0}}, {5, { 4, 43, 77, 108, 140,   0, 0}},
+    {6, { 9, 45, 68, 102, 135, 164,   0}}, {6, { 8, 49, 58,  92, 127, 163,   0}}, {6, {13, 56, 57, 108, 119, 165, 0}},
+    {6, {16, 54, 61, 115, 124, 153,   0}}, {6, { 2, 53, 69, 100, 139, 169,   0}}, {6, { 0, 35, 81, 107, 126, 173, 0}},
+    {5, { 4, 52, 80, 104, 139,   0,   0}}, {6, {28, 52, 66,  98, 141, 172,   0}}, {6, {17, 48, 73,  96, 114, 166, 0}},
+    {6, { 1, 56, 62, 102, 137, 156,   0}}, {6, {25, 37, 78, 111, 134, 170,   0}}, {6, {10, 51, 65,  87, 118, 147, 0}},
+    {6, {19, 39, 67, 116, 140, 159,   0}}, {6, {10, 47, 80,  88, 145, 168,   0}}, {6, {28, 46, 79,  91, 145, 171, 0}},
+    {6, { 5, 31, 86, 103, 144, 168,   0}}, {6, {26, 33, 73, 105, 130, 164,   0}}, {5, {11, 55, 83,  87, 138,   0, 0}},
+    {6, {12, 55, 61, 110, 145, 170,   0}}, {6, {25, 36, 79, 104, 143, 150,   0}}, {6, {16, 30, 81, 112, 120, 160, 0}},
+    {5, {27, 48, 58,  93, 136,   0,   0}}, {6, { 6, 54, 82, 100, 130, 167,   0}}, {6, {23, 49, 77, 105, 142, 148, 0}}
 }};
 
+namespace {
+
+// The parity check graph as one flat edge list ordered by check, with the
+// reverse index of every edge precomputed so that neither decoder has to
+// search Mn for it
+struct EdgeTables {
+    int num_edges;
+    std::array<int, M + 1> check_start;             // First edge of each check
+    std::array<int16_t, M * BP_MAX_ROWS> edge_bit;  // Bit of each edge
+    std::array<std::array<int8_t, BP_MAX_ROWS>, M> bit_slot;  // k with Mn[bit][k] == check
+};
+
+constexpr EdgeTables build_edge_tables() {
+    EdgeTables tables{};
+    int edge = 0;
+
+    for (int i = 0; i < M; ++i) {
+        tables.check_start[i] = edge;
+        for (int j = 0; j < Nm[i].valid_neighbors; ++j) {
+            const int bit = Nm[i].neighbors[j];
+            tables.edge_bit[edge++] = static_cast<int16_t>(bit);
+
+            tables.bit_slot[i][j] = -1;
+            for (int k = 0; k < BP_MAX_CHECKS; ++k) {
+                if (Mn[bit][k] == i) tables.bit_slot[i][j] = static_cast<int8_t>(k);
+            }
+        }
+    }
+
+    tables.check_start[M] = edge;
+    tables.num_edges = edge;
+    return tables;
+}
+
+constexpr EdgeTables EDGE_TABLES = build_edge_tables();
+
+constexpr const EdgeTables& edge_tables() {
+    return EDGE_TABLES;
+}
+
+} // namespace
+
 int bpdecode174(const std::array<float, N>& llr,
                std::array<int8_t, K>& decoded,
-               std::array<int8_t, N>& cw)
+               std::array<int8_t, N>& cw,
+               int* iterations)
 {
-    // Initialize messages and variables
-    std::array<std::array<float, BP_MAX_CHECKS>, N> tov = {};     // Messages to variable nodes
-    std::array<std::array<float, BP_MAX_ROWS>, M> toc = {};       // Messages to check nodes
-    std::array<std::array<float, BP_MAX_ROWS>, M> tanhtoc = {};   // Tanh of messages
+    BPWorkspace work;
+    return bpdecode174(llr, decoded, cw, work, iterations);
+}
 
-    std::array<float, N> zn = {};   // Bit log likelihood ratios
-    std::array<int, M> synd = {};   // Syndrome for checks
+int bpdecode174(const std::array<float, N>& llr,
+               std::array<int8_t, K>& decoded,
+               std::array<int8_t, N>& cw,
+               BPWorkspace& work,
+               int* iterations)
+{
+    // Initialize messages and variables
+    auto& tov = work.tov;
+    auto& toc = work.toc;
+    auto& tanhtoc = work.tanhtoc;
+    auto& zn = work.zn;
+    auto& synd = work.synd;
+    tov = {};
+    toc = {};
 
     int ncnt = 0;
     int nclast = 0;
 
+    const EdgeTables& tables = edge_tables();
+
     // Initialize toc (messages from bits to checks)
     for (int i = 0; i < M; ++i) {
         for (int j = 0; j < Nm[i].valid_neighbors; ++j) {
@@ -97,6 +160,8 @@ int bpdecode174(const std::array<float, N>& llr,
 
     // Iterative decoding
     for (int iter = 0; iter <= BP_MAX_ITERATIONS; ++iter) {
+        if (iterations) *iterations = iter;
+
         // Update bit log likelihood ratios
         for (int i = 0; i < N; ++i) {
             zn[i] = llr[i] + std::accumulate(tov[i].begin(), tov[i].begin() + BP_MAX_CHECKS, 0.0f);
@@ -144,12 +209,9 @@ int bpdecode174(const std::array<float, N>& llr,
         for (int i = 0; i < M; ++i) {
             for (int j = 0; j < Nm[i].valid_neighbors; ++j) {
                 int ibj = Nm[i].neighbors[j];
+                int slot = tables.bit_slot[i][j];
                 toc[i][j] = zn[ibj];
-                for (int k = 0; k < BP_MAX_CHECKS; ++k) {
-                    if (Mn[ibj][k] == i) {
-                        toc[i][j] -= tov[ibj][k];
-                    }
-                }
+                if (slot >= 0) toc[i][j] -= tov[ibj][slot];
             }
         }
 
@@ -179,4 +241,155 @@ int bpdecode174(const std::array<float, N>& llr,
     return -1; // Decoding failed
 }
 
+namespace {
+
+// Fixed point scaling of the min-sum messages: quarter LLR units, with
+// check messages saturating at 127 (about 32 in LLR)
+constexpr float MS_SCALE = 4.0f;
+constexpr int MS_MAX_MESSAGE = 127;
+constexpr int MS_MAX_POSTERIOR = 32000;
+
+inline int clamp_message(int value, int limit) {
+    return value > limit ? limit : (value < -limit ? -limit : value);
+}
+
+} // namespace
+
+void minsum_decode174(const std::array<float, N>* const llr[],
+                      int count,
+                      std::array<int8_t, K>* const decoded[],
+                      std::array<int8_t, N>* const cw[],
+                      int nerr[],
+                      int iterations[]) {
+    MinSumWorkspace work;
+    minsum_decode174(llr, count, decoded, cw, nerr, work, iterations);
+}
+
+void minsum_decode174(const std::array<float, N>* const llr[],
+                      int count,
+                      std::array<int8_t, K>* const decoded[],
+                      std::array<int8_t, N>* const cw[],
+                      int nerr[],
+                      MinSumWorkspace& work,
+                      int iterations[]) {
+    constexpr int B = MS_BATCH;
+    const EdgeTables& tables = edge_tables();
+
+    // Posteriors and check messages, one lane per codeword. Internally LLRs
+    // are positive for a 0 bit, so check messages carry the product of the
+    // signs of the other bits.
+    auto& post = work.post;
+    auto& msg = work.msg;
+    bool done[B];
+
+    for (int lane = 0; lane < B; ++lane) {
+        done[lane] = lane >= count;
+        if (lane < count) nerr[lane] = -1;
+    }
+
+    for (int i = 0; i < N; ++i) {
+        for (int lane = 0; lane < B; ++lane) {
+            float value = lane < count ? -(*llr[lane])[i] * MS_SCALE : 0.0f;
+            post[i][lane] = static_cast<int16_t>(
+                clamp_message(static_cast<int>(std::lround(value)), MS_MAX_POSTERIOR));
+        }
+    }
+    std::fill(&msg[0][0], &msg[0][0] + tables.num_edges * B, int8_t{0});
+
+    for (int iter = 0; iter <= MS_MAX_ITERATIONS; ++iter) {
+        // Stop any lane whose hard decisions satisfy every check
+        int remaining = 0;
+        for (int lane = 0; lane < B; ++lane) {
+            if (done[lane]) continue;
+
+            bool valid = true;
+            for (int c = 0; c < M && valid; ++c) {
+                int parity = 0;
+                for (int e = tables.check_start[c]; e < tables.check_start[c + 1]; ++e) {
+                    parity ^= post[tables.edge_bit[e]][lane] < 0;
+                }
+                valid = parity == 0;
+            }
+
+            if (!valid) {
+                ++remaining;
+                continue;
+            }
+
+            auto& bits = *cw[lane];
+            int errors = 0;
+            for (int i = 0; i < N; ++i) {
+                bits[i] = post[i][lane] < 0 ? 1 : 0;
+                if ((2 * bits[i] - 1) * (*llr[lane])[i] < 0.0f) ++errors;
+            }
+            std::copy(bits.begin() + M, bits.end(), decoded[lane]->begin());
+            nerr[lane] = errors;
+            done[lane] = true;
+            if (iterations) iterations[lane] = iter;
+        }
+
+        if (remaining == 0 || iter == MS_MAX_ITERATIONS) break;
+
+        // One layer per check: remove its old messages from the posteriors,
+        // find the two smallest magnitudes and the overall sign, and fold
+        // the new scaled messages straight back in
+        for (int c = 0; c < M; ++c) {
+            const int first = tables.check_start[c];
+            const int degree = tables.check_start[c + 1] - first;
+
+            alignas(32) int16_t q[BP_MAX_ROWS][B];
+            alignas(32) int16_t min1[B];
+            alignas(32) int16_t min2[B];
+            alignas(32) int16_t min_index[B];
+            alignas(32) int16_t sign[B];
+
+            for (int lane = 0; lane < B; ++lane) {
+                min1[lane] = INT16_MAX;
+                min2[lane] = INT16_MAX;
+                min_index[lane] = 0;
+                sign[lane] = 0;
+            }
+
+            for (int j = 0; j < degree; ++j) {
+                const int16_t* p = post[tables.edge_bit[first + j]];
+                const int8_t* r = msg[first + j];
+                for (int lane = 0; lane < B; ++lane) {
+                    const int16_t value = static_cast<int16_t>(p[lane] - r[lane]);
+                    const int16_t magnitude = static_cast<int16_t>(value < 0 ? -value : value);
+                    q[j][lane] = value;
+                    sign[lane] ^= value < 0;
+                    const bool smallest = magnitude < min1[lane];
+                    min2[lane] = smallest ? min1[lane] : (magnitude < min2[lane] ? magnitude : min2[lane]);
+                    min1[lane] = smallest ? magnitude : min1[lane];
+                    min_index[lane] = smallest ? static_cast<int16_t>(j) : min_index[lane];
+                }
+            }
+
+            for (int j = 0; j < degree; ++j) {
+                int16_t* p = post[tables.edge_bit[first + j]];
+                int8_t* r = msg[first + j];
+                for (int lane = 0; lane < B; ++lane) {
+                    // Normalised by 3/4
+                    int magnitude = min_index[lane] == j ? min2[lane] : min1[lane];
+                    magnitude = std::min((magnitude * 3) >> 2, MS_MAX_MESSAGE);
+                    const bool negative = sign[lane] ^ (q[j][lane] < 0);
+                    const int message = negative ? -magnitude : magnitude;
+                    r[lane] = static_cast<int8_t>(message);
+                    p[lane] = static_cast<int16_t>(
+                        clamp_message(q[j][lane] + message, MS_MAX_POSTERIOR));
+                }
+            }
+        }
+    }
+
+    // Lanes that never converged keep nerr of -1 and their last decisions
+    for (int lane = 0; lane < count; ++lane) {
+        if (nerr[lane] >= 0) continue;
+        auto& bits = *cw[lane];
+        for (int i = 0; i < N; ++i) bits[i] = post[i][lane] < 0 ? 1 : 0;
+        std::copy(bits.begin() + M, bits.end(), decoded[lane]->begin());
+        if (iterations) iterations[lane] = MS_MAX_ITERATIONS;
+    }
+}
+
 } // namespace BPDSP
\ No newline at end of file
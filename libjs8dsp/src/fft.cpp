@@ -0,0 +1,38 @@
+/**
+ * FFT plan cache shared by every decoder in the process
+ *
+ * js8d project
+ */
+
+#include "../include/fft.h"
+
+namespace JS8DSP {
+
+FFTPlanManager& FFTPlanManager::instance() {
+    static FFTPlanManager manager;
+    return manager;
+}
+
+const FFTPlan& FFTPlanManager::get(size_t size, FFTKind kind, FFTDirection direction) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto& plan = plans_[Key{size, kind, direction}];
+    if (!plan) {
+        plan = std::make_unique<FFTPlan>(size, kind, direction);
+    }
+    return *plan;
+}
+
+size_t FFTPlanManager::good_size(size_t n) {
+    if (n <= 1) return 1;
+
+    for (;; ++n) {
+        size_t m = n;
+        for (size_t p : {2, 3, 5}) {
+            while (m % p == 0) m /= p;
+        }
+        if (m == 1) return n;
+    }
+}
+
+} // namespace JS8DSP
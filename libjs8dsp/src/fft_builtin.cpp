@@ -0,0 +1,297 @@
+/**
+ * Built-in FFT kernel, used when FFTW is not available
+ *
+ * Mixed-radix Stockham autosort transform with specialised radix 2, 3
+ * and 4 butterflies and a generic butterfly for other small primes.
+ * Twiddles are computed once at plan time. Real transforms of even
+ * length run as a half-length complex transform plus a split pass.
+ *
+ * js8d project
+ */
+
+#include "../include/fft.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace JS8DSP {
+
+namespace {
+
+// Largest prime factor handled by a butterfly; sizes with larger prime
+// factors fall back to a direct DFT
+constexpr int MAX_RADIX = 64;
+
+std::vector<int> factorize(size_t n) {
+    std::vector<int> factors;
+
+    while (n % 4 == 0) { factors.push_back(4); n /= 4; }
+    while (n % 2 == 0) { factors.push_back(2); n /= 2; }
+    for (size_t p = 3; p * p <= n; p += 2) {
+        while (n % p == 0) { factors.push_back(static_cast<int>(p)); n /= p; }
+    }
+    if (n > 1) factors.push_back(static_cast<int>(n));
+
+    return factors;
+}
+
+inline Complex rotate_quarter(Complex v, float sign) {
+    // Multiply by sign * i
+    return sign < 0.0f ? Complex(v.imag(), -v.real()) : Complex(-v.imag(), v.real());
+}
+
+} // namespace
+
+struct FFTPlan::Impl {
+    struct Stage {
+        int radix;
+        size_t span;            // Product of the radices of earlier stages
+        size_t twiddle_offset;  // Offset into twiddles, span * (radix - 1) entries
+        size_t root_offset;     // Offset into roots, radix entries
+    };
+
+    size_t n = 0;               // Complex transform length
+    float sign = -1.0f;
+    bool direct = false;
+    bool real_split = false;    // Real transform via half-length complex
+    bool real_padded = false;   // Odd-length real transform via full complex
+    std::vector<Stage> stages;
+    std::vector<Complex> twiddles;
+    std::vector<Complex> roots;
+    std::vector<Complex> split;  // exp(-2 pi i k / N) for the real split pass
+
+    void build(size_t length, float direction_sign) {
+        n = length;
+        sign = direction_sign;
+
+        auto factors = factorize(n);
+        if (!factors.empty() && factors.back() > MAX_RADIX) {
+            direct = true;
+            roots.resize(n);
+            for (size_t k = 0; k < n; ++k) {
+                roots[k] = std::polar(1.0f, static_cast<float>(sign * 2.0 * M_PI * k / n));
+            }
+            return;
+        }
+
+        size_t span = 1;
+        for (int radix : factors) {
+            Stage stage{radix, span, twiddles.size(), roots.size()};
+
+            for (size_t k = 0; k < span; ++k) {
+                for (int r = 1; r < radix; ++r) {
+                    double angle = sign * 2.0 * M_PI * static_cast<double>(k * r) / (span * radix);
+                    twiddles.emplace_back(static_cast<float>(std::cos(angle)),
+                                          static_cast<float>(std::sin(angle)));
+                }
+            }
+            for (int r = 0; r < radix; ++r) {
+                double angle = sign * 2.0 * M_PI * r / radix;
+                roots.emplace_back(static_cast<float>(std::cos(angle)),
+                                   static_cast<float>(std::sin(angle)));
+            }
+
+            stages.push_back(stage);
+            span *= radix;
+        }
+    }
+
+    void run_stage(const Stage& stage, const Complex* x, Complex* y) const {
+        const int radix = stage.radix;
+        const size_t span = stage.span;
+        const size_t m = n / radix;
+        const Complex* tw = twiddles.data() + stage.twiddle_offset;
+        const Complex* w = roots.data() + stage.root_offset;
+
+        Complex v[MAX_RADIX];
+        Complex t[MAX_RADIX];
+
+        for (size_t block = 0; block < m / span; ++block) {
+            for (size_t k = 0; k < span; ++k) {
+                const size_t j = block * span + k;
+
+                for (int r = 0; r < radix; ++r) v[r] = x[j + r * m];
+                if (span > 1) {
+                    const Complex* twk = tw + k * (radix - 1);
+                    for (int r = 1; r < radix; ++r) v[r] *= twk[r - 1];
+                }
+
+                switch (radix) {
+                    case 2: {
+                        Complex a = v[0];
+                        v[0] = a + v[1];
+                        v[1] = a - v[1];
+                        break;
+                    }
+                    case 3: {
+                        constexpr float S3 = 0.86602540378443864676f;
+                        Complex s = v[1] + v[2];
+                        Complex d = rotate_quarter(v[1] - v[2], sign) * S3;
+                        Complex c = v[0] - 0.5f * s;
+                        v[0] += s;
+                        v[1] = c + d;
+                        v[2] = c - d;
+                        break;
+                    }
+                    case 4: {
+                        Complex t0 = v[0] + v[2];
+                        Complex t1 = v[0] - v[2];
+                        Complex t2 = v[1] + v[3];
+                        Complex t3 = rotate_quarter(v[1] - v[3], sign);
+                        v[0] = t0 + t2;
+                        v[1] = t1 + t3;
+                        v[2] = t0 - t2;
+                        v[3] = t1 - t3;
+                        break;
+                    }
+                    default: {
+                        for (int q = 0; q < radix; ++q) {
+                            Complex sum = v[0];
+                            int index = 0;
+                            for (int r = 1; r < radix; ++r) {
+                                index += q;
+                                if (index >= radix) index -= radix;
+                                sum += v[r] * w[index];
+                            }
+                            t[q] = sum;
+                        }
+                        std::copy(t, t + radix, v);
+                        break;
+                    }
+                }
+
+                Complex* out = y + block * span * radix + k;
+                for (int r = 0; r < radix; ++r) out[r * span] = v[r];
+            }
+        }
+    }
+
+    // Complex transform of length n; work must hold n elements
+    void transform(const Complex* in, Complex* out, Complex* work) const {
+        if (n == 1) {
+            out[0] = in[0];
+            return;
+        }
+
+        if (direct) {
+            const Complex* src = in;
+            if (in == out) {
+                std::copy(in, in + n, work);
+                src = work;
+            }
+            for (size_t q = 0; q < n; ++q) {
+                Complex sum(0.0f, 0.0f);
+                size_t index = 0;
+                for (size_t r = 0; r < n; ++r) {
+                    sum += src[r] * roots[index];
+                    index += q;
+                    if (index >= n) index -= n;
+                }
+                out[q] = sum;
+            }
+            return;
+        }
+
+        const size_t count = stages.size();
+        const Complex* src = in;
+        Complex* dst;
+
+        if (in == out) {
+            // Ping-pong starting from a copy so the input is never
+            // overwritten while it is still being read
+            std::copy(in, in + n, work);
+            src = work;
+            for (size_t i = 0; i < count; ++i) {
+                dst = (i % 2 == 0) ? out : work;
+                run_stage(stages[i], src, dst);
+                src = dst;
+            }
+            if (src != out) std::copy(src, src + n, out);
+            return;
+        }
+
+        // Alternate so that the final stage lands in out
+        for (size_t i = 0; i < count; ++i) {
+            dst = ((count - 1 - i) % 2 == 0) ? out : work;
+            run_stage(stages[i], src, dst);
+            src = dst;
+        }
+    }
+};
+
+FFTPlan::FFTPlan(size_t size, FFTKind kind, FFTDirection direction)
+    : size_(size), kind_(kind), direction_(direction), impl_(std::make_unique<Impl>()) {
+
+    const float sign = (direction == FFTDirection::FORWARD) ? -1.0f : 1.0f;
+
+    if (kind == FFTKind::REAL && size >= 2 && size % 2 == 0) {
+        const size_t half = size / 2;
+        impl_->build(half, sign);
+        impl_->real_split = true;
+        impl_->split.resize(half + 1);
+        for (size_t k = 0; k <= half; ++k) {
+            impl_->split[k] = std::polar(1.0f, static_cast<float>(sign * 2.0 * M_PI * k / size));
+        }
+    } else {
+        impl_->build(std::max<size_t>(size, 1), sign);
+        impl_->real_padded = (kind == FFTKind::REAL);
+    }
+}
+
+FFTPlan::~FFTPlan() = default;
+
+size_t FFTPlan::workspace_size() const {
+    if (impl_->real_padded) return 3 * impl_->n;
+    return impl_->n;
+}
+
+void FFTPlan::execute(const Complex* in, Complex* out, Complex* work) const {
+    impl_->transform(in, out, work);
+}
+
+void FFTPlan::execute(const float* in, Complex* out, Complex* work) const {
+    const size_t n = impl_->n;
+
+    if (impl_->real_padded) {
+        for (size_t i = 0; i < n; ++i) work[i] = Complex(in[i], 0.0f);
+        impl_->transform(work, work + n, work + 2 * n);
+        std::copy(work + n, work + n + n / 2 + 1, out);
+        return;
+    }
+
+    // Pack even/odd samples as one half-length complex sequence
+    impl_->transform(reinterpret_cast<const Complex*>(in), out, work);
+
+    // Split the packed spectrum: X[k] = E[k] + W^k O[k], where
+    // E[k] = (Z[k] + conj(Z[h - k])) / 2 and O[k] = (Z[k] - conj(Z[h - k])) / 2i
+    const size_t half = n;
+    const Complex z0 = out[0];
+    const auto odd = [](Complex d) { return Complex(0.5f * d.imag(), -0.5f * d.real()); };
+
+    for (size_t k = 1; k <= half / 2; ++k) {
+        const size_t j = half - k;
+        const Complex zk = out[k];
+        const Complex zj = out[j];
+
+        const Complex ek = 0.5f * (zk + std::conj(zj));
+        const Complex ok = odd(zk - std::conj(zj));
+        const Complex ej = 0.5f * (zj + std::conj(zk));
+        const Complex oj = odd(zj - std::conj(zk));
+
+        out[k] = ek + impl_->split[k] * ok;
+        out[j] = ej + impl_->split[j] * oj;
+    }
+
+    out[0] = Complex(z0.real() + z0.imag(), 0.0f);
+    out[half] = Complex(z0.real() - z0.imag(), 0.0f);
+}
+
+std::string export_fft_wisdom() {
+    return std::string();
+}
+
+bool import_fft_wisdom(const std::string& wisdom) {
+    return wisdom.empty();
+}
+
+} // namespace JS8DSP
@@ -0,0 +1,127 @@
+/**
+ * FFTW backend for FFTPlan, used when FFTW3 (single precision) is found
+ *
+ * Plans are created once with the new-array execute interface, so a
+ * single plan can run on any caller buffer. FFTW requires matching
+ * alignment and in-place-ness, so each plan keeps an aligned and an
+ * unaligned variant of both in-place and out-of-place forms.
+ *
+ * js8d project
+ */
+
+#include "../include/fft.h"
+#include <fftw3.h>
+#include <cstdlib>
+#include <mutex>
+#include <stdexcept>
+
+namespace JS8DSP {
+
+namespace {
+
+// The FFTW planner is not thread safe
+std::mutex fftw_mutex;
+
+} // namespace
+
+struct FFTPlan::Impl {
+    // Indexed by [in_place][unaligned]
+    fftwf_plan plans[2][2] = {{nullptr, nullptr}, {nullptr, nullptr}};
+
+    ~Impl() {
+        std::lock_guard<std::mutex> lock(fftw_mutex);
+        for (auto& row : plans) {
+            for (auto& plan : row) {
+                if (plan) fftwf_destroy_plan(plan);
+            }
+        }
+    }
+
+    const fftwf_plan& select(const void* in, const void* out) const {
+        bool in_place = (in == out);
+        bool unaligned = fftwf_alignment_of(static_cast<float*>(const_cast<void*>(in))) != 0 ||
+                         fftwf_alignment_of(static_cast<float*>(const_cast<void*>(out))) != 0;
+        return plans[in_place][unaligned];
+    }
+};
+
+FFTPlan::FFTPlan(size_t size, FFTKind kind, FFTDirection direction)
+    : size_(size), kind_(kind), direction_(direction), impl_(std::make_unique<Impl>()) {
+
+    const int n = static_cast<int>(size);
+    const int sign = (direction == FFTDirection::FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
+
+    std::lock_guard<std::mutex> lock(fftw_mutex);
+
+    auto* a = fftwf_alloc_complex(size + 1);
+    auto* b = fftwf_alloc_complex(size + 1);
+    if (!a || !b) {
+        fftwf_free(a);
+        fftwf_free(b);
+        throw std::bad_alloc();
+    }
+
+    for (int in_place = 0; in_place < 2; ++in_place) {
+        for (int unaligned = 0; unaligned < 2; ++unaligned) {
+            unsigned flags = FFTW_ESTIMATE | (unaligned ? FFTW_UNALIGNED : 0);
+            fftwf_complex* out = in_place ? a : b;
+            fftwf_plan plan;
+
+            if (kind == FFTKind::COMPLEX) {
+                plan = fftwf_plan_dft_1d(n, a, out, sign, flags);
+            } else if (in_place) {
+                // Real transforms are only offered out of place
+                continue;
+            } else {
+                plan = fftwf_plan_dft_r2c_1d(n, reinterpret_cast<float*>(a), out, flags);
+            }
+
+            if (!plan) {
+                fftwf_free(a);
+                fftwf_free(b);
+                throw std::runtime_error("Failed to create FFT plan");
+            }
+            impl_->plans[in_place][unaligned] = plan;
+        }
+    }
+
+    fftwf_free(a);
+    fftwf_free(b);
+}
+
+FFTPlan::~FFTPlan() = default;
+
+size_t FFTPlan::workspace_size() const {
+    return 0;
+}
+
+void FFTPlan::execute(const Complex* in, Complex* out, Complex* /* work */) const {
+    auto* src = reinterpret_cast<fftwf_complex*>(const_cast<Complex*>(in));
+    auto* dst = reinterpret_cast<fftwf_complex*>(out);
+    fftwf_execute_dft(impl_->select(in, out), src, dst);
+}
+
+void FFTPlan::execute(const float* in, Complex* out, Complex* /* work */) const {
+    auto* src = const_cast<float*>(in);
+    auto* dst = reinterpret_cast<fftwf_complex*>(out);
+    fftwf_execute_dft_r2c(impl_->select(in, out), src, dst);
+}
+
+std::string export_fft_wisdom() {
+    std::lock_guard<std::mutex> lock(fftw_mutex);
+    char* text = fftwf_export_wisdom_to_string();
+    if (!text) return std::string();
+
+    std::string wisdom(text);
+    std::free(text);
+    return wisdom;
+}
+
+bool import_fft_wisdom(const std::string& wisdom) {
+    if (wisdom.empty()) return true;
+
+    std::lock_guard<std::mutex> lock(fftw_mutex);
+    return fftwf_import_wisdom_from_string(wisdom.c_str()) != 0;
+}
+
+} // namespace JS8DSP
@@ -0,0 +1,1119 @@
+/**
+ * JS8 frame packing and unpacking, from JS8Call's Varicode without Qt.
+ * The parsing regexes of the original are replaced by scanners that
+ * follow the same backtracking order, so they match the same text.
+ *
+ * Original: (C) 2018 Jordan Sherer <kn4crd@gmail.com>
+ */
+
+#include "../include/frame_codec.h"
+#include "../include/varicode.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+
+namespace JS8DSP {
+
+namespace {
+
+using std::string_view;
+constexpr size_t npos = string_view::npos;
+
+// Six-bit frame text alphabet; JS8Call's alphabet72 has three more
+// characters that no six-bit value reaches
+constexpr char ALPHABET72[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz-+";
+
+// Callsign and grid alphabet
+constexpr char ALPHANUMERIC[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ /@";
+
+template <size_t Size>
+constexpr std::array<int8_t, 128> index_table(const char (&alphabet)[Size]) {
+    std::array<int8_t, 128> table{};
+    for (auto& index : table) index = -1;
+    for (size_t i = 0; i + 1 < Size; ++i) table[static_cast<unsigned char>(alphabet[i])] = static_cast<int8_t>(i);
+    return table;
+}
+
+constexpr auto ALPHABET72_INDEX = index_table(ALPHABET72);
+constexpr auto ALPHANUMERIC_INDEX = index_table(ALPHANUMERIC);
+
+inline int alphanumeric_index(char c) {
+    const auto index = static_cast<unsigned char>(c);
+    return index < 128 ? ALPHANUMERIC_INDEX[index] : -1;
+}
+
+struct BaseCall {
+    string_view name;
+    uint32_t offset;    // Packed as NBASECALL + offset
+};
+
+constexpr BaseCall BASECALLS[] = {
+    {"<....>", 1},      // Incomplete callsign
+    {"@ALLCALL", 2},
+    {"@JS8NET", 3},
+    {"@DX/NA", 4},
+    {"@DX/SA", 5},
+    {"@DX/EU", 6},
+    {"@DX/AS", 7},
+    {"@DX/AF", 8},
+    {"@DX/OC", 9},
+    {"@DX/AN", 10},
+    {"@REGION/1", 11},
+    {"@REGION/2", 12},
+    {"@REGION/3", 13},
+    {"@GROUP/0", 14},
+    {"@GROUP/1", 15},
+    {"@GROUP/2", 16},
+    {"@GROUP/3", 17},
+    {"@GROUP/4", 18},
+    {"@GROUP/5", 19},
+    {"@GROUP/6", 20},
+    {"@GROUP/7", 21},
+    {"@GROUP/8", 22},
+    {"@GROUP/9", 23},
+    {"@COMMAND", 24},
+    {"@CONTROL", 25},
+    {"@NET", 26},
+    {"@NTS", 27},
+    {"@RESERVE/0", 28},
+    {"@RESERVE/1", 29},
+    {"@RESERVE/2", 30},
+    {"@RESERVE/3", 31},
+    {"@RESERVE/4", 32},
+    {"@APRSIS", 33},
+    {"@RAGCHEW", 34},
+    {"@JS8", 35},
+    {"@EMCOMM", 36},
+    {"@ARES", 37},
+    {"@MARS", 38},
+    {"@AMRRON", 39},
+    {"@RACES", 40},
+    {"@RAYNET", 41},
+    {"@RADAR", 42},
+    {"@SKYWARN", 43},
+    {"@CQ", 44},
+    {"@HB", 45},
+    {"@QSO", 46},
+    {"@QSOPARTY", 47},
+    {"@CONTEST", 48},
+    {"@FIELDDAY", 49},
+    {"@SOTA", 50},
+    {"@IOTA", 51},
+    {"@POTA", 52},
+    {"@QRP", 53},
+    {"@QRO", 54},
+};
+
+constexpr string_view INCOMPLETE_CALL = "<....>";
+
+const BaseCall* find_basecall(string_view name) {
+    for (const auto& call : BASECALLS) {
+        if (call.name == name) return &call;
+    }
+    return nullptr;
+}
+
+struct Command {
+    string_view text;
+    int code;
+};
+
+// Directed commands as typed, many-to-one onto their 5-bit codes
+constexpr Command COMMANDS[] = {
+    {" HEARTBEAT", -1},
+    {" HB", -1},
+    {" CQ", -1},
+    {" SNR?", 0},
+    {"?", 0},
+    {" DIT DIT", 1},
+    {" HEARING?", 3},
+    {" GRID?", 4},
+    {">", 5},
+    {" STATUS?", 6},
+    {" STATUS", 7},
+    {" HEARING", 8},
+    {" MSG", 9},
+    {" MSG TO:", 10},
+    {" QUERY", 11},
+    {" QUERY MSGS", 12},
+    {" QUERY MSGS?", 12},
+    {" QUERY CALL", 13},
+    {" GRID", 15},
+    {" INFO?", 16},
+    {" INFO", 17},
+    {" FB", 18},
+    {" HW CPY?", 19},
+    {" SK", 20},
+    {" RR", 21},
+    {" QSL?", 22},
+    {" QSL", 23},
+    {" CMD", 24},
+    {" SNR", 25},
+    {" NO", 26},
+    {" YES", 27},
+    {" 73", 28},
+    {" NACK", 2},
+    {" ACK", 14},
+    {" HEARTBEAT SNR", 29},
+    {" AGN?", 30},
+    {"  ", 31},
+    {" ", 31},
+};
+
+// Text each code unpacks to; the first in sort order of those above
+constexpr string_view COMMAND_TEXT[32] = {
+    " SNR?", " DIT DIT", " NACK", " HEARING?", " GRID?", ">", " STATUS?", " STATUS",
+    " HEARING", " MSG", " MSG TO:", " QUERY", " QUERY MSGS", " QUERY CALL", " ACK", " GRID",
+    " INFO?", " INFO", " FB", " HW CPY?", " SK", " RR", " QSL?", " QSL",
+    " CMD", " SNR", " NO", " YES", " 73", " HEARTBEAT SNR", " AGN?", " ",
+};
+
+constexpr int CMD_SNR = 25;
+constexpr int CMD_HEARTBEAT_SNR = 29;
+constexpr int CMD_NOT_FOUND = -2;
+
+int command_code(string_view text) {
+    for (const auto& command : COMMANDS) {
+        if (command.text == text) return command.code;
+    }
+    return CMD_NOT_FOUND;
+}
+
+string_view command_text(int code) {
+    return code >= 0 && code < 32 ? COMMAND_TEXT[code] : string_view();
+}
+
+inline bool is_snr_command(int code) {
+    return code == CMD_SNR || code == CMD_HEARTBEAT_SNR;
+}
+
+constexpr string_view CQS[] = {
+    "CQ CQ CQ", "CQ DX", "CQ QRP", "CQ CONTEST", "CQ FIELD", "CQ FD", "CQ CQ", "CQ",
+};
+
+// Character classes of the original patterns
+inline bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+inline bool is_digit(char c) { return c >= '0' && c <= '9'; }
+inline bool is_upper(char c) { return c >= 'A' && c <= 'Z'; }
+inline bool is_alnum(char c) { return is_digit(c) || is_upper(c); }
+inline bool is_word(char c) {
+    return is_alnum(c) || (c >= 'a' && c <= 'z') || c == '_';
+}
+inline bool is_call_char(char c) { return is_alnum(c) || c == '/'; }
+
+inline char to_upper(char c) {
+    return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+string_view trim(string_view text) {
+    while (!text.empty() && is_space(text.front())) text.remove_prefix(1);
+    while (!text.empty() && is_space(text.back())) text.remove_suffix(1);
+    return text;
+}
+
+inline bool starts_with(string_view text, size_t pos, string_view prefix) {
+    return pos <= text.size() && text.substr(pos, prefix.size()) == prefix;
+}
+
+// \b at pos
+bool word_boundary(string_view text, size_t pos) {
+    const bool before = pos > 0 && is_word(text[pos - 1]);
+    const bool after = pos < text.size() && is_word(text[pos]);
+    return before != after;
+}
+
+// [0-9][A-Z]|[A-Z][0-9] anywhere in text
+bool has_alnum_pair(string_view text) {
+    for (size_t i = 1; i < text.size(); ++i) {
+        if ((is_digit(text[i - 1]) && is_upper(text[i])) || (is_upper(text[i - 1]) && is_digit(text[i]))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// [A-R]{2}[0-9]{2} at pos
+bool scan_grid(string_view text, size_t pos) {
+    if (pos + 4 > text.size()) return false;
+    return text[pos] >= 'A' && text[pos] <= 'R' && text[pos + 1] >= 'A' && text[pos + 1] <= 'R' &&
+           is_digit(text[pos + 2]) && is_digit(text[pos + 3]);
+}
+
+// [@]?[A-Z0-9/]+ at pos; returns its end, or npos
+size_t scan_callsign(string_view text, size_t pos) {
+    size_t end = pos;
+    if (end < text.size() && text[end] == '@') ++end;
+    const size_t start = end;
+    while (end < text.size() && is_call_char(text[end])) ++end;
+    return end > start ? end : npos;
+}
+
+// The optional command group: \s? then the first of the commands that
+// matches, trying with the whitespace before without it
+size_t scan_command(string_view text, size_t pos) {
+    static constexpr string_view QUESTIONS[] = {
+        "AGN?", "QSL?", "HW CPY?", "MSG TO:", "SNR?", "INFO?", "GRID?", "STATUS?", "QUERY MSGS?", "HEARING?",
+    };
+    // Followed by a space or the end of text
+    static constexpr string_view WORDS[] = {
+        "STATUS", "HEARING", "QUERY CALL", "QUERY MSGS", "QUERY", "CMD", "MSG", "NACK", "ACK", "73", "YES",
+        "NO", "HEARTBEAT SNR", "SNR", "QSL", "RR", "SK", "FB", "INFO", "GRID", "DIT DIT",
+    };
+
+    auto command_at = [&](size_t p) -> size_t {
+        for (string_view question : QUESTIONS) {
+            if (starts_with(text, p, question)) return p + question.size();
+        }
+        for (string_view word : WORDS) {
+            const size_t end = p + word.size();
+            if (starts_with(text, p, word) && (end == text.size() || text[end] == ' ')) return end;
+        }
+        if (p < text.size() && (text[p] == '?' || text[p] == '>' || text[p] == ' ')) return p + 1;
+        return npos;
+    };
+
+    if (pos < text.size() && is_space(text[pos])) {
+        const size_t end = command_at(pos + 1);
+        if (end != npos) return end;
+    }
+    return command_at(pos);
+}
+
+// The optional number group: (?<=SNR)\s?[-+]?(?:3[01]|[0-2]?[0-9])
+size_t scan_number(string_view text, size_t pos) {
+    if (pos < 3 || text.substr(pos - 3, 3) != "SNR") return npos;
+
+    auto digits_at = [&](size_t p) -> size_t {
+        if (p >= text.size()) return npos;
+        const bool next_digit = p + 1 < text.size() && is_digit(text[p + 1]);
+        if (text[p] == '3' && p + 1 < text.size() && (text[p + 1] == '0' || text[p + 1] == '1')) return p + 2;
+        if (text[p] >= '0' && text[p] <= '2' && next_digit) return p + 2;
+        if (is_digit(text[p])) return p + 1;
+        return npos;
+    };
+    auto signed_at = [&](size_t p) -> size_t {
+        if (p < text.size() && (text[p] == '-' || text[p] == '+')) {
+            const size_t end = digits_at(p + 1);
+            if (end != npos) return end;
+        }
+        return digits_at(p);
+    };
+
+    if (pos < text.size() && is_space(text[pos])) {
+        const size_t end = signed_at(pos + 1);
+        if (end != npos) return end;
+    }
+    return signed_at(pos);
+}
+
+// Command and number after a callsign, as in the directed and compound
+// patterns
+struct CommandMatch {
+    string_view command;
+    string_view number;
+    size_t end;
+};
+
+CommandMatch scan_command_number(string_view text, size_t pos) {
+    CommandMatch match{{}, {}, pos};
+
+    const size_t command_end = scan_command(text, pos);
+    if (command_end != npos) {
+        match.command = text.substr(pos, command_end - pos);
+        match.end = command_end;
+    }
+
+    const size_t number_end = scan_number(text, match.end);
+    if (number_end != npos) {
+        match.number = text.substr(match.end, number_end - match.end);
+        match.end = number_end;
+    }
+    return match;
+}
+
+// \b(?<base>([0-9A-Z])?([0-9A-Z])([0-9])([A-Z])?([A-Z])?([A-Z])?)([/][P])?\b
+// matching all of callsign
+bool is_base_callsign(string_view callsign) {
+    string_view base = callsign;
+    if (base.size() > 2 && base.substr(base.size() - 2) == "/P") base.remove_suffix(2);
+
+    for (size_t digit = 1; digit <= 2; ++digit) {
+        if (base.size() <= digit || !is_digit(base[digit])) continue;
+
+        bool matches = base.size() - digit - 1 <= 3;
+        for (size_t i = 0; matches && i < digit; ++i) matches = is_alnum(base[i]);
+        for (size_t i = digit + 1; matches && i < base.size(); ++i) matches = is_upper(base[i]);
+        if (matches) return true;
+    }
+    return false;
+}
+
+// ^(?:[@]?|\b)([A-Z0-9/@][A-Z0-9/]{0,2}[/]?[A-Z0-9/]{0,3}[/]?[A-Z0-9/]{0,3})\b
+// matching all of callsign; quantifiers are tried greedily, in order, so
+// the match found is the one the regex would find
+bool is_compound_pattern(string_view callsign) {
+    const size_t size = callsign.size();
+    auto run = [&](size_t p, size_t most) {
+        size_t n = 0;
+        while (n < most && p + n < size && is_call_char(callsign[p + n])) ++n;
+        return n;
+    };
+    auto slash = [&](size_t p) { return p < size && callsign[p] == '/'; };
+
+    const bool at = size > 0 && callsign[0] == '@';
+    for (size_t start = at ? 1 : 0;; --start) {
+        if (start < size && (is_call_char(callsign[start]) || callsign[start] == '@')) {
+            const size_t p0 = start + 1;
+            for (size_t a = run(p0, 2) + 1; a-- > 0;) {
+                for (int s1 = 1; s1 >= 0; --s1) {
+                    if (s1 && !slash(p0 + a)) continue;
+                    const size_t p1 = p0 + a + s1;
+                    for (size_t b = run(p1, 3) + 1; b-- > 0;) {
+                        for (int s2 = 1; s2 >= 0; --s2) {
+                            if (s2 && !slash(p1 + b)) continue;
+                            const size_t p2 = p1 + b + s2;
+                            for (size_t c = run(p2, 3) + 1; c-- > 0;) {
+                                if (word_boundary(callsign, p2 + c)) return p2 + c == size;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        if (start == 0) break;
+    }
+    return false;
+}
+
+bool is_valid_compound(string_view callsign) {
+    size_t slashes = 0;
+    for (char c : callsign) slashes += c == '/';
+    if (callsign.size() - slashes > 9) return false;
+
+    const size_t slash = callsign.find('/');
+    if (slash != npos) return find_basecall(callsign.substr(0, slash)) == nullptr;
+
+    if (!callsign.empty() && callsign[0] == '@') return true;
+    return callsign.size() > 2 && has_alnum_pair(callsign);
+}
+
+// A short string in a fixed buffer
+template <size_t Capacity>
+struct ShortText {
+    std::array<char, Capacity> data;
+    size_t size = 0;
+
+    void push(char c) {
+        if (size < Capacity) data[size++] = c;
+    }
+    void push(string_view text) {
+        for (char c : text) push(c);
+    }
+    string_view view() const { return string_view(data.data(), size); }
+};
+
+// Appends to a caller's NUL-terminated buffer, remembering overflow
+class TextOut {
+public:
+    TextOut(char* out, size_t size) : out_(out), size_(size), length_(0), overflow_(size == 0) {}
+
+    void put(char c) {
+        if (length_ + 1 < size_) {
+            out_[length_++] = c;
+        } else {
+            overflow_ = true;
+        }
+    }
+    void put(string_view text) {
+        for (char c : text) put(c);
+    }
+
+    int finish() {
+        if (overflow_) {
+            if (size_ > 0) out_[0] = '\0';
+            return -1;
+        }
+        out_[length_] = '\0';
+        return static_cast<int>(length_);
+    }
+
+private:
+    char* out_;
+    size_t size_;
+    size_t length_;
+    bool overflow_;
+};
+
+// Frame bits written in order, first bit most significant
+class FrameWriter {
+public:
+    void put(uint64_t bits, int count) {
+        for (int i = count - 1; i >= 0; --i, ++position_) {
+            const uint64_t bit = (bits >> i) & 1;
+            if (position_ < 64) {
+                frame_.value |= bit << (63 - position_);
+            } else {
+                frame_.rem = static_cast<uint8_t>(frame_.rem | bit << (71 - position_));
+            }
+        }
+    }
+    int position() const { return position_; }
+    Frame72 frame() const { return frame_; }
+
+private:
+    Frame72 frame_{0, 0};
+    int position_ = 0;
+};
+
+inline int frame_bit(Frame72 frame, int position) {
+    return position < 64 ? static_cast<int>((frame.value >> (63 - position)) & 1)
+                         : (frame.rem >> (71 - position)) & 1;
+}
+
+// Number to a directed command value between 1 and 62, 0 if empty
+uint8_t pack_number(string_view number) {
+    number = trim(number);
+    if (number.empty()) return 0;
+
+    int sign = 1;
+    size_t i = 0;
+    if (number[0] == '-' || number[0] == '+') {
+        sign = number[0] == '-' ? -1 : 1;
+        ++i;
+    }
+    int value = 0;
+    for (; i < number.size() && is_digit(number[i]); ++i) value = value * 10 + (number[i] - '0');
+    value = std::max(-30, std::min(sign * value, 31));
+    return static_cast<uint8_t>(value + 30 + 1);
+}
+
+// A reduced command and number in the grid values above NUSERGRID
+uint8_t pack_command(int code, uint8_t number) {
+    if (is_snr_command(code)) {
+        // [1][X][6]: X is 0 for SNR, 1 for HEARTBEAT SNR
+        return static_cast<uint8_t>(((1 << 1) | (code == CMD_HEARTBEAT_SNR)) << 6 | (number & 0x3f));
+    }
+    return static_cast<uint8_t>(code & 0x7f);
+}
+
+int unpack_command(uint8_t value, uint8_t& number) {
+    if (value & (1 << 7)) {
+        number = value & 0x3f;
+        return value & (1 << 6) ? CMD_HEARTBEAT_SNR : CMD_SNR;
+    }
+    number = 0;
+    return value & 0x7f;
+}
+
+void put_snr(TextOut& out, int snr) {
+    if (snr < -60 || snr > 60) return;
+    char text[8];
+    snprintf(text, sizeof(text), "%+03d", snr);
+    out.put(text);
+}
+
+void put_number(TextOut& out, int value) {
+    char text[16];
+    snprintf(text, sizeof(text), "%d", value);
+    out.put(text);
+}
+
+// [3][50][11],[5][3]
+bool pack_compound_frame(string_view callsign, FrameType type, uint16_t num, uint8_t bits3, Frame72& frame) {
+    if (type == FRAME_DATA || type == FRAME_DIRECTED) return false;
+
+    const uint64_t packed_callsign = pack_alphanumeric50(callsign);
+    if (packed_callsign == 0) return false;
+
+    FrameWriter writer;
+    writer.put(type, 3);
+    writer.put(packed_callsign, 50);
+    writer.put(num >> 5, 11);
+    writer.put(num & 0x1f, 5);
+    writer.put(bits3, 3);
+    frame = writer.frame();
+    return true;
+}
+
+struct CompoundFrame {
+    uint64_t callsign;
+    uint16_t num;
+    uint8_t bits3;
+};
+
+CompoundFrame unpack_compound_frame(Frame72 frame) {
+    CompoundFrame unpacked;
+    unpacked.callsign = (frame.value >> 11) & ((uint64_t(1) << 50) - 1);
+    unpacked.num = static_cast<uint16_t>((frame.value & 0x7ff) << 5 | frame.rem >> 3);
+    unpacked.bits3 = frame.rem & 0x7;
+    return unpacked;
+}
+
+int unpack_heartbeat(Frame72 frame, TextOut& out) {
+    const CompoundFrame unpacked = unpack_compound_frame(frame);
+
+    char callsign[16];
+    char grid[8];
+    unpack_alphanumeric50(unpacked.callsign, callsign, sizeof(callsign));
+    unpack_grid(unpacked.num & NMAXGRID, grid, sizeof(grid));
+
+    out.put(callsign);
+    if (unpacked.num & (1 << 15)) {
+        out.put(": @ALLCALL ");
+        out.put(CQS[unpacked.bits3]);
+    } else {
+        // The heartbeat flags in bits3 are deprecated and all show as HB
+        out.put(": @HB HEARTBEAT");
+    }
+    if (grid[0]) {
+        out.put(' ');
+        out.put(grid);
+    }
+    return out.finish();
+}
+
+int unpack_compound(Frame72 frame, FrameType type, TextOut& out) {
+    const CompoundFrame unpacked = unpack_compound_frame(frame);
+
+    char callsign[16];
+    unpack_alphanumeric50(unpacked.callsign, callsign, sizeof(callsign));
+    out.put(callsign);
+    if (type == FRAME_COMPOUND) out.put(':');
+
+    if (unpacked.num <= NBASEGRID) {
+        char grid[8];
+        unpack_grid(unpacked.num, grid, sizeof(grid));
+        out.put(' ');
+        out.put(grid);
+    } else if (NUSERGRID <= unpacked.num && unpacked.num < NMAXGRID) {
+        // Values above the user grids carry a command
+        uint8_t number = 0;
+        const int code = unpack_command(static_cast<uint8_t>(unpacked.num - NUSERGRID), number);
+        out.put(command_text(code));
+        if (is_snr_command(code)) {
+            out.put(' ');
+            put_snr(out, number - 31);
+        }
+    }
+    return out.finish();
+}
+
+// [3][28][28][5],[1][1][6]
+int unpack_directed(Frame72 frame, TextOut& out) {
+    const uint32_t packed_from = static_cast<uint32_t>((frame.value >> 33) & ((1u << 28) - 1));
+    const uint32_t packed_to = static_cast<uint32_t>((frame.value >> 5) & ((1u << 28) - 1));
+    const int code = static_cast<int>(frame.value & 0x1f);
+    const bool portable_from = (frame.rem >> 7) & 1;
+    const bool portable_to = (frame.rem >> 6) & 1;
+    const int number = frame.rem & 0x3f;
+
+    char from[16];
+    char to[16];
+    if (unpack_callsign(packed_from, portable_from, from, sizeof(from)) < 0 ||
+        unpack_callsign(packed_to, portable_to, to, sizeof(to)) < 0) {
+        return -1;
+    }
+
+    out.put(from);
+    out.put(": ");
+    out.put(to);
+    out.put(command_text(code));
+    if (number != 0) {
+        out.put(' ');
+        if (is_snr_command(code)) {
+            put_snr(out, number - 31);
+        } else {
+            put_number(out, number - 31);
+        }
+    }
+    return out.finish();
+}
+
+// [1][0][Huffman coded text][0][1...]
+int unpack_data(Frame72 frame, TextOut& out, char* text, size_t size) {
+    // The data ends at the last 0 bit, the padding after it all 1s
+    int end = 71;
+    while (end > 1 && frame_bit(frame, end)) --end;
+    if (end == 1) end = 72;
+
+    // Realign the data to start at the first byte
+    std::array<uint8_t, 9> bits{};
+    for (int i = 2; i < end; ++i) {
+        bits[(i - 2) >> 3] = static_cast<uint8_t>(bits[(i - 2) >> 3] | frame_bit(frame, i) << (7 - ((i - 2) & 7)));
+    }
+
+    if (varicode_decode_packed(bits.data(), end - 2, text, size) < 0) return -1;
+    out.put(text);
+    return out.finish();
+}
+
+} // namespace
+
+void pack72(Frame72 frame, char* text) {
+    for (int i = 0; i < static_cast<int>(FRAME_TEXT_LENGTH); ++i) {
+        int value = 0;
+        for (int bit = 0; bit < 6; ++bit) value = value << 1 | frame_bit(frame, i * 6 + bit);
+        text[i] = ALPHABET72[value];
+    }
+}
+
+bool unpack72(string_view text, Frame72& frame) {
+    if (text.size() < FRAME_TEXT_LENGTH) return false;
+
+    FrameWriter writer;
+    for (size_t i = 0; i < FRAME_TEXT_LENGTH; ++i) {
+        const auto c = static_cast<unsigned char>(text[i]);
+        const int value = c < 128 ? ALPHABET72_INDEX[c] : -1;
+        if (value < 0) return false;
+        writer.put(static_cast<uint64_t>(value), 6);
+    }
+    frame = writer.frame();
+    return true;
+}
+
+FrameType frame_type(Frame72 frame) {
+    const int type = static_cast<int>(frame.value >> 61);
+    if (type & 4) return type & 2 ? FRAME_DATA_COMPRESSED : FRAME_DATA;
+    return static_cast<FrameType>(type);
+}
+
+// [39][38][38][2][38][38][38][2][38][38][38]
+uint64_t pack_alphanumeric50(string_view value) {
+    ShortText<11> word;
+    for (char c : value) {
+        if (alphanumeric_index(c) >= 0) word.push(c);
+    }
+
+    auto insert_space = [&word](size_t at) {
+        if (word.size > at && word.data[at] != '/') {
+            if (word.size < word.data.size()) ++word.size;
+            for (size_t i = word.size - 1; i > at; --i) word.data[i] = word.data[i - 1];
+            word.data[at] = ' ';
+        }
+    };
+    insert_space(3);
+    insert_space(7);
+    while (word.size < 11) word.push(' ');
+
+    uint64_t packed = 0;
+    for (size_t i = 0; i < 11; ++i) {
+        if (i == 3 || i == 7) {
+            packed = packed * 2 + (word.data[i] == '/');
+        } else {
+            packed = packed * 38 + static_cast<uint64_t>(alphanumeric_index(word.data[i]));
+        }
+    }
+    return packed;
+}
+
+int unpack_alphanumeric50(uint64_t packed, char* out, size_t size) {
+    char word[11];
+    for (int i = 10; i >= 0; --i) {
+        if (i == 3 || i == 7) {
+            word[i] = packed % 2 ? '/' : ' ';
+            packed /= 2;
+        } else {
+            const uint64_t radix = i == 0 ? 39 : 38;
+            word[i] = ALPHANUMERIC[packed % radix];
+            packed /= radix;
+        }
+    }
+
+    TextOut text(out, size);
+    for (char c : word) {
+        if (c != ' ') text.put(c);
+    }
+    return text.finish();
+}
+
+uint32_t pack_callsign(string_view value, bool& portable) {
+    portable = false;
+
+    value = trim(value);
+    if (value.size() > 16) return 0;
+
+    ShortText<16> upper;
+    for (char c : value) upper.push(to_upper(c));
+    string_view callsign = upper.view();
+
+    if (const BaseCall* call = find_basecall(callsign)) return NBASECALL + call->offset;
+
+    if (callsign.size() >= 2 && callsign.substr(callsign.size() - 2) == "/P") {
+        callsign.remove_suffix(2);
+        portable = true;
+    }
+
+    // Swaziland and Guinea prefixes rewritten to fit the pattern
+    ShortText<16> rewritten;
+    if (callsign.substr(0, 4) == "3DA0") {
+        rewritten.push("3D0");
+        rewritten.push(callsign.substr(4));
+        callsign = rewritten.view();
+    } else if (callsign.size() > 2 && callsign.substr(0, 2) == "3X" && is_upper(callsign[2])) {
+        rewritten.push('Q');
+        rewritten.push(callsign.substr(2));
+        callsign = rewritten.view();
+    }
+
+    const size_t length = callsign.size();
+    if (length < 2 || length > 6) return 0;
+
+    // Space padded to six, the last matching
+    // ([0-9A-Z ])([0-9A-Z])([0-9])([A-Z ])([A-Z ])([A-Z ]) is packed
+    auto matches = [](const char* p) {
+        return (is_alnum(p[0]) || p[0] == ' ') && is_alnum(p[1]) && is_digit(p[2]) &&
+               (is_upper(p[3]) || p[3] == ' ') && (is_upper(p[4]) || p[4] == ' ') && (is_upper(p[5]) || p[5] == ' ');
+    };
+
+    char matched[6];
+    bool found = false;
+    auto try_padding = [&](int before) {
+        char candidate[6];
+        for (int i = 0; i < 6; ++i) {
+            const int at = i - before;
+            candidate[i] = at >= 0 && at < static_cast<int>(length) ? callsign[at] : ' ';
+        }
+        if (matches(candidate)) {
+            std::copy(candidate, candidate + 6, matched);
+            found = true;
+        }
+    };
+
+    if (length == 6) {
+        try_padding(0);
+    } else {
+        try_padding(1);
+        if (length >= 3) try_padding(0);
+    }
+    if (!found) return 0;
+
+    uint32_t packed = static_cast<uint32_t>(alphanumeric_index(matched[0]));
+    packed = 36 * packed + static_cast<uint32_t>(alphanumeric_index(matched[1]));
+    packed = 10 * packed + static_cast<uint32_t>(alphanumeric_index(matched[2]));
+    packed = 27 * packed + static_cast<uint32_t>(alphanumeric_index(matched[3]) - 10);
+    packed = 27 * packed + static_cast<uint32_t>(alphanumeric_index(matched[4]) - 10);
+    packed = 27 * packed + static_cast<uint32_t>(alphanumeric_index(matched[5]) - 10);
+    return packed;
+}
+
+int unpack_callsign(uint32_t packed, bool portable, char* out, size_t size) {
+    TextOut text(out, size);
+
+    if (packed > NBASECALL) {
+        for (const auto& call : BASECALLS) {
+            if (NBASECALL + call.offset == packed) {
+                text.put(call.name);
+                return text.finish();
+            }
+        }
+    }
+    if (packed >= NBASECALL) return -1;
+
+    char word[6];
+    word[5] = ALPHANUMERIC[packed % 27 + 10];
+    packed /= 27;
+    word[4] = ALPHANUMERIC[packed % 27 + 10];
+    packed /= 27;
+    word[3] = ALPHANUMERIC[packed % 27 + 10];
+    packed /= 27;
+    word[2] = ALPHANUMERIC[packed % 10];
+    packed /= 10;
+    word[1] = ALPHANUMERIC[packed % 36];
+    packed /= 36;
+    word[0] = ALPHANUMERIC[packed];
+
+    ShortText<8> callsign;
+    string_view raw(word, 6);
+    if (raw.substr(0, 3) == "3D0") {
+        callsign.push("3DA0");
+        callsign.push(raw.substr(3));
+    } else if (raw[0] == 'Q' && is_upper(raw[1])) {
+        callsign.push("3X");
+        callsign.push(raw.substr(1));
+    } else {
+        callsign.push(raw);
+    }
+
+    text.put(trim(callsign.view()));
+    if (portable) text.put("/P");
+    return text.finish();
+}
+
+uint16_t pack_grid(string_view value) {
+    const string_view grid = trim(value);
+    if (grid.size() < 4) return NMAXGRID;
+
+    // Centre of the square, as Varicode::grid2deg with subsquare "mm"
+    const char g0 = to_upper(grid[0]);
+    const char g1 = to_upper(grid[1]);
+    const char g2 = to_upper(grid[2]);
+    const char g3 = to_upper(grid[3]);
+
+    const int nlong = 180 - 20 * (g0 - 'A');
+    const int n20d = 2 * (g2 - '0');
+    const float xminlong = 5 * ('m' - 'a' + 0.5);
+    const float dlong = nlong - n20d - xminlong / 60.0;
+
+    const int nlat = -90 + 10 * (g1 - 'A') + g3 - '0';
+    const float xminlat = 2.5 * ('m' - 'a' + 0.5);
+    const float dlat = nlat + xminlat / 60.0;
+
+    const int ilong = static_cast<int>(dlong);
+    const int ilat = static_cast<int>(dlat + 90);
+    return static_cast<uint16_t>(((ilong + 180) / 2) * 180 + ilat);
+}
+
+int unpack_grid(uint16_t packed, char* out, size_t size) {
+    TextOut text(out, size);
+    if (packed > NBASEGRID) return text.finish();
+
+    float dlat = packed % 180 - 90;
+    float dlong = packed / 180 * 2 - 180 + 2;
+
+    // Varicode::deg2grid, field and square only
+    if (dlong < -180) dlong += 360;
+    if (dlong > 180) dlong -= 360;
+
+    const int nlong = static_cast<int>(60.0 * (180.0 - dlong) / 5);
+    const int nlat = static_cast<int>(60.0 * (dlat + 90) / 2.5);
+
+    text.put(static_cast<char>('A' + nlong / 240));
+    text.put(static_cast<char>('A' + nlat / 240));
+    text.put(static_cast<char>('0' + (nlong - 240 * (nlong / 240)) / 24));
+    text.put(static_cast<char>('0' + (nlat - 240 * (nlat / 240)) / 24));
+    return text.finish();
+}
+
+bool is_valid_callsign(string_view callsign, bool* compound) {
+    if (compound) *compound = false;
+
+    if (find_basecall(callsign)) return true;
+
+    if (is_base_callsign(callsign)) {
+        return callsign.size() > 2 && has_alnum_pair(callsign);
+    }
+
+    if (is_compound_pattern(callsign)) {
+        const bool valid = is_valid_compound(callsign);
+        if (compound) *compound = valid;
+        return valid;
+    }
+    return false;
+}
+
+bool is_compound_callsign(string_view callsign) {
+    if (find_basecall(callsign) && (callsign.empty() || callsign[0] != '@')) return false;
+    if (is_base_callsign(callsign)) return false;
+    if (!is_compound_pattern(callsign)) return false;
+    return is_valid_compound(callsign);
+}
+
+int pack_heartbeat(string_view text, string_view callsign, Frame72& frame) {
+    static constexpr string_view TYPES[] = {
+        "CQ CQ CQ", "CQ DX", "CQ QRP", "CQ CONTEST", "CQ FIELD", "CQ FD", "CQ CQ", "CQ", "HB", "HEARTBEAT",
+    };
+
+    if (callsign.empty()) return 0;
+
+    // ^\s*([@](?:ALLCALL|HB)\s+)?
+    size_t pos = 0;
+    while (pos < text.size() && is_space(text[pos])) ++pos;
+    for (string_view group : {string_view("@ALLCALL"), string_view("@HB")}) {
+        size_t end = pos + group.size();
+        if (!starts_with(text, pos, group) || end >= text.size() || !is_space(text[end])) continue;
+        while (end < text.size() && is_space(text[end])) ++end;
+        pos = end;
+        break;
+    }
+
+    // Type, then an optional grid, then \b
+    for (size_t i = 0; i < std::size(TYPES); ++i) {
+        const string_view type = TYPES[i];
+        if (!starts_with(text, pos, type)) continue;
+
+        size_t end = pos + type.size();
+        if (type == "HEARTBEAT") {
+            size_t next = end;
+            while (next < text.size() && is_space(text[next])) ++next;
+            if (next > end && starts_with(text, next, "SNR")) continue;
+        }
+
+        uint16_t extra = NMAXGRID;
+        if (end < text.size() && is_space(text[end]) && scan_grid(text, end + 1) && word_boundary(text, end + 5)) {
+            extra = pack_grid(text.substr(end + 1, 4));
+            end += 5;
+        } else if (!word_boundary(text, end)) {
+            continue;
+        }
+
+        // Heartbeats set the alt flag for CQs, with the CQ type in bits3
+        uint8_t bits3 = 0;
+        if (i < std::size(CQS)) {
+            extra |= 1 << 15;
+            bits3 = static_cast<uint8_t>(i);
+        }
+
+        if (!pack_compound_frame(callsign, FRAME_HEARTBEAT, extra, bits3, frame)) return 0;
+        return static_cast<int>(end);
+    }
+    return 0;
+}
+
+int pack_compound(string_view text, Frame72& frame) {
+    // ^\s*[`](?<callsign>...)(?<grid>\s?[A-R]{2}[0-9]{2})?(?<cmd>...)?(?<num>...)?
+    size_t pos = 0;
+    while (pos < text.size() && is_space(text[pos])) ++pos;
+    if (pos >= text.size() || text[pos] != '`') return 0;
+
+    const size_t callsign_start = pos + 1;
+    const size_t callsign_end = scan_callsign(text, callsign_start);
+    if (callsign_end == npos) return 0;
+    const string_view callsign = text.substr(callsign_start, callsign_end - callsign_start);
+
+    // The callsign takes any grid not set apart by whitespace
+    string_view grid;
+    pos = callsign_end;
+    if (pos < text.size() && is_space(text[pos]) && scan_grid(text, pos + 1)) {
+        grid = text.substr(pos + 1, 4);
+        pos += 5;
+    }
+
+    const CommandMatch match = scan_command_number(text, pos);
+
+    FrameType type = FRAME_COMPOUND;
+    uint16_t extra = NMAXGRID;
+    const int code = match.command.empty() ? CMD_NOT_FOUND : command_code(match.command);
+    if (code != CMD_NOT_FOUND) {
+        extra = static_cast<uint16_t>(NUSERGRID + pack_command(code, pack_number(match.number)));
+        type = FRAME_COMPOUND_DIRECTED;
+    } else if (!grid.empty()) {
+        extra = pack_grid(grid);
+    }
+
+    if (!pack_compound_frame(callsign, type, extra, 0, frame)) return 0;
+    return static_cast<int>(match.end);
+}
+
+int pack_directed(string_view text, string_view mycall, Frame72& frame) {
+    // ^(?<callsign>...)(?<cmd>...)?(?<num>...)?
+    const size_t callsign_end = scan_callsign(text, 0);
+    if (callsign_end == npos) return 0;
+
+    string_view to = text.substr(0, callsign_end);
+    const CommandMatch match = scan_command_number(text, callsign_end);
+    if (match.command.empty()) return 0;
+
+    // Compound callsigns go in a compound frame of their own, leaving the
+    // placeholder here
+    const string_view from = is_compound_callsign(mycall) ? INCOMPLETE_CALL : mycall;
+
+    bool to_compound = false;
+    if (to == mycall || !is_valid_callsign(to, &to_compound)) return 0;
+    if (to_compound) to = INCOMPLETE_CALL;
+
+    int code = command_code(match.command);
+    const int trimmed_code = command_code(trim(match.command));
+    if (trimmed_code != CMD_NOT_FOUND) code = trimmed_code;
+    if (code == CMD_NOT_FOUND) return 0;
+
+    bool portable_from = false;
+    bool portable_to = false;
+    const uint32_t packed_from = pack_callsign(from, portable_from);
+    const uint32_t packed_to = pack_callsign(to, portable_to);
+    if (packed_from == 0 || packed_to == 0) return 0;
+
+    // [3][28][28][5],[1][1][6]
+    FrameWriter writer;
+    writer.put(FRAME_DIRECTED, 3);
+    writer.put(packed_from, 28);
+    writer.put(packed_to, 28);
+    writer.put(static_cast<uint64_t>(code) % 32, 5);
+    writer.put(portable_from, 1);
+    writer.put(portable_to, 1);
+    writer.put(pack_number(match.number), 6);
+    frame = writer.frame();
+    return static_cast<int>(match.end);
+}
+
+int pack_data(string_view text, Frame72& frame) {
+    // Only texts entirely in the Huffman alphabet
+    for (char c : text) {
+        if (varicode_code(c).length == 0) return 0;
+    }
+
+    // [1][0], data flag and uncompressed, then whole characters leaving
+    // at least one bit for padding
+    FrameWriter writer;
+    writer.put(0b10, 2);
+
+    int packed = 0;
+    for (char c : text) {
+        const VaricodeCode code = varicode_code(c);
+        if (writer.position() + code.length >= 72) break;
+        writer.put(code.bits, code.length);
+        ++packed;
+    }
+    if (packed == 0) return 0;
+
+    // Pad with a 0 then 1s, so the data ends at the last 0
+    writer.put(0, 1);
+    while (writer.position() < 72) writer.put(1, 1);
+
+    frame = writer.frame();
+    return packed;
+}
+
+int pack_message(string_view text, string_view mycall, Frame72& frame, FrameType& type) {
+    int packed = pack_heartbeat(text, mycall, frame);
+    if (packed > 0) {
+        type = FRAME_HEARTBEAT;
+        return packed;
+    }
+
+    packed = pack_compound(text, frame);
+    if (packed > 0) {
+        type = frame_type(frame);
+        return packed;
+    }
+
+    packed = pack_directed(text, mycall, frame);
+    if (packed > 0) {
+        type = FRAME_DIRECTED;
+        return packed;
+    }
+
+    packed = pack_data(text, frame);
+    type = packed > 0 ? FRAME_DATA : FRAME_UNKNOWN;
+    return packed;
+}
+
+int unpack_message(Frame72 frame, int transmission, char* out, size_t size, FrameType& type) {
+    TextOut text(out, size);
+
+    // Flagged data frames have no type bits and are always dense coded
+    if (transmission & TRANSMISSION_DATA) {
+        type = FRAME_DATA_COMPRESSED;
+        return -1;
+    }
+
+    type = frame_type(frame);
+    switch (type) {
+    case FRAME_HEARTBEAT:
+        return unpack_heartbeat(frame, text);
+    case FRAME_COMPOUND:
+    case FRAME_COMPOUND_DIRECTED:
+        return unpack_compound(frame, type, text);
+    case FRAME_DIRECTED:
+        return unpack_directed(frame, text);
+    case FRAME_DATA: {
+        char data[FRAME_TEXT_LENGTH * 6 + 1];
+        return unpack_data(frame, text, data, sizeof(data));
+    }
+    default:
+        return -1;
+    }
+}
+
+} // namespace JS8DSP
@@ -9,15 +9,33 @@
 #include "../include/js8_decoder.h"
 #include "../include/js8_constants.h"
 #include "../include/bp_decoder.h"
+#include "../include/osd_decoder.h"
 #include "../include/baseline_computation.h"
+#include "../include/fft.h"
+#include "../include/thread_pool.h"
+#include "../include/thread_policy.h"
+#include "../include/resampler.h"
+#include "../include/sample_convert.h"
+#include "../include/sync_kernels.h"
+#include "../include/frame_codec.h"
+#include "../include/mode_tables.h"
+#include "../include/arena.h"
+#include "../include/js8_encoder.h"
+#include "../include/state_blob.h"
+#include <cerrno>
 #include <cmath>
 #include <vector>
 #include <complex>
 #include <algorithm>
 #include <cstring>
+#include <cstdint>
 #include <array>
-
-// FFT is now handled by Go layer, no C++ FFT needed
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
 
 // Use std containers instead of Qt
 using std::vector;
@@ -36,179 +54,935 @@ struct DecodedMessage {
     int confidence;
 };
 
+// OSD fallback state shared by every submode's decoder: the time OSD may
+// take per decode pass, summed over workers, how much of it the current
+// pass has spent, and what it has done. Workers update it concurrently.
+struct OsdBudget {
+    int64_t budget_ns = 0;                 // 0 disables OSD
+    std::atomic<int64_t> spent_ns{0};
+    std::atomic<uint32_t> attempts{0};
+    std::atomic<uint32_t> decoded{0};
+    std::atomic<uint32_t> skipped{0};      // Qualified but over budget
+};
+
+using Clock = std::chrono::steady_clock;
+
+// Candidates one decoder may queue over every round of a decode pass:
+// those selected from the slot, and those revisited once decoded signals
+// are subtracted
+constexpr int MAX_SLOT_CANDIDATES = 2 * NMAXCAND;
+
+// Decode metrics shared by every submode's decoder. Whichever thread does
+// some work counts it into the current pass with relaxed atomics, so
+// timing costs little more than the clock reads; the pass is folded into
+// the last pass and totals once it is finished. Any thread may read them.
+struct DecodeMetrics {
+    struct Counters {
+        array<std::atomic<uint64_t>, JS8DSP_STAGE_COUNT> stage_ns{};
+        std::atomic<uint64_t> found{0};
+        std::atomic<uint64_t> attempted{0};
+        std::atomic<uint64_t> decoded{0};
+        std::atomic<uint64_t> suppressed{0};
+        std::atomic<uint64_t> skipped{0};
+        std::atomic<uint64_t> rounds{0};        // After the first
+        std::atomic<uint64_t> subtracted{0};
+    };
+
+    Counters pass;
+    Counters last;
+    Counters total;
+    std::atomic<uint64_t> passes{0};
+    array<std::atomic<uint64_t>, JS8DSP_LDPC_ITERATION_BINS> ldpc_iterations{};
+    std::atomic<uint64_t> ldpc_failures{0};
+    std::atomic<uint64_t> allocations{0};
+
+    // Decode arenas: bytes reserved by all of them, and the most any one
+    // held in the last pass and in any pass
+    std::atomic<uint64_t> arena_bytes{0};
+    std::atomic<uint64_t> last_arena_peak{0};
+    std::atomic<uint64_t> arena_peak{0};
+
+    // Wall clock time of the recent passes, from their start until their
+    // results were ready, in a ring indexed by pass number, and the
+    // longest of any pass
+    array<std::atomic<uint64_t>, JS8DSP_LATENCY_WINDOW> latency_ns{};
+    std::atomic<uint64_t> max_latency_ns{0};
+
+    // Decoder memory locked in RAM
+    std::atomic<uint64_t> locked_bytes{0};
+
+    // Charge the time since start to a stage; returns the time now, which
+    // starts the next stage
+    Clock::time_point charge(js8dsp_stage_t stage, Clock::time_point start) {
+        const auto now = Clock::now();
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count();
+        pass.stage_ns[stage].fetch_add(static_cast<uint64_t>(elapsed), std::memory_order_relaxed);
+        return now;
+    }
+
+    static void add(std::atomic<uint64_t>& counter, uint64_t value) {
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    // One LDPC run and its outcome
+    void add_ldpc(int nharderrors, int iterations) {
+        if (nharderrors < 0) {
+            add(ldpc_failures, 1);
+        } else {
+            add(ldpc_iterations[std::clamp(iterations, 0, JS8DSP_LDPC_ITERATION_BINS - 1)], 1);
+        }
+    }
+
+    // Arena use of the pass; called by the pass's thread once its workers are done
+    void add_arena(uint64_t peak, uint64_t reserved) {
+        arena_bytes.store(reserved, std::memory_order_relaxed);
+        last_arena_peak.store(peak, std::memory_order_relaxed);
+        if (peak > arena_peak.load(std::memory_order_relaxed)) {
+            arena_peak.store(peak, std::memory_order_relaxed);
+        }
+    }
+
+    // Time the pass took; called by the pass's thread before finish_pass()
+    void add_latency(Clock::duration elapsed) {
+        const uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        latency_ns[passes.load(std::memory_order_relaxed) % JS8DSP_LATENCY_WINDOW].store(ns, std::memory_order_relaxed);
+        if (ns > max_latency_ns.load(std::memory_order_relaxed)) {
+            max_latency_ns.store(ns, std::memory_order_relaxed);
+        }
+    }
+
+    void finish_pass() {
+        auto fold = [](std::atomic<uint64_t>& current, std::atomic<uint64_t>& previous,
+                       std::atomic<uint64_t>& sum) {
+            const uint64_t value = current.exchange(0, std::memory_order_relaxed);
+            previous.store(value, std::memory_order_relaxed);
+            add(sum, value);
+        };
+
+        for (int stage = 0; stage < JS8DSP_STAGE_COUNT; ++stage) {
+            fold(pass.stage_ns[stage], last.stage_ns[stage], total.stage_ns[stage]);
+        }
+        fold(pass.found, last.found, total.found);
+        fold(pass.attempted, last.attempted, total.attempted);
+        fold(pass.decoded, last.decoded, total.decoded);
+        fold(pass.suppressed, last.suppressed, total.suppressed);
+        fold(pass.skipped, last.skipped, total.skipped);
+        fold(pass.rounds, last.rounds, total.rounds);
+        fold(pass.subtracted, last.subtracted, total.subtracted);
+        add(passes, 1);
+    }
+};
+
+// What a decoder carries over to a later process: its noise floor fit,
+// the frequencies it seeds its next pass with, and its decode cache, the
+// cache's times as ages on its clock
+struct DecoderState {
+    static constexpr int CACHE_SIZE = 64;
+
+    struct Decode {
+        float freq;
+        uint64_t age;                       // 12 kHz samples since the message start
+        uint32_t hash;
+        array<int8_t, BPDSP::K> bits;
+    };
+
+    bool has_fit;
+    BaselineComputation::Fit fit;
+    int seed_count;
+    array<float, CACHE_SIZE> seeds;
+    int decode_count;
+    array<Decode, CACHE_SIZE> decodes;      // Oldest first
+};
+
+/**
+ * Decoder of one submode on one receiver channel. Implemented by
+ * DecodeMode<Mode> below, which fixes the mode's symbol length and
+ * transform sizes at compile time; make_decoder() picks the
+ * implementation once, when the decoder is created, and the rest of the
+ * pipeline only sees this interface.
+ */
 class JS8Decoder {
+public:
+    virtual ~JS8Decoder() = default;
+
+    virtual Mode mode() const = 0;
+    virtual int channel() const = 0;
+
+    // Number of 12 kHz samples in one transmission period
+    virtual size_t input_samples() const = 0;
+
+    // Load one period of 12 kHz audio, search it for candidates and compute
+    // the baseband spectrum they are downsampled from; returns the number
+    // of candidates. time places the audio on the decode cache's clock.
+    virtual int prepare(const float* samples, size_t count, uint64_t time) = 0;
+
+    // Start a streaming slot at the given 12 kHz stream position
+    virtual void stream_reset(uint64_t slot_start) = 0;
+
+    // Stream position at which the current slot is complete
+    virtual uint64_t slot_end() const = 0;
+
+    // Position and length of the last prepared or finished slot
+    virtual uint64_t slot_start() const = 0;
+    virtual size_t slot_samples() const = 0;
+
+    // Accumulate every symbol spectrum frame that is complete once the
+    // stream has reached position written. ring holds the most recent
+    // ring_mask + 1 samples, indexed by stream position & ring_mask.
+    virtual void stream_advance(const float* ring, size_t ring_mask, uint64_t written) = 0;
+
+    // Finish the current streaming slot once slot_end() has been reached:
+    // pick candidates from the accumulated spectra and compute the baseband
+    // spectrum; returns the number of candidates, as for prepare()
+    virtual int stream_finish(const float* ring, size_t ring_mask) = 0;
+
+    // Decode count consecutive candidates found by prepare(), at most
+    // batch_size(), with the given worker's scratch; their LDPC decoding
+    // is batched. Bit metrics and LDPC messages are taken from the
+    // worker's arena and given back before returning. Safe to call
+    // concurrently for different candidates.
+    virtual void decode(int first, int count, size_t worker, Arena& arena) = 0;
+
+    // Candidates worth decoding together with the selected LDPC decoder
+    virtual int batch_size() const = 0;
+
+    virtual int candidate_count() const = 0;
+
+    // First candidate of the current decode round; those before it were
+    // decoded by earlier rounds of the pass
+    virtual int round_start() const = 0;
+
+    // Candidates of the round that lead a cluster, which are its first
+    // head_count()
+    virtual int head_count() const = 0;
+
+    // Once the heads are decoded, drop the neighbours within the tones of
+    // a decoded head; returns the new candidate count
+    virtual int prune_neighbours() = 0;
+
+    // Subtract the signals the current round decoded from the baseband
+    // spectrum, with the given worker's scratch, and start another round
+    // over the candidates whose bands they overlapped; returns the number
+    // of candidates queued, 0 if the round decoded nothing
+    virtual int next_round(size_t worker) = 0;
+
+    virtual bool has_result(int cand) const = 0;
+    virtual const js8dsp_decoded_message_t& result(int cand) const = 0;
+    virtual float candidate_freq(int cand) const = 0;
+    virtual float candidate_snr(int cand) const = 0;
+    virtual float candidate_sync(int cand) const = 0;
+
+    // Time of the candidate's best sync relative to the nominal start of
+    // transmission, in seconds
+    virtual float candidate_dt(int cand) const = 0;
+
+    // Allocate scratch space for the given number of concurrent workers
+    virtual void set_workers(size_t workers) = 0;
+
+    // Lock, or unlock, the decoder, its buffers and its mode's tables in RAM
+    virtual void lock_memory(MemoryLock& lock) const = 0;
+
+    virtual void set_threshold(float threshold) = 0;
+    virtual float get_threshold() const = 0;
+    virtual void set_ldpc_decoder(js8dsp_ldpc_t ldpc) = 0;
+
+    // Hash of a decoded candidate's message bits, 0 if it was not decoded
+    virtual uint32_t result_hash(int cand) const = 0;
+
+    virtual void set_cache_enabled(bool enabled) = 0;
+
+    // Forget the cached decodes, whose times no longer line up when the
+    // cache's clock restarts; their seeds are kept
+    virtual void clear_cache() = 0;
+
+    // Forget the previous pass's seeds before its results are remembered
+    virtual void clear_seeds() = 0;
+
+    // Take, or restore, the state a later process can continue from; now
+    // is the time on the cache's clock
+    virtual void save_state(DecoderState& state, uint64_t now) const = 0;
+    virtual void restore_state(const DecoderState& state, uint64_t now) = 0;
+
+    // Remember a decode reported by the last pass
+    virtual void remember(int cand) = 0;
+
+    // Share the owner's OSD budget, or nullptr to never run OSD
+    virtual void set_osd_budget(OsdBudget* osd) = 0;
+
+    // Write the power spectrum of the latest symbol frame and the baseline
+    // of the latest slot in a checked layout; returns the frames computed,
+    // 0 if none and nothing was written. Safe to call from any thread.
+    virtual uint64_t read_spectrum(const js8dsp_spectrum_layout_t& layout, void* power, void* baseline) const = 0;
+};
+
+template <Mode MODE>
+class DecodeMode final : public JS8Decoder {
 private:
-    int sample_rate_;
-    Mode js8_mode_;
-    ModeParams mode_params_;
+    // The mode's parameters and every size derived from them are known at
+    // compile time, so the loops over symbols, spectra and transforms have
+    // fixed trip counts
+    static constexpr ModeParams PARAMS = getModeParams(MODE);
+    static constexpr int NSPS = PARAMS.nsps;
+    static constexpr int NDOWNSPS = PARAMS.ndownsps;
+
+    // One transmission period of 12 kHz samples; anything beyond that in
+    // a single call is ignored
+    static constexpr size_t NMAX = static_cast<size_t>(JS8_RX_SAMPLE_RATE) * PARAMS.ntxdur;
+
+    // Symbol spectra; NFFT1 = 2 * nsps point real transforms of the 12 kHz
+    // signal, stepped by a quarter symbol and averaged into spectrum_
+    static constexpr int NFFT1 = NSPS * NFOS;
+    static constexpr int NSTEP = NSPS / NSSY;
+    static constexpr int NHSYM = static_cast<int>(NMAX) / NSTEP - 3;
+
+    // Baseband spectrum of the whole slot; NDFFT1 = nsps * ndd point real
+    // transform computed once per decode, from which each candidate is
+    // downsampled by a short NDFFT2 = NDFFT1 / NDOWN point inverse transform
+    static constexpr int NDFFT1 = NSPS * PARAMS.ndd;
+    static constexpr int NDFFT2 = NDFFT1 / (NSPS / NDOWNSPS);
+    static_assert(NDFFT2 > NN * NDOWNSPS, "a downsampled slot must hold a whole frame");
+
+    // The downsampled rate, at which decoded signals are reconstructed
+    static constexpr int DOWNSAMPLED_RATE = JS8_RX_SAMPLE_RATE * NDOWNSPS / NSPS;
+    static_assert(DOWNSAMPLED_RATE * NSPS == JS8_RX_SAMPLE_RATE * NDOWNSPS, "downsampling must be by a whole factor");
+
+    // The sync search steps a quarter symbol over every offset at which a
+    // whole frame fits in the downsampled slot
+    static constexpr int SYNC_STEP = std::max(1, NDOWNSPS / 4);
+    static constexpr int SYNC_TIMES = (NDFFT2 - NN * NDOWNSPS) / SYNC_STEP + 1;
+
+    int channel_;                  // Receiver channel results are tagged with
     float decode_threshold_;
 
-    // Signal processing buffers
-    vector<complex<float>> input_buffer_;
-    vector<complex<float>> downsampled_;
-    vector<float> spectrum_;
+    // Signal processing buffers. Those sized by the mode alone are fixed
+    // arrays, so the decoder and its buffers are a single allocation; the
+    // rest are sized once in the constructor. A steady decode cycle never
+    // allocates.
+    array<float, std::max(NMAX, static_cast<size_t>(NDFFT1))> dd_;  // Input resampled to 12 kHz, zero padded to NDFFT1
+    size_t dd_count_;
+    vector<float> spectrum_;       // Vectors, as BaselineComputation takes them
     vector<float> baseline_;
-    array<float, NMAXCAND> candidate_freqs_;
-    array<float, NMAXCAND> candidate_snrs_;
+
+    const FFTPlan* spectrum_plan_;
+    array<float, NFFT1> frame_;
+    array<complex<float>, NFFT1 / 2 + 1> frame_fft_;
+    vector<complex<float>> fft_work_;
+
+    const FFTPlan* baseband_plan_;
+    const FFTPlan* downsample_plan_;
+    const FFTPlan* reconstruct_plan_;   // Forward NDFFT2, back to baseband bins
+    GfskModulator reference_;           // Decoded signals at the downsampled rate
+    array<complex<float>, NDFFT1 / 2 + 1> baseband_;
+    // Candidates in rounds; within each, cluster heads first and then
+    // their neighbours, each strongest first
+    array<float, MAX_SLOT_CANDIDATES> candidate_freqs_;
+    array<float, MAX_SLOT_CANDIDATES> candidate_snrs_;
+    array<int, NMAXCAND> rank_;
+    int num_heads_;                     // Of the current round
+
+    // Decode rounds. Every candidate selected from the slot is kept, in
+    // selection order, for the rounds after the first to revisit.
+    array<float, NMAXCAND> selected_freqs_;
+    array<float, NMAXCAND> selected_snrs_;
+    int selected_count_;
+    int round_;                         // Of the pass, from 1
+    int round_start_;
+
+    // Candidates stand this many dB above the baseline
+    static constexpr float CANDIDATE_MIN_SNR = 3.0f;
+
+    // Candidates closer than this to a stronger one are in its cluster;
+    // NFSRCH Hz in the normal mode, scaled to the tone spacing of the others
+    static constexpr float CLUSTER_TOLERANCE = NFSRCH * static_cast<float>(JS8A_SYMBOL_SAMPLES) / NSPS;
+
+    // Bit metrics and LDPC output of one candidate; a batch of candidates
+    // is demodulated into lanes, allocated from the worker's arena for
+    // the batch, and then LDPC decoded together
+    struct DecodeLane {
+        int cand = 0;
+        float freq = 0.0f;                  // Refined by the sync search
+        float sync = 0.0f;
+        array<float, BPDSP::N> llr;         // Bit metrics from magnitudes (bmeta)
+        array<float, BPDSP::N> llr_log;     // Bit metrics from log magnitudes (bmetb)
+        array<int8_t, BPDSP::K> decoded_bits;
+        array<int8_t, BPDSP::N> codeword;
+        int nharderrors = -1;               // Of the accepted pass, or -1
+    };
+
+    // Per-candidate decode scratch; one set per worker so that candidates
+    // can be decoded concurrently
+    struct CandidateScratch {
+        array<complex<float>, NDFFT2> downsampled;
+        array<float, NDFFT2> downsampled_re;    // Struct-of-arrays copy of downsampled
+        array<float, NDFFT2> downsampled_im;
+        vector<complex<float>> fft_work;
+        array<float, SYNC_TIMES * SYNC_SHIFTS> sync_map;  // Time offset x frequency shift
+        array<array<float, NN>, 8> symbol_powers;  // Tone x symbol magnitudes (s2)
+        array<complex<float>, NN * NDOWNSPS> reference;  // Of a signal being subtracted
+    };
+
+    vector<CandidateScratch> scratch_;
+    js8dsp_ldpc_t ldpc_;
+
+    // Ordered statistics fallback; only tried on candidates with strong
+    // sync and confident bit metrics that belief propagation missed
+    static constexpr float OSD_MIN_SYNC = 2.5f;
+    static constexpr float OSD_MIN_MEAN_LLR = 2.4f;
+    static constexpr int OSD_MAX_HARD_ERRORS = 26;
+    OsdBudget* osd_;
+
+    // Owned by the MultiModeDecoder, with every other submode's decoder
+    DecodeMetrics& metrics_;
+
+    // Decode cache. Messages reported by recent passes are remembered with
+    // the stream time they started at, so that another pass over the same
+    // slot neither LDPC decodes nor reports them again; the strongest also
+    // seed the candidates of the next pass at their frequencies.
+    struct CacheEntry {
+        float freq;
+        uint64_t time;                      // 12 kHz stream position of the message start
+        uint32_t hash;                      // Of the message bits
+        array<int8_t, BPDSP::K> bits;
+    };
+
+    static constexpr int CACHE_SIZE = DecoderState::CACHE_SIZE;
+    static constexpr float CACHE_FREQ_TOLERANCE = 0.5f;  // Baud
+    static constexpr int A_PRIORI_MAX_ERRORS = 10;       // Of the K message bits
+    static constexpr float SEED_MIN_SYNC = 4.0f;
+    bool cache_enabled_;
+    array<CacheEntry, CACHE_SIZE> cache_;
+    int cache_count_;
+    int cache_next_;
+    array<float, CACHE_SIZE> seeds_;
+    int seed_count_;
+    uint64_t pass_time_;                    // Stream time of the slot being decoded
+    array<uint32_t, MAX_SLOT_CANDIDATES> result_hashes_;             // 0 unless decoded
+
+    // Message each candidate was found to carry, whether reported or
+    // already cached, at its refined frequency; 0 if none. These are the
+    // signals a further round subtracts.
+    array<uint32_t, MAX_SLOT_CANDIDATES> signal_hashes_;
+    array<float, MAX_SLOT_CANDIDATES> signal_freqs_;
+    array<array<int8_t, BPDSP::K>, MAX_SLOT_CANDIDATES> signal_bits_;
+
+    // Per-candidate results of the last prepared slot
+    int num_candidates_;
+    array<js8dsp_decoded_message_t, MAX_SLOT_CANDIDATES> results_;
+    array<bool, MAX_SLOT_CANDIDATES> result_valid_;
+    array<float, MAX_SLOT_CANDIDATES> candidate_syncs_;    // Best Costas sync found
+    array<int, MAX_SLOT_CANDIDATES> candidate_offsets_;    // Downsampled offset of best sync
+
+    // Streaming state; symbol spectra are accumulated frame by frame as
+    // audio arrives, relative to the stream position the slot started at
+    uint64_t slot_start_;
+    int frames_done_;
 
     // Advanced baseline computation
     BaselineComputation baseline_computer_;
 
-    // Costas synchronization arrays
-    array<array<array<complex<float>, 32>, 7>, 3> costas_templates_;
+    // Waterfall view: the power spectrum of the latest symbol frame and
+    // the baseline of the latest slot, copied out under the lock once per
+    // batch of frames for readers on other threads
+    uint64_t frames_computed_;
+    mutable std::mutex view_mutex_;
+    array<float, NSPS> view_power_;
+    array<float, NSPS> view_baseline_;
+    uint64_t view_frames_;
+
+    // Compile-time tables shared by every decoder of this mode
+    const ModeTables& tables_;
+    CorrelateFn correlate_;
+
+    // Offset of a tone's template at the given frequency shift
+    size_t tone_offset(int tone, int shift) const {
+        return static_cast<size_t>(tone * SYNC_SHIFTS + shift) * NDOWNSPS;
+    }
 
-    // FFT is handled by Go layer
+    void init_scratch(CandidateScratch& scratch) const {
+        scratch.fft_work.resize(std::max(downsample_plan_->workspace_size(),
+                                         reconstruct_plan_->workspace_size()));
+    }
 
-    // Initialize Costas synchronization templates
-    void init_costas_templates() {
-        const int (*costas_array)[7] = (mode_params_.costas == CostasType::ORIGINAL)
-                                       ? COSTAS_ORIGINAL : COSTAS_MODIFIED;
+    // Forward transform of the whole slot, shared by all candidates
+    void compute_baseband_fft() {
+        const auto start = Clock::now();
+        std::fill(dd_.begin() + dd_count_, dd_.end(), 0.0f);
+        baseband_plan_->execute(dd_.data(), baseband_.data(), fft_work_.data());
+        metrics_.charge(JS8DSP_STAGE_FFT, start);
+    }
 
-        for (int i = 0; i < 3; ++i) {
-            for (int j = 0; j < 7; ++j) {
-                int tone = costas_array[i][j];
-                // Generate complex exponential for each tone
-                for (int k = 0; k < mode_params_.ndownsps; ++k) {
-                    float phase = 2.0f * M_PI * tone * k / 8.0f; // 8-FSK
-                    costas_templates_[i][j][k] = complex<float>(cos(phase), sin(phase));
-                }
-            }
-        }
+    // Baseband bins of the band a candidate is downsampled from, 1.5 baud
+    // below to 8.5 baud above its frequency, and of the frequency itself
+    struct Band {
+        int center;
+        int bottom;
+        int top;
+    };
+
+    static Band band_bins(float center_freq) {
+        constexpr float df = static_cast<float>(JS8_RX_SAMPLE_RATE) / NDFFT1;
+        constexpr float baud = static_cast<float>(JS8_RX_SAMPLE_RATE) / NSPS;
+
+        const float ft = center_freq + 8.5f * baud;
+        const float fb = center_freq - 1.5f * baud;
+        return {static_cast<int>(std::round(center_freq / df)),
+                std::max(0, static_cast<int>(std::round(fb / df))),
+                std::min(static_cast<int>(std::round(ft / df)), NDFFT1 / 2)};
     }
 
-    // Downsample and filter input signal
-    void downsample_signal(const float* audio_buffer, size_t buffer_size, float center_freq) {
-        // Clear previous data
-        downsampled_.clear();
+    // Extract the band from 1.5 baud below to 8.5 baud above the candidate
+    // frequency from the baseband spectrum, taper its edges, shift the
+    // candidate to DC and inverse transform at the downsampled rate
+    void downsample_signal(float center_freq, CandidateScratch& scratch) const {
+        const auto [i0, ib, it] = band_bins(center_freq);
 
-        int downsample_factor = mode_params_.nsps / mode_params_.ndownsps;
-        float freq_offset = center_freq - (sample_rate_ / 2.0f);
+        const size_t taper_size = tables_.taper_head.size();
+        const size_t range_size = it - ib + 1;
 
-        // Apply frequency shift and downsample
-        for (size_t i = 0; i < buffer_size; i += downsample_factor) {
-            if (i >= buffer_size) break;
+        auto& cd = scratch.downsampled;
 
-            // Frequency shift
-            float phase = 2.0f * M_PI * freq_offset * i / sample_rate_;
-            complex<float> shift = complex<float>(cos(phase), sin(phase));
-            complex<float> sample = complex<float>(audio_buffer[i], 0.0f) * shift;
+        std::fill(cd.begin(), cd.end(), complex<float>(0.0f, 0.0f));
+        std::copy(baseband_.begin() + ib, baseband_.begin() + ib + range_size, cd.begin());
 
-            downsampled_.push_back(sample);
+        auto head = cd.begin();
+        auto tail = cd.begin() + range_size;
+        std::transform(head, head + taper_size, tables_.taper_head.begin(), head, std::multiplies<>());
+        std::transform(tail - taper_size, tail, tables_.taper_tail.begin(), tail - taper_size, std::multiplies<>());
+
+        std::rotate(cd.begin(), cd.begin() + (i0 - ib), cd.end());
+
+        downsample_plan_->execute(cd.data(), cd.data(), scratch.fft_work.data());
+
+        // Scale and split into I/Q arrays for the correlation kernels
+        const float factor = 1.0f / std::sqrt(static_cast<float>(NDFFT1) * NDFFT2);
+        for (int i = 0; i < NDFFT2; ++i) {
+            scratch.downsampled_re[i] = cd[i].real() * factor;
+            scratch.downsampled_im[i] = cd[i].imag() * factor;
         }
     }
 
-    // Costas array synchronization
-    float sync_costas(int symbol_start, float /* freq_offset */) {
-        float total_sync = 0.0f;
+    // Remove a decoded signal from the baseband spectrum, so that the next
+    // round downsamples its neighbours without it. The message is encoded
+    // and modulated again at the downsampled rate, aligned within a sync
+    // step to where it takes the most energy, and scaled to the signal by
+    // its correlation with the band averaged over a symbol, which follows
+    // fading and the last of the frequency error. The reconstruction is
+    // transformed back to the band's bins and subtracted from those the
+    // taper left whole, which are exactly what the band held.
+    void subtract_signal(int cand, CandidateScratch& scratch) {
+        constexpr int n = NDOWNSPS;
+        constexpr int length = NN * NDOWNSPS;
+
+        const float freq = signal_freqs_[cand];
+        downsample_signal(freq, scratch);
+        const float* x_re = scratch.downsampled_re.data();
+        const float* x_im = scratch.downsampled_im.data();
+
+        Frame72 frame;
+        int transmission;
+        unpack_bits(signal_bits_[cand], frame, transmission);
+        ToneSequence tones;
+        encode_tones(frame, transmission, MODE, tones);
+        auto& reference = scratch.reference;
+        reference_.render_baseband(tones, reference.data(), reference.size());
+
+        int offset = candidate_offsets_[cand];
+        float best_energy = -1.0f;
+        for (int start = candidate_offsets_[cand] - SYNC_STEP / 2;
+             start <= candidate_offsets_[cand] + SYNC_STEP / 2; ++start) {
+            if (start < 0 || start + length > NDFFT2) continue;
+
+            float energy = 0.0f;
+            for (int sym = 0; sym < NN; ++sym) {
+                complex<float> sum(0.0f, 0.0f);
+                for (int k = sym * n; k < (sym + 1) * n; ++k) {
+                    sum += complex<float>(x_re[start + k], x_im[start + k]) * std::conj(reference[k]);
+                }
+                energy += std::norm(sum);
+            }
+            if (energy > best_energy) {
+                best_energy = energy;
+                offset = start;
+            }
+        }
 
-        // Check all 3 Costas arrays
-        for (int array_idx = 0; array_idx < 3; ++array_idx) {
-            float array_sync = 0.0f;
+        // Running sums of the correlation, for its average over the symbol
+        // centred on each sample
+        auto& cd = scratch.downsampled;
+        cd[0] = complex<float>(0.0f, 0.0f);
+        for (int k = 0; k < length; ++k) {
+            cd[k + 1] = cd[k] + complex<float>(x_re[offset + k], x_im[offset + k]) * std::conj(reference[k]);
+        }
+        for (int k = 0; k < length; ++k) {
+            const int first = std::max(0, k - n / 2);
+            const int last = std::min(length, k + n / 2);
+            reference[k] *= (cd[last] - cd[first]) / static_cast<float>(last - first);
+        }
 
-            // Correlate with each of the 7 symbols in this Costas array
-            for (int sym_idx = 0; sym_idx < 7; ++sym_idx) {
-                int sym_start = symbol_start + (array_idx * 7 + sym_idx) * mode_params_.ndownsps;
+        std::fill(cd.begin(), cd.end(), complex<float>(0.0f, 0.0f));
+        std::copy(reference.begin(), reference.end(), cd.begin() + offset);
+        reconstruct_plan_->execute(cd.data(), cd.data(), scratch.fft_work.data());
 
-                if (sym_start + mode_params_.ndownsps > static_cast<int>(downsampled_.size())) {
-                    continue;
-                }
+        // Undo the downsampling scale, and the forward transform's gain
+        const float scale = std::sqrt(static_cast<float>(NDFFT1) * NDFFT2) / NDFFT2;
+        const auto [i0, ib, it] = band_bins(freq);
+        const int taper_size = static_cast<int>(tables_.taper_head.size());
+        for (int j = taper_size; j <= it - ib - taper_size; ++j) {
+            baseband_[ib + j] -= cd[(j - (i0 - ib) + NDFFT2) % NDFFT2] * scale;
+        }
+    }
 
-                complex<float> correlation = complex<float>(0.0f, 0.0f);
+    // Power of the baseband spectrum within a symbol spectrum bin either
+    // side of a frequency
+    float bin_power(float freq) const {
+        constexpr float df = static_cast<float>(JS8_RX_SAMPLE_RATE) / NDFFT1;
+        constexpr float bin = static_cast<float>(JS8_RX_SAMPLE_RATE) / NFFT1;
+
+        const int first = std::max(0, static_cast<int>(std::round((freq - bin) / df)));
+        const int last = std::min(NDFFT1 / 2, static_cast<int>(std::round((freq + bin) / df)));
+        float power = 0.0f;
+        for (int i = first; i <= last; ++i) power += std::norm(baseband_[i]);
+        return power;
+    }
 
-                // Correlate with the expected Costas symbol
-                for (int k = 0; k < mode_params_.ndownsps; ++k) {
-                    if (sym_start + k < static_cast<int>(downsampled_.size())) {
-                        correlation += downsampled_[sym_start + k] *
-                                     std::conj(costas_templates_[array_idx][sym_idx][k]);
-                    }
+    // Fill the sync map: for every quarter-symbol time offset and every
+    // fine frequency shift, the Costas sync strength averaged over the
+    // three arrays. The correlations of each sync symbol against all
+    // frequency shifts of its tone are a single kernel call, since those
+    // templates are contiguous.
+    void compute_sync_map(CandidateScratch& scratch) const {
+        constexpr int n = NDOWNSPS;
+        const float* x_re = scratch.downsampled_re.data();
+        const float* x_im = scratch.downsampled_im.data();
+        float* map = scratch.sync_map.data();
+
+        scratch.sync_map.fill(0.0f);
+
+        array<float, SYNC_SHIFTS> magnitudes;
+        for (int t = 0; t < SYNC_TIMES; ++t) {
+            float* row = map + static_cast<size_t>(t) * SYNC_SHIFTS;
+
+            for (int array_idx = 0; array_idx < 3; ++array_idx) {
+                for (int sym_idx = 0; sym_idx < 7; ++sym_idx) {
+                    const int sym_start = t * SYNC_STEP + (array_idx * 36 + sym_idx) * n;
+                    const size_t table = tone_offset(tables_.costas[array_idx][sym_idx], 0);
+
+                    correlate_(x_re + sym_start, x_im + sym_start,
+                               tables_.tone_re.data() + table, tables_.tone_im.data() + table,
+                               n, SYNC_SHIFTS, magnitudes.data());
+
+                    for (int shift = 0; shift < SYNC_SHIFTS; ++shift) row[shift] += magnitudes[shift];
                 }
+            }
+
+            for (int shift = 0; shift < SYNC_SHIFTS; ++shift) row[shift] /= 3.0f;
+        }
+    }
+
+    // Fill the symbol power matrix: the magnitude of every symbol of the
+    // frame, sync symbols included, at each of the 8 tones, demodulating
+    // with the tone table at the sync frequency shift
+    bool compute_symbol_powers(CandidateScratch& scratch, int symbol_start, int shift) const {
+        constexpr int n = NDOWNSPS;
+
+        if (symbol_start + NN * n > NDFFT2) {
+            return false;
+        }
 
-                array_sync += std::abs(correlation);
+        for (int sym = 0; sym < NN; ++sym) {
+            const int offset = symbol_start + sym * n;
+            for (int tone = 0; tone < 8; ++tone) {
+                const size_t table = tone_offset(tone, shift);
+                correlate_(scratch.downsampled_re.data() + offset, scratch.downsampled_im.data() + offset,
+                           tables_.tone_re.data() + table, tables_.tone_im.data() + table, n, 1,
+                           &scratch.symbol_powers[tone][sym]);
             }
+        }
+
+        return true;
+    }
 
-            total_sync += array_sync;
+    // Derive bitwise soft metrics for the 58 data symbols from the symbol
+    // power matrix, as JS8Call does: for each of the 3 bits of a symbol,
+    // the strongest tone with the bit set less the strongest without it,
+    // taken once over magnitudes and once over log magnitudes. Both sets
+    // are normalised to unit deviation and scaled by 2.83.
+    static void compute_bit_metrics(const CandidateScratch& scratch, DecodeLane& lane) {
+        for (int j = 0; j < ND; ++j) {
+            // Data symbols are 7..35 and 43..71; the rest are Costas arrays
+            const int sym = j < 29 ? j + 7 : j + 14;
+
+            array<float, 8> ps;
+            for (int tone = 0; tone < 8; ++tone) ps[tone] = scratch.symbol_powers[tone][sym];
+
+            auto metrics = [j](const array<float, 8>& p, array<float, BPDSP::N>& llr) {
+                llr[3 * j]     = std::max({p[4], p[5], p[6], p[7]}) - std::max({p[0], p[1], p[2], p[3]});
+                llr[3 * j + 1] = std::max({p[2], p[3], p[6], p[7]}) - std::max({p[0], p[1], p[4], p[5]});
+                llr[3 * j + 2] = std::max({p[1], p[3], p[5], p[7]}) - std::max({p[0], p[2], p[4], p[6]});
+            };
+
+            metrics(ps, lane.llr);
+            for (auto& x : ps) x = std::log(x + 1e-32f);
+            metrics(ps, lane.llr_log);
         }
 
-        return total_sync / 3.0f; // Average across arrays
+        normalize_llr(lane.llr);
+        normalize_llr(lane.llr_log);
     }
 
-    // Extract 8-FSK symbols from synchronized signal
-    bool extract_symbols(int symbol_start, std::array<int, ND>& symbols) {
-        if (symbol_start + NN * mode_params_.ndownsps > static_cast<int>(downsampled_.size())) {
-            return false;
+    static void normalize_llr(array<float, BPDSP::N>& llr) {
+        float sum = 0.0f;
+        float sum_of_squares = 0.0f;
+
+        for (float value : llr) {
+            sum += value;
+            sum_of_squares += value * value;
+        }
+
+        const float llrav = sum / llr.size();
+        const float llr2av = sum_of_squares / llr.size();
+        const float variance = llr2av - llrav * llrav;
+        const float llrsig = std::sqrt(variance > 0.0f ? variance : llr2av);
+        if (!(llrsig > 0.0f)) return;
+
+        for (float& value : llr) value = value / llrsig * 2.83f;
+    }
+
+    // Belief propagation over up to four LLR variants, as in JS8Call:
+    // magnitude metrics, log metrics, then magnitude metrics with the
+    // first and then the first two 24-bit blocks erased. A pass succeeds
+    // on a non-zero codeword within that pass's hard error limit. Each
+    // pass decodes every lane still without a codeword, all at once with
+    // the min-sum decoder or one by one with flooding BP. Leaves each
+    // lane's hard error count, or -1 if no pass succeeded.
+    void decode_passes(DecodeLane* lanes, int count, Arena& arena) {
+        constexpr int B = BPDSP::MS_BATCH;
+
+        const Arena::Scope scope(arena);
+        BPDSP::MinSumWorkspace* minsum = nullptr;
+        BPDSP::BPWorkspace* flooding = nullptr;
+        if (ldpc_ == JS8DSP_LDPC_MIN_SUM_LAYERED) {
+            minsum = arena.allocate<BPDSP::MinSumWorkspace>();
+        } else {
+            flooding = arena.allocate<BPDSP::BPWorkspace>();
         }
 
-        // Skip first 3 Costas arrays (21 symbols) and extract data symbols (58)
-        int symbol_idx = 0;
+        for (int i = 0; i < count; ++i) lanes[i].nharderrors = -1;
 
-        // Skip first Costas array (7 symbols)
-        int offset = symbol_start + 7 * mode_params_.ndownsps;
+        for (int ipass = 1; ipass <= 4; ++ipass) {
+            const array<float, BPDSP::N>* llr[B];
+            array<int8_t, BPDSP::K>* decoded[B];
+            array<int8_t, BPDSP::N>* codeword[B];
+            int nerr[B];
+            int iterations[B];
+            int index[B];
+            int pending = 0;
 
-        // Extract 58 data symbols between Costas arrays
-        for (int i = 0; i < ND; ++i) {
-            if (i == 29) {
-                // Skip middle Costas array (7 symbols)
-                offset += 7 * mode_params_.ndownsps;
+            for (int i = 0; i < count; ++i) {
+                DecodeLane& lane = lanes[i];
+                if (lane.nharderrors >= 0) continue;
+
+                if (ipass == 3) std::fill(lane.llr.begin(), lane.llr.begin() + 24, 0.0f);
+                else if (ipass == 4) std::fill(lane.llr.begin() + 24, lane.llr.begin() + 48, 0.0f);
+
+                llr[pending] = ipass == 2 ? &lane.llr_log : &lane.llr;
+                decoded[pending] = &lane.decoded_bits;
+                codeword[pending] = &lane.codeword;
+                index[pending++] = i;
             }
+            if (pending == 0) break;
 
-            // Find the strongest tone for this symbol
-            float max_power = 0.0f;
-            int best_tone = 0;
+            if (minsum) {
+                BPDSP::minsum_decode174(llr, pending, decoded, codeword, nerr, *minsum, iterations);
+            } else {
+                for (int k = 0; k < pending; ++k) {
+                    nerr[k] = BPDSP::bpdecode174(*llr[k], *decoded[k], *codeword[k], *flooding, &iterations[k]);
+                }
+            }
 
-            for (int tone = 0; tone < 8; ++tone) {  // 8-FSK
-                complex<float> correlation = complex<float>(0.0f, 0.0f);
+            for (int k = 0; k < pending; ++k) {
+                DecodeLane& lane = lanes[index[k]];
+                const int nharderrors = nerr[k];
+                metrics_.add_ldpc(nharderrors, iterations[k]);
 
-                for (int k = 0; k < mode_params_.ndownsps; ++k) {
-                    if (offset + k < static_cast<int>(downsampled_.size())) {
-                        float phase = 2.0f * M_PI * tone * k / 8.0f;
-                        complex<float> template_val = complex<float>(cos(phase), sin(phase));
-                        correlation += downsampled_[offset + k] * std::conj(template_val);
-                    }
+                if (std::all_of(lane.codeword.begin(), lane.codeword.end(),
+                                [](int8_t bit) { return bit == 0; })) {
+                    continue;
                 }
 
-                float power = std::abs(correlation);
-                if (power > max_power) {
-                    max_power = power;
-                    best_tone = tone;
+                if (nharderrors >= 0 && nharderrors < 60 &&
+                    !(lane.sync < 2.0f && nharderrors > 35) &&
+                    !(ipass > 2 && nharderrors > 39) &&
+                    !(ipass == 4 && nharderrors > 30)) {
+                    lane.nharderrors = nharderrors;
                 }
             }
+        }
+    }
+
+    // Try ordered statistics decoding on the lanes no pass decoded, as long
+    // as the decode pass's OSD budget lasts. The log metrics are used since
+    // the erasure passes leave them intact.
+    void osd_fallback(DecodeLane* lanes, int count, Arena& arena) const {
+        if (!osd_ || osd_->budget_ns <= 0) return;
+
+        const Arena::Scope scope(arena);
+        BPDSP::OsdWorkspace* work = nullptr;
+        for (int i = 0; i < count; ++i) {
+            DecodeLane& lane = lanes[i];
+            if (lane.nharderrors >= 0 || lane.sync < OSD_MIN_SYNC) continue;
+
+            float mean_llr = 0.0f;
+            for (float value : lane.llr_log) mean_llr += std::fabs(value);
+            if (mean_llr / BPDSP::N < OSD_MIN_MEAN_LLR) continue;
+
+            if (osd_->spent_ns.load(std::memory_order_relaxed) >= osd_->budget_ns) {
+                ++osd_->skipped;
+                continue;
+            }
 
-            symbols[symbol_idx++] = best_tone;
-            offset += mode_params_.ndownsps;
+            ++osd_->attempts;
+            if (!work) work = arena.allocate<BPDSP::OsdWorkspace>();
+            const auto start = std::chrono::steady_clock::now();
+            int nharderrors = BPDSP::osd174(lane.llr_log, BPDSP::OSD_MAX_ORDER,
+                                            lane.decoded_bits, lane.codeword, *work);
+            osd_->spent_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::steady_clock::now() - start).count();
+
+            if (nharderrors <= OSD_MAX_HARD_ERRORS &&
+                std::any_of(lane.codeword.begin(), lane.codeword.end(),
+                            [](int8_t bit) { return bit != 0; })) {
+                lane.nharderrors = nharderrors;
+                ++osd_->decoded;
+            }
         }
+    }
 
-        return symbol_idx == ND;
+    // The first 72 message bits are the frame, the next three its
+    // transmission type
+    static void unpack_bits(const array<int8_t, BPDSP::K>& bits, Frame72& frame, int& transmission) {
+        frame = Frame72{0, 0};
+        for (int i = 0; i < 64; ++i) frame.value = frame.value << 1 | static_cast<uint64_t>(bits[i] & 1);
+        for (int i = 64; i < 72; ++i) frame.rem = static_cast<uint8_t>(frame.rem << 1 | (bits[i] & 1));
+        transmission = bits[72] << 2 | bits[73] << 1 | bits[74];
     }
 
-    // Find candidate signals using advanced baseline computation
-    int find_candidates(const float* audio_buffer, size_t buffer_size) {
-        // Create power spectrum
-        const int freq_bins = 2048; // Higher resolution for better baseline computation
-        const float freq_resolution = static_cast<float>(sample_rate_) / freq_bins;
+    static uint32_t hash_bits(const array<int8_t, BPDSP::K>& bits) {
+        uint32_t hash = 2166136261u;        // FNV-1a
+        for (int8_t bit : bits) hash = (hash ^ static_cast<uint8_t>(bit)) * 16777619u;
+        return hash | 1;                    // Never 0, which marks no decode
+    }
+
+    // Stream time at which a candidate's message starts
+    uint64_t candidate_time(int cand) const {
+        return pass_time_ + static_cast<uint64_t>(candidate_offsets_[cand]) *
+                            NSPS / NDOWNSPS;
+    }
+
+    // Whether a cached message could be the same transmission as a signal
+    // at this frequency and time; the next one can start a period later
+    bool near_cached(const CacheEntry& entry, float freq, uint64_t time) const {
+        constexpr float baud = static_cast<float>(JS8_RX_SAMPLE_RATE) / NSPS;
+        const uint64_t distance = time > entry.time ? time - entry.time : entry.time - time;
+        return std::fabs(freq - entry.freq) <= CACHE_FREQ_TOLERANCE * baud && distance < NMAX / 2;
+    }
+
+    // A priori decoding: the lane's hard decisions already agree with the
+    // message bits of a cached transmission, so it needs no LDPC; returns
+    // that transmission, or nullptr
+    const CacheEntry* a_priori_match(const DecodeLane& lane, uint64_t time) const {
+        for (int i = 0; i < cache_count_; ++i) {
+            const CacheEntry& entry = cache_[i];
+            if (!near_cached(entry, lane.freq, time)) continue;
+
+            int errors = 0;
+            for (int k = 0; k < BPDSP::K && errors <= A_PRIORI_MAX_ERRORS; ++k) {
+                errors += (lane.llr[BPDSP::M + k] > 0.0f) != (entry.bits[k] != 0);
+            }
+            if (errors <= A_PRIORI_MAX_ERRORS) return &entry;
+        }
+        return nullptr;
+    }
 
-        spectrum_.resize(freq_bins);
-        baseline_.resize(freq_bins);
+    bool is_cached(float freq, uint64_t time, uint32_t hash) const {
+        for (int i = 0; i < cache_count_; ++i) {
+            if (cache_[i].hash == hash && near_cached(cache_[i], freq, time)) return true;
+        }
+        return false;
+    }
 
-        // Simple power spectrum calculation
+    // Find candidate signals using advanced baseline computation
+    int find_candidates() {
+        // Average the windowed symbol spectra over the slot
+        const auto start = Clock::now();
         std::fill(spectrum_.begin(), spectrum_.end(), 0.0f);
 
-        for (size_t i = 0; i < buffer_size && i < static_cast<size_t>(freq_bins); ++i) {
-            float power = audio_buffer[i] * audio_buffer[i];
-            spectrum_[i] = power;
+        for (int j = 0; j < NHSYM; ++j) {
+            const size_t ia = static_cast<size_t>(j) * NSTEP;
+            const size_t ib = ia + NFFT1;
+
+            if (ib > dd_count_) break;
+
+            accumulate_frame(dd_.data() + ia, NFFT1, nullptr);
+        }
+        publish_frame();
+        metrics_.charge(JS8DSP_STAGE_FFT, start);
+
+        return select_candidates();
+    }
+
+    // Add the power spectrum of one NFFT1 sample frame to spectrum_; the
+    // frame is split in two parts so it can be read across a ring buffer
+    // wrap
+    void accumulate_frame(const float* first, size_t first_size, const float* second) {
+        std::transform(first, first + first_size, tables_.nuttal.begin(), frame_.begin(),
+                       std::multiplies<float>{});
+        if (first_size < static_cast<size_t>(NFFT1)) {
+            std::transform(second, second + (NFFT1 - first_size), tables_.nuttal.begin() + first_size,
+                           frame_.begin() + first_size, std::multiplies<float>{});
+        }
+
+        spectrum_plan_->execute(frame_.data(), frame_fft_.data(), fft_work_.data());
+
+        for (int i = 0; i < NSPS; ++i) {
+            spectrum_[i] += std::norm(frame_fft_[i]);
         }
+        ++frames_computed_;
+    }
+
+    // Publish the frame accumulate_frame() last transformed
+    void publish_frame() {
+        std::lock_guard<std::mutex> lock(view_mutex_);
+        for (int i = 0; i < NSPS; ++i) view_power_[i] = std::norm(frame_fft_[i]);
+        view_frames_ = frames_computed_;
+    }
 
-        // Apply windowing to reduce spectral artifacts
-        for (int i = 0; i < freq_bins && i < static_cast<int>(buffer_size); ++i) {
-            float window = 0.5f * (1.0f - cosf(2.0f * M_PI * i / (freq_bins - 1))); // Hann window
-            spectrum_[i] *= window;
+    // Write one value of a spectrum in the layout's format
+    static void store_db(const js8dsp_spectrum_layout_t& layout, void* out, uint32_t index, float db) {
+        if (layout.format == JS8DSP_SPECTRUM_F16) {
+            static_cast<uint16_t*>(out)[index] = float_to_half(db);
+        } else {
+            const float level = (db - layout.db_min) * 255.0f / (layout.db_max - layout.db_min);
+            static_cast<uint8_t*>(out)[index] = static_cast<uint8_t>(std::lround(std::clamp(level, 0.0f, 255.0f)));
         }
+    }
+
+    // Pick candidates from the accumulated symbol spectra
+    int select_candidates() {
+        constexpr int freq_bins = NSPS;
+        constexpr float freq_resolution = static_cast<float>(JS8_RX_SAMPLE_RATE) / NFFT1;
 
         // Compute advanced baseline using Eigen polynomial fitting
+        auto start = Clock::now();
         baseline_computer_.computeBaseline(spectrum_, freq_resolution, baseline_);
+        {
+            std::lock_guard<std::mutex> lock(view_mutex_);
+            std::copy(baseline_.begin(), baseline_.end(), view_baseline_.begin());
+        }
+        start = metrics_.charge(JS8DSP_STAGE_BASELINE, start);
 
         // Find candidates by comparing signal to baseline
         int num_candidates = 0;
-        const float snr_threshold = 3.0f; // 3 dB above baseline
 
         for (int bin = 0; bin < freq_bins && num_candidates < NMAXCAND; ++bin) {
             float freq = bin * freq_resolution;
@@ -218,207 +992,1924 @@ private:
             float baseline_db = baseline_[bin];
             float snr = signal_db - baseline_db;
 
-            if (snr > snr_threshold) {
+            if (snr > CANDIDATE_MIN_SNR) {
                 candidate_freqs_[num_candidates] = freq;
                 candidate_snrs_[num_candidates] = snr;
                 ++num_candidates;
             }
         }
 
+        // Strong signals of the previous pass are searched again at their
+        // frequencies even if they no longer stand out from the baseline
+        for (int i = 0; i < seed_count_ && num_candidates < NMAXCAND; ++i) {
+            const float freq = seeds_[i];
+            bool covered = false;
+            for (int c = 0; c < num_candidates && !covered; ++c) {
+                covered = std::fabs(candidate_freqs_[c] - freq) <= freq_resolution;
+            }
+            if (covered) continue;
+
+            const int bin = std::min(freq_bins - 1, static_cast<int>(std::lround(freq / freq_resolution)));
+            candidate_freqs_[num_candidates] = freq;
+            candidate_snrs_[num_candidates] = 10.0f * log10f(std::max(spectrum_[bin], 1e-10f)) - baseline_[bin];
+            ++num_candidates;
+        }
+
+        selected_count_ = num_candidates;
+        std::copy(candidate_freqs_.begin(), candidate_freqs_.begin() + num_candidates, selected_freqs_.begin());
+        std::copy(candidate_snrs_.begin(), candidate_snrs_.begin() + num_candidates, selected_snrs_.begin());
+        round_ = 1;
+        round_start_ = 0;
+        num_candidates = rank_candidates(0, num_candidates);
+
+        metrics_.charge(JS8DSP_STAGE_CANDIDATES, start);
+        DecodeMetrics::add(metrics_.pass.found, static_cast<uint64_t>(num_candidates));
         return num_candidates;
     }
 
-public:
-    JS8Decoder(int sample_rate, int mode)
-        : sample_rate_(sample_rate), js8_mode_(static_cast<Mode>(mode)),
-          mode_params_(getModeParams(js8_mode_)), decode_threshold_(-20.0f) {
+    // Order candidates by SNR, strongest first, so that the expensive
+    // stages reach the most promising ones first. A candidate close to a
+    // stronger one is most likely a neighbouring bin of the same tone, so
+    // the strongest of each cluster, its head, is ranked ahead of every
+    // neighbour; neighbours are only worth decoding if their head was not
+    // a signal. Ranks the count candidates from first, a round's worth;
+    // returns the number of candidates up to the end of them.
+    int rank_candidates(int first, int count) {
+        for (int i = 0; i < count; ++i) rank_[i] = first + i;
+        std::sort(rank_.begin(), rank_.begin() + count, [this](int a, int b) {
+            if (candidate_snrs_[a] != candidate_snrs_[b]) return candidate_snrs_[a] > candidate_snrs_[b];
+            return candidate_freqs_[a] < candidate_freqs_[b];
+        });
+
+        // Heads fill the front in rank order and neighbours the back in
+        // reverse, which is then flipped back
+        array<float, NMAXCAND> freqs;
+        array<float, NMAXCAND> snrs;
+        int heads = 0;
+        int tail = count;
+        for (int i = 0; i < count; ++i) {
+            const float freq = candidate_freqs_[rank_[i]];
+            bool neighbour = false;
+            for (int k = 0; k < heads && !neighbour; ++k) {
+                neighbour = std::fabs(freqs[k] - freq) < CLUSTER_TOLERANCE;
+            }
+
+            const int slot = neighbour ? --tail : heads++;
+            freqs[slot] = freq;
+            snrs[slot] = candidate_snrs_[rank_[i]];
+        }
+        std::reverse(freqs.begin() + heads, freqs.begin() + count);
+        std::reverse(snrs.begin() + heads, snrs.begin() + count);
+
+        std::copy(freqs.begin(), freqs.begin() + count, candidate_freqs_.begin() + first);
+        std::copy(snrs.begin(), snrs.begin() + count, candidate_snrs_.begin() + first);
+        num_heads_ = heads;
 
-        // FFT is handled by Go layer
+        // Candidates never decoded, because they were pruned or the time
+        // budget ran out, report nothing
+        std::fill(result_valid_.begin() + first, result_valid_.begin() + first + count, false);
+        std::fill(result_hashes_.begin() + first, result_hashes_.begin() + first + count, 0u);
+        std::fill(signal_hashes_.begin() + first, signal_hashes_.begin() + first + count, 0u);
+        std::fill(candidate_syncs_.begin() + first, candidate_syncs_.begin() + first + count, 0.0f);
+
+        return first + count;
+    }
 
-        // Initialize Costas templates
-        init_costas_templates();
+    // Whether a candidate lies within the tones of a decoded head, from
+    // just below its tone 0 to just above tone 7, so that it could only
+    // find that signal again
+    bool within_decoded(float freq) const {
+        constexpr float baud = static_cast<float>(JS8_RX_SAMPLE_RATE) / NSPS;
+        for (int head = round_start_; head < round_start_ + num_heads_; ++head) {
+            if (signal_hashes_[head] == 0) continue;
 
-        // Reserve space for processing buffers
-        input_buffer_.reserve(sample_rate_ * mode_params_.ntxdur);
-        downsampled_.reserve(sample_rate_ * mode_params_.ntxdur / (mode_params_.nsps / mode_params_.ndownsps));
+            const float base = signal_freqs_[head];
+            if (freq > base - CLUSTER_TOLERANCE && freq < base + 7.0f * baud + CLUSTER_TOLERANCE) return true;
+        }
+        return false;
     }
 
-    ~JS8Decoder() {
-        // No cleanup needed - FFT handled by Go layer
+    // Whether an earlier round of the pass found this message, which a
+    // later one can find again in what subtraction left of it
+    bool found_earlier(uint32_t hash) const {
+        for (int cand = 0; cand < round_start_; ++cand) {
+            if (signal_hashes_[cand] == hash) return true;
+        }
+        return false;
     }
 
-    int decode_buffer(const float* audio_buffer, size_t buffer_size,
-                     js8dsp_decoded_message_t* messages, int max_messages) {
+    void found_signal(int cand, float freq, uint32_t hash, const array<int8_t, BPDSP::K>& bits) {
+        signal_hashes_[cand] = hash;
+        signal_freqs_[cand] = freq;
+        signal_bits_[cand] = bits;
+    }
 
-        if (!audio_buffer || !messages || max_messages <= 0) {
-            return -1;
+    // Whether a candidate's band overlaps the bins subtracting a signal at
+    // base changed, from half a baud below its tone 0 to half a baud above
+    // tone 7, without being that signal
+    static bool overlaps_subtracted(float freq, float base) {
+        constexpr float baud = static_cast<float>(JS8_RX_SAMPLE_RATE) / NSPS;
+        return freq > base - 9.0f * baud && freq < base + 9.0f * baud &&
+               std::fabs(freq - base) >= CLUSTER_TOLERANCE;
+    }
+
+    // Sync and demodulate one candidate into a lane; returns true if its
+    // bit metrics are ready for LDPC decoding, otherwise the candidate's
+    // result is already final. The best sync found and its offset are
+    // recorded either way.
+    bool demodulate_candidate(int cand, CandidateScratch& scratch, DecodeLane& lane) {
+        float freq = candidate_freqs_[cand];
+        float& best_sync = candidate_syncs_[cand];
+        int& best_offset = candidate_offsets_[cand];
+
+        best_sync = 0.0f;
+        best_offset = 0;
+        result_valid_[cand] = false;
+        result_hashes_[cand] = 0;
+        signal_hashes_[cand] = 0;
+
+        // Downsample signal around this frequency
+        auto start = Clock::now();
+        downsample_signal(freq, scratch);
+
+        // Search time offsets and fine frequency shifts together
+        compute_sync_map(scratch);
+        int best_shift = SYNC_SHIFTS / 2;
+
+        for (int t = 0; t < SYNC_TIMES; ++t) {
+            const float* row = &scratch.sync_map[static_cast<size_t>(t) * SYNC_SHIFTS];
+            for (int shift = 0; shift < SYNC_SHIFTS; ++shift) {
+                if (row[shift] > best_sync) {
+                    best_sync = row[shift];
+                    best_offset = t * SYNC_STEP;
+                    best_shift = shift;
+                }
+            }
         }
 
-        // Find candidate signals
-        int num_candidates = find_candidates(audio_buffer, buffer_size);
-        int decoded_count = 0;
+        constexpr float baud = static_cast<float>(JS8_RX_SAMPLE_RATE) / NSPS;
+        freq += (best_shift - SYNC_SHIFTS / 2) * SYNC_SHIFT_STEP * baud;
+        start = metrics_.charge(JS8DSP_STAGE_SYNC, start);
 
-        // Try to decode each candidate
-        for (int cand = 0; cand < num_candidates && decoded_count < max_messages; ++cand) {
-            float freq = candidate_freqs_[cand];
-            float snr = candidate_snrs_[cand];
+        // Check if synchronization is strong enough
+        if (!(best_sync > ASYNCMIN)) return false;
 
-            // Downsample signal around this frequency
-            downsample_signal(audio_buffer, buffer_size, freq);
+        // A candidate that syncs but yields no symbols is not a result;
+        // SYNC_STATE events report it
+        if (!compute_symbol_powers(scratch, best_offset, best_shift)) {
+            metrics_.charge(JS8DSP_STAGE_LLR, start);
+            return false;
+        }
 
-            if (downsampled_.size() < static_cast<size_t>(NN * mode_params_.ndownsps)) {
-                continue; // Not enough data
+        // Soft bit metrics (3 bits per symbol, 58 symbols = 174 bits)
+        lane.cand = cand;
+        lane.freq = freq;
+        lane.sync = best_sync;
+        compute_bit_metrics(scratch, lane);
+        metrics_.charge(JS8DSP_STAGE_LLR, start);
+
+        // Already reported by an earlier pass over this slot
+        if (cache_enabled_) {
+            const CacheEntry* entry = a_priori_match(lane, candidate_time(cand));
+            if (entry && !(round_ > 1 && found_earlier(entry->hash))) {
+                found_signal(cand, freq, entry->hash, entry->bits);
             }
+            if (entry) return false;
+        }
+
+        return true;
+    }
+
+    // Store the result of a synced candidate once its lane is LDPC
+    // decoded. Only decodes are results; a candidate that syncs but fails
+    // LDPC is reported by SYNC_STATE events alone.
+    void finish_candidate(const DecodeLane& lane) {
+        if (lane.nharderrors < 0) return;
+
+        const uint32_t hash = hash_bits(lane.decoded_bits);
+        if (round_ > 1 && found_earlier(hash)) return;
+        found_signal(lane.cand, lane.freq, hash, lane.decoded_bits);
+        // Still subtracted, so weak decodes do not mask others, but not
+        // reported below the caller's threshold
+        if (candidate_snrs_[lane.cand] < decode_threshold_) return;
+        if (cache_enabled_ && is_cached(lane.freq, candidate_time(lane.cand), hash)) return;
+
+        result_hashes_[lane.cand] = hash;
+
+        js8dsp_decoded_message_t& result = results_[lane.cand];
+        result.snr = candidate_snrs_[lane.cand];
+        result.freq_offset = lane.freq - 1500.0f;
+        result.timestamp = candidate_offsets_[lane.cand];
+        result_valid_[lane.cand] = true;
+
+        Frame72 frame;
+        int transmission;
+        unpack_bits(lane.decoded_bits, frame, transmission);
+
+        FrameType type;
+        if (unpack_message(frame, transmission, result.message, sizeof(result.message), type) < 0) {
+            // Dense coded data is reported as its frame text
+            pack72(frame, result.message);
+            result.message[FRAME_TEXT_LENGTH] = '\0';
+        }
+        result.confidence = 100 - lane.nharderrors; // Fewer errors = higher confidence
+    }
 
-            // Try different time offsets
-            float best_sync = 0.0f;
-            int best_offset = 0;
+public:
+    DecodeMode(int channel, DecodeMetrics& metrics)
+        : channel_(channel), decode_threshold_(-20.0f), reference_(DOWNSAMPLED_RATE, MODE),
+          ldpc_(JS8DSP_LDPC_BP_FLOODING), osd_(nullptr), metrics_(metrics), cache_enabled_(false),
+          cache_count_(0), cache_next_(0), seed_count_(0), pass_time_(0), frames_computed_(0),
+          view_power_{}, view_baseline_{}, view_frames_(0), tables_(mode_tables(MODE)),
+          correlate_(correlate_kernel()) {
+
+        auto& plans = FFTPlanManager::instance();
+        spectrum_plan_ = &plans.get(NFFT1, FFTKind::REAL, FFTDirection::FORWARD);
+        baseband_plan_ = &plans.get(NDFFT1, FFTKind::REAL, FFTDirection::FORWARD);
+        downsample_plan_ = &plans.get(NDFFT2, FFTKind::COMPLEX, FFTDirection::BACKWARD);
+        reconstruct_plan_ = &plans.get(NDFFT2, FFTKind::COMPLEX, FFTDirection::FORWARD);
+
+        dd_count_ = 0;
+        fft_work_.resize(std::max(spectrum_plan_->workspace_size(),
+                                  baseband_plan_->workspace_size()));
+
+        scratch_.resize(1);
+        init_scratch(scratch_[0]);
+        num_candidates_ = 0;
+        num_heads_ = 0;
+        selected_count_ = 0;
+        round_ = 1;
+        round_start_ = 0;
+        slot_start_ = 0;
+        frames_done_ = 0;
+
+        spectrum_.resize(NSPS);
+        baseline_.resize(NSPS);
+        baseline_computer_.reserve(NSPS);
+
+        // The noise floor rarely changes shape from one slot to the next
+        baseline_computer_.setIncremental(true);
+    }
 
-            const int max_offset = downsampled_.size() - NN * mode_params_.ndownsps;
-            const int step = mode_params_.ndownsps / 4; // Quarter-symbol steps
+    Mode mode() const override { return MODE; }
+    int channel() const override { return channel_; }
+    size_t input_samples() const override { return NMAX; }
 
-            for (int offset = 0; offset < max_offset; offset += step) {
-                float sync_strength = sync_costas(offset, 0.0f);
+    int prepare(const float* samples, size_t count, uint64_t time) override {
+        slot_start_ = 0;
+        pass_time_ = time;
+        dd_count_ = std::min(count, NMAX);
+        std::copy(samples, samples + dd_count_, dd_.begin());
 
-                if (sync_strength > best_sync) {
-                    best_sync = sync_strength;
-                    best_offset = offset;
-                }
+        num_candidates_ = find_candidates();
+        if (num_candidates_ > 0) {
+            compute_baseband_fft();
+        }
+
+        return num_candidates_;
+    }
+
+    void stream_reset(uint64_t slot_start) override {
+        slot_start_ = slot_start;
+        frames_done_ = 0;
+        std::fill(spectrum_.begin(), spectrum_.end(), 0.0f);
+    }
+
+    uint64_t slot_end() const override { return slot_start_ + NMAX; }
+
+    uint64_t slot_start() const override { return slot_start_; }
+    size_t slot_samples() const override { return dd_count_; }
+
+    void stream_advance(const float* ring, size_t ring_mask, uint64_t written) override {
+        const uint64_t limit = std::min(written, slot_end());
+        const auto start = Clock::now();
+        const int frames_before = frames_done_;
+
+        while (frames_done_ < NHSYM) {
+            const uint64_t ia = slot_start_ + static_cast<uint64_t>(frames_done_) * NSTEP;
+            if (ia + NFFT1 > limit) break;
+
+            const size_t offset = static_cast<size_t>(ia & ring_mask);
+            const size_t first = std::min<size_t>(NFFT1, ring_mask + 1 - offset);
+            accumulate_frame(ring + offset, first, ring);
+            ++frames_done_;
+        }
+        if (frames_done_ != frames_before) publish_frame();
+        metrics_.charge(JS8DSP_STAGE_FFT, start);
+    }
+
+    int stream_finish(const float* ring, size_t ring_mask) override {
+        stream_advance(ring, ring_mask, slot_end());
+
+        const auto start = Clock::now();
+        const size_t offset = static_cast<size_t>(slot_start_ & ring_mask);
+        const size_t first = std::min(NMAX, ring_mask + 1 - offset);
+        std::copy(ring + offset, ring + offset + first, dd_.begin());
+        std::copy(ring, ring + (NMAX - first), dd_.begin() + first);
+        dd_count_ = NMAX;
+        pass_time_ = slot_start_;
+        metrics_.charge(JS8DSP_STAGE_INGEST, start);
+
+        num_candidates_ = select_candidates();
+        if (num_candidates_ > 0) {
+            compute_baseband_fft();
+        }
+
+        return num_candidates_;
+    }
+
+    void decode(int first, int count, size_t worker, Arena& arena) override {
+        CandidateScratch& scratch = scratch_[worker];
+        const Arena::Scope scope(arena);
+        DecodeLane* lanes = arena.allocate<DecodeLane>(static_cast<size_t>(count));
+
+        int ready = 0;
+        for (int cand = first; cand < first + count; ++cand) {
+            if (demodulate_candidate(cand, scratch, lanes[ready])) ++ready;
+        }
+
+        auto start = Clock::now();
+        decode_passes(lanes, ready, arena);
+        osd_fallback(lanes, ready, arena);
+        start = metrics_.charge(JS8DSP_STAGE_LDPC, start);
+
+        int decoded = 0;
+        for (int i = 0; i < ready; ++i) {
+            decoded += lanes[i].nharderrors >= 0;
+            finish_candidate(lanes[i]);
+        }
+        metrics_.charge(JS8DSP_STAGE_UNPACK, start);
+        DecodeMetrics::add(metrics_.pass.attempted, static_cast<uint64_t>(ready));
+        DecodeMetrics::add(metrics_.pass.decoded, static_cast<uint64_t>(decoded));
+
+        for (int cand = first; cand < first + count; ++cand) {
+            if (!result_valid_[cand]) continue;
+            results_[cand].mode = static_cast<int>(MODE);
+            results_[cand].channel = channel_;
+        }
+    }
+
+    int batch_size() const override {
+        return ldpc_ == JS8DSP_LDPC_MIN_SUM_LAYERED ? BPDSP::MS_BATCH : 1;
+    }
+
+    int candidate_count() const override { return num_candidates_; }
+    int round_start() const override { return round_start_; }
+    int head_count() const override { return num_heads_; }
+
+    int prune_neighbours() override {
+        int kept = round_start_ + num_heads_;
+        for (int cand = kept; cand < num_candidates_; ++cand) {
+            if (within_decoded(candidate_freqs_[cand])) continue;
+
+            candidate_freqs_[kept] = candidate_freqs_[cand];
+            candidate_snrs_[kept] = candidate_snrs_[cand];
+            ++kept;
+        }
+
+        DecodeMetrics::add(metrics_.pass.suppressed, static_cast<uint64_t>(num_candidates_ - kept));
+        num_candidates_ = kept;
+        return kept;
+    }
+
+    int next_round(size_t worker) override {
+        const auto start = Clock::now();
+        const int round_end = num_candidates_;
+
+        // Several candidates can find one signal; take it from the best synced
+        array<int, MAX_SLOT_CANDIDATES> signals;
+        int signal_count = 0;
+        for (int cand = round_start_; cand < round_end; ++cand) {
+            if (signal_hashes_[cand] == 0) continue;
+
+            bool best = true;
+            for (int other = round_start_; other < round_end && best; ++other) {
+                best = other == cand || signal_hashes_[other] != signal_hashes_[cand] ||
+                       candidate_syncs_[other] < candidate_syncs_[cand] ||
+                       (candidate_syncs_[other] == candidate_syncs_[cand] && other > cand);
             }
+            if (best) signals[signal_count++] = cand;
+        }
 
-            // Check if synchronization is strong enough
-            if (best_sync > ASYNCMIN) {
-                // We found a synchronized signal! Extract symbols and decode
-                std::array<int, ND> data_symbols;
-
-                if (extract_symbols(best_offset, data_symbols)) {
-                    // Convert symbols to log-likelihood ratios for BP decoder
-                    std::array<float, BPDSP::N> llr;
-                    std::array<int8_t, BPDSP::K> decoded_bits;
-                    std::array<int8_t, BPDSP::N> codeword;
-
-                    // Convert 8-FSK symbols to bit LLRs (3 bits per symbol, 58 symbols = 174 bits)
-                    for (int i = 0; i < ND; ++i) {
-                        int symbol = data_symbols[i];
-
-                        // Convert symbol to 3 bits (Gray coding)
-                        int b0 = (symbol >> 2) & 1;
-                        int b1 = (symbol >> 1) & 1;
-                        int b2 = symbol & 1;
-
-                        // Simple LLR calculation (positive = bit 1, negative = bit 0)
-                        // This is a simplified approach - real implementation would use
-                        // correlation powers for soft decoding
-                        llr[i * 3] = (b0 == 1) ? 2.0f : -2.0f;
-                        llr[i * 3 + 1] = (b1 == 1) ? 2.0f : -2.0f;
-                        llr[i * 3 + 2] = (b2 == 1) ? 2.0f : -2.0f;
-                    }
-
-                    // Apply BP decoder
-                    int decode_result = BPDSP::bpdecode174(llr, decoded_bits, codeword);
-
-                    if (decode_result >= 0) {
-                        // Successfully decoded! Convert bits to message
-                        // First 75 bits are message data, last 12 bits are CRC
-                        std::string decoded_msg;
-
-                        // Simple bit-to-character conversion (this is a placeholder)
-                        // Real implementation would use JS8 message encoding
-                        for (int i = 0; i < 72; i += 6) {  // 6 bits per character
-                            int char_val = 0;
-                            for (int j = 0; j < 6; ++j) {
-                                if (i + j < BPDSP::K && decoded_bits[i + j]) {
-                                    char_val |= (1 << (5 - j));
-                                }
-                            }
-                            if (char_val >= 32 && char_val < 127) {
-                                decoded_msg += static_cast<char>(char_val);
-                            }
-                        }
-
-                        // Store successful decode
-                        snprintf(messages[decoded_count].message, sizeof(messages[decoded_count].message),
-                                "DECODED: %s", decoded_msg.c_str());
-                        messages[decoded_count].snr = snr;
-                        messages[decoded_count].freq_offset = freq - 1500.0f;
-                        messages[decoded_count].timestamp = best_offset;
-                        messages[decoded_count].confidence = 100 - decode_result; // Fewer errors = higher confidence
-
-                        ++decoded_count;
-                    } else {
-                        // Decoding failed but we had good sync
-                        snprintf(messages[decoded_count].message, sizeof(messages[decoded_count].message),
-                                "JS8 SYNC %.1f Hz (decode failed)", freq);
-                        messages[decoded_count].snr = snr;
-                        messages[decoded_count].freq_offset = freq - 1500.0f;
-                        messages[decoded_count].timestamp = best_offset;
-                        messages[decoded_count].confidence = static_cast<int>(best_sync * 10.0f);
-
-                        ++decoded_count;
-                    }
-                } else {
-                    // Symbol extraction failed
-                    snprintf(messages[decoded_count].message, sizeof(messages[decoded_count].message),
-                            "JS8 SYNC %.1f Hz (symbol extraction failed)", freq);
-                    messages[decoded_count].snr = snr;
-                    messages[decoded_count].freq_offset = freq - 1500.0f;
-                    messages[decoded_count].timestamp = best_offset;
-                    messages[decoded_count].confidence = static_cast<int>(best_sync * 5.0f);
-
-                    ++decoded_count;
-                }
+        // Selected candidates in the bands the signals are subtracted from,
+        // and their power before
+        array<int, NMAXCAND> affected;
+        array<float, NMAXCAND> power_before;
+        int affected_count = 0;
+        for (int i = 0; i < selected_count_ && signal_count > 0; ++i) {
+            const float freq = selected_freqs_[i];
+            bool overlaps = false;
+            for (int k = 0; k < signal_count && !overlaps; ++k) {
+                overlaps = overlaps_subtracted(freq, signal_freqs_[signals[k]]);
+            }
+            bool decoded = false;
+            for (int cand = 0; cand < round_end && overlaps && !decoded; ++cand) {
+                decoded = signal_hashes_[cand] != 0 && std::fabs(freq - signal_freqs_[cand]) < CLUSTER_TOLERANCE;
             }
+            if (!overlaps || decoded) continue;
+
+            affected[affected_count] = i;
+            power_before[affected_count++] = bin_power(freq);
         }
 
-        return decoded_count;
+        for (int k = 0; k < signal_count; ++k) subtract_signal(signals[k], scratch_[worker]);
+
+        // Revisit, in selection order so that ranking is as in the first
+        // round, those that still stand out once their SNR is corrected by
+        // what subtraction took from their bins
+        int count = 0;
+        for (int k = 0; k < affected_count && round_end + count < MAX_SLOT_CANDIDATES; ++k) {
+            const int i = affected[k];
+            const float snr = selected_snrs_[i] + 10.0f * log10f(std::max(bin_power(selected_freqs_[i]), 1e-30f) /
+                                                                 std::max(power_before[k], 1e-30f));
+            if (!(snr > CANDIDATE_MIN_SNR)) continue;
+
+            candidate_freqs_[round_end + count] = selected_freqs_[i];
+            candidate_snrs_[round_end + count] = snr;
+            ++count;
+        }
+
+        ++round_;
+        round_start_ = round_end;
+        num_candidates_ = rank_candidates(round_end, count);
+        metrics_.charge(JS8DSP_STAGE_FFT, start);
+        DecodeMetrics::add(metrics_.pass.subtracted, static_cast<uint64_t>(signal_count));
+        DecodeMetrics::add(metrics_.pass.found, static_cast<uint64_t>(count));
+        return signal_count > 0 ? count : 0;
     }
 
-    void set_threshold(float threshold) {
+    bool has_result(int cand) const override { return result_valid_[cand]; }
+    const js8dsp_decoded_message_t& result(int cand) const override { return results_[cand]; }
+    float candidate_freq(int cand) const override { return candidate_freqs_[cand]; }
+    float candidate_snr(int cand) const override { return candidate_snrs_[cand]; }
+    float candidate_sync(int cand) const override { return candidate_syncs_[cand]; }
+
+    float candidate_dt(int cand) const override {
+        constexpr float downsampled_rate = static_cast<float>(JS8_RX_SAMPLE_RATE) * NDOWNSPS / NSPS;
+        return candidate_offsets_[cand] / downsampled_rate - PARAMS.astart;
+    }
+
+    void set_workers(size_t workers) override {
+        scratch_.resize(std::max<size_t>(workers, 1));
+        for (auto& scratch : scratch_) init_scratch(scratch);
+    }
+
+    void lock_memory(MemoryLock& lock) const override {
+        lock.add(this, sizeof(*this));
+        lock.add(spectrum_);
+        lock.add(baseline_);
+        lock.add(fft_work_);
+        lock.add(scratch_);
+        for (const auto& scratch : scratch_) lock.add(scratch.fft_work);
+        baseline_computer_.lock_memory(lock);
+
+        for (std::span<const float> table : {tables_.tone_re, tables_.tone_im, tables_.nuttal,
+                                             tables_.taper_head, tables_.taper_tail}) {
+            lock.add(table.data(), table.size_bytes());
+        }
+    }
+
+    void set_threshold(float threshold) override {
         decode_threshold_ = threshold;
     }
 
-    float get_threshold() const {
-        return decode_threshold_;
+    void set_ldpc_decoder(js8dsp_ldpc_t ldpc) override {
+        ldpc_ = ldpc;
     }
-};
 
-} // namespace JS8DSP
+    uint32_t result_hash(int cand) const override { return result_hashes_[cand]; }
 
-// C API implementation
-extern "C" {
+    void set_cache_enabled(bool enabled) override {
+        cache_enabled_ = enabled;
+        clear_cache();
+        clear_seeds();
+    }
 
-struct js8_decoder_context {
-    JS8DSP::JS8Decoder* decoder;
-};
+    void clear_cache() override {
+        cache_count_ = 0;
+        cache_next_ = 0;
+    }
 
-js8_decoder_t* js8_decoder_create(int sample_rate, int mode) {
-    try {
-        auto ctx = new js8_decoder_context;
-        ctx->decoder = new JS8DSP::JS8Decoder(sample_rate, mode);
-        return reinterpret_cast<js8_decoder_t*>(ctx);
-    } catch (...) {
-        return nullptr;
+    void clear_seeds() override { seed_count_ = 0; }
+
+    void save_state(DecoderState& state, uint64_t now) const override {
+        state.has_fit = baseline_computer_.saveFit(state.fit);
+        state.seed_count = seed_count_;
+        std::copy(seeds_.begin(), seeds_.begin() + seed_count_, state.seeds.begin());
+
+        // The ring's oldest entry is the next to be overwritten once it is full
+        const int oldest = cache_count_ < CACHE_SIZE ? 0 : cache_next_;
+        state.decode_count = cache_count_;
+        for (int i = 0; i < cache_count_; ++i) {
+            const CacheEntry& entry = cache_[(oldest + i) % CACHE_SIZE];
+            DecoderState::Decode& decode = state.decodes[i];
+            decode.freq = entry.freq;
+            decode.age = now - std::min(now, entry.time);
+            decode.hash = entry.hash;
+            decode.bits = entry.bits;
+        }
     }
-}
 
-void js8_decoder_destroy(js8_decoder_t* decoder) {
-    if (!decoder) return;
+    void restore_state(const DecoderState& state, uint64_t now) override {
+        if (state.has_fit) baseline_computer_.restoreFit(state.fit);
+        seed_count_ = state.seed_count;
+        std::copy(state.seeds.begin(), state.seeds.begin() + seed_count_, seeds_.begin());
+
+        // Decodes from before the clock started could not match a signal
+        clear_cache();
+        for (int i = 0; i < state.decode_count; ++i) {
+            const DecoderState::Decode& decode = state.decodes[i];
+            if (decode.age > now) continue;
+
+            CacheEntry& entry = cache_[cache_count_++];
+            entry.freq = decode.freq;
+            entry.time = now - decode.age;
+            entry.hash = decode.hash;
+            entry.bits = decode.bits;
+        }
+        cache_next_ = cache_count_ % CACHE_SIZE;
+    }
 
-    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
-    delete ctx->decoder;
-    delete ctx;
-}
+    void remember(int cand) override {
+        if (!cache_enabled_ || result_hashes_[cand] == 0) return;
 
-int js8_decoder_decode(js8_decoder_t* decoder,
-                      const float* audio_buffer,
-                      size_t buffer_size,
-                      js8dsp_decoded_message_t* messages,
-                      int max_messages) {
-    if (!decoder) return -1;
+        CacheEntry& entry = cache_[cache_next_];
+        entry.freq = results_[cand].freq_offset + 1500.0f;
+        entry.time = candidate_time(cand);
+        entry.hash = result_hashes_[cand];
+        entry.bits = signal_bits_[cand];
+        cache_next_ = (cache_next_ + 1) % CACHE_SIZE;
+        cache_count_ = std::min(cache_count_ + 1, CACHE_SIZE);
 
-    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
-    return ctx->decoder->decode_buffer(audio_buffer, buffer_size,
-                                      messages, max_messages);
-}
+        if (candidate_syncs_[cand] >= SEED_MIN_SYNC && seed_count_ < CACHE_SIZE) {
+            seeds_[seed_count_++] = entry.freq;
+        }
+    }
 
-} // extern "C"
\ No newline at end of file
+    void set_osd_budget(OsdBudget* osd) override {
+        osd_ = osd;
+    }
+
+    float get_threshold() const override {
+        return decode_threshold_;
+    }
+
+    uint64_t read_spectrum(const js8dsp_spectrum_layout_t& layout, void* power, void* baseline) const override {
+        constexpr float bin_hz = static_cast<float>(JS8_RX_SAMPLE_RATE) / NFFT1;
+        const float width = (layout.high_hz - layout.low_hz) / static_cast<float>(layout.bins);
+
+        std::lock_guard<std::mutex> lock(view_mutex_);
+        if (view_frames_ == 0) return 0;
+
+        for (uint32_t k = 0; k < layout.bins; ++k) {
+            // Our bins centred within this one, or the nearest when it is
+            // narrower than ours
+            const float low = layout.low_hz + static_cast<float>(k) * width;
+            const int centre = std::min(NSPS - 1, static_cast<int>(std::lround((low + width / 2) / bin_hz)));
+            int first = static_cast<int>(std::ceil(low / bin_hz));
+            int last = std::min(NSPS, static_cast<int>(std::ceil((low + width) / bin_hz))) - 1;
+            if (last < first) first = last = centre;
+
+            float peak = view_power_[first];
+            for (int i = first + 1; i <= last; ++i) peak = std::max(peak, view_power_[i]);
+            store_db(layout, power, k, 10.0f * log10f(std::max(peak, 1e-10f)));
+            if (baseline) store_db(layout, baseline, k, view_baseline_[centre]);
+        }
+
+        return view_frames_;
+    }
+};
+
+// Create the decoder for a submode; the only place the mode is dispatched
+// on at run time
+std::unique_ptr<JS8Decoder> make_decoder(Mode mode, int channel, DecodeMetrics& metrics) {
+    switch (mode) {
+    case Mode::FAST: return std::make_unique<DecodeMode<Mode::FAST>>(channel, metrics);
+    case Mode::TURBO: return std::make_unique<DecodeMode<Mode::TURBO>>(channel, metrics);
+    case Mode::SLOW: return std::make_unique<DecodeMode<Mode::SLOW>>(channel, metrics);
+    case Mode::ULTRA: return std::make_unique<DecodeMode<Mode::ULTRA>>(channel, metrics);
+    case Mode::NORMAL:
+    default: return std::make_unique<DecodeMode<Mode::NORMAL>>(channel, metrics);
+    }
+}
+
+/**
+ * Decodes any set of submodes from one audio slot of one or more
+ * receiver channels.
+ *
+ * Each channel's input is converted to 12 kHz once and shared by every
+ * submode. Each submode of each channel has its own JS8Decoder, since
+ * symbol spectra, baseline and baseband transforms all depend on the
+ * mode's symbol length and period, while the mode's tables, FFT plans and
+ * the worker pool are shared by all channels. Candidate search runs one
+ * task per channel and submode; then the candidates of all of them are
+ * decoded as a single parallel batch and merged.
+ */
+class MultiModeDecoder {
+private:
+    static constexpr int NUM_MODES = 5;
+    static constexpr int ALL_SUBMODES = (1 << NUM_MODES) - 1;
+    static constexpr int MAX_CHANNELS = JS8DSP_MAX_CHANNELS;
+
+    struct Task {
+        uint8_t slot;    // Index into active_
+        uint16_t cand;   // First candidate
+        uint16_t count;  // Candidates decoded together; 1 in order_
+    };
+
+    // One receiver's decoders and its input, resampled to 12 kHz.
+    // Channel 0 also carries the stream.
+    struct Channel {
+        array<std::unique_ptr<JS8Decoder>, NUM_MODES> decoders;
+        Resampler resampler;    // Input to 12 kHz, unless already at that rate
+        vector<float> dd;
+        size_t dd_count = 0;
+
+        explicit Channel(int sample_rate) : resampler(sample_rate, JS8_RX_SAMPLE_RATE) {}
+    };
+
+    int sample_rate_;
+    Mode primary_mode_;
+    double resample_step_;
+    float threshold_;
+    js8dsp_ldpc_t ldpc_;
+    ThreadPool* pool_;
+
+    // OSD time allowed per decode pass, 0 when disabled
+    float osd_budget_ms_;
+    OsdBudget osd_;
+
+    // Time a decode pass may take before its remaining candidates are
+    // skipped, 0 for no limit, and when the current pass started
+    float time_budget_ms_;
+    Clock::time_point pass_start_;
+
+    // Most decode rounds a pass may take; 1 decodes without subtraction
+    int rounds_;
+
+    // Threading policy of decode passes. The pool's workers took it when
+    // they started; the calling thread takes it for each pass. Memory is
+    // locked once the policy is set, and again after any pass or change
+    // that allocated since, as of the allocation count then.
+    ThreadPolicy policy_;
+    uint64_t locked_allocations_;
+
+    // Shared with, and so declared before, the decoders
+    DecodeMetrics metrics_;
+
+    // Transient decode data of each worker, emptied at the start of every
+    // pass
+    vector<Arena> arenas_;
+
+    // Decode cache; messages reported this pass, by
+    // ((channel * NUM_MODES + mode) << 32 | hash), so that a duplicate
+    // decoded concurrently is not reported again. Whole-slot decodes are
+    // placed on the cache's clock by when they are made, relative to
+    // epoch_.
+    bool cache_enabled_;
+    vector<uint64_t> claimed_;
+    size_t claimed_count_;
+    std::chrono::steady_clock::time_point epoch_;
+
+    vector<std::unique_ptr<Channel>> channels_;
+    int decoder_count_;
+
+    // Every decoder created, by channel * NUM_MODES + mode, for readers of
+    // their spectra on other threads; decoders live as long as this
+    array<std::atomic<const JS8Decoder*>, NUM_MODES * MAX_CHANNELS> published_{};
+    array<JS8Decoder*, NUM_MODES * MAX_CHANNELS> active_;
+    int active_count_;
+
+    // Room for every candidate of every decoder
+    vector<Task> tasks_;
+    vector<Task> order_;
+
+    // Streaming input; a ring of the most recent 12 kHz samples, at least
+    // as long as the longest streamed period, indexed by stream position
+    int stream_submodes_;       // Submodes of the current or last stream, 0 if none
+    bool stream_running_;
+    vector<float> ring_;
+    size_t ring_mask_;
+    uint64_t written_;          // 12 kHz samples written since the stream started
+    uint64_t consumed_;         // Input samples consumed since the stream started
+    array<JS8Decoder*, NUM_MODES> streaming_;
+    int streaming_count_;
+
+    // Streamed decodes waiting to be polled; when full the oldest are
+    // dropped. Not kept while decodes are reported as events
+    vector<js8dsp_decoded_message_t> pending_;
+    size_t pending_head_;
+    size_t pending_count_;
+
+    // Decodes stream passes have made since stream_take_decoded
+    uint32_t stream_decoded_;
+
+    // Decode event reporting; workers emit concurrently, so calls into
+    // the callback are serialised
+    js8dsp_event_callback_t event_callback_;
+    void* event_user_data_;
+    bool sync_stats_;
+    std::mutex event_mutex_;
+
+    void emit(const js8dsp_event_t& event) {
+        std::lock_guard<std::mutex> lock(event_mutex_);
+        event_callback_(&event, event_user_data_);
+    }
+
+    void emit_decode_started(int submodes) {
+        if (!event_callback_) return;
+
+        js8dsp_event_t event;
+        event.type = JS8DSP_EVENT_DECODE_STARTED;
+        event.data.decode_started.submodes = static_cast<uint32_t>(submodes);
+        emit(event);
+    }
+
+    void emit_sync_state(js8dsp_sync_type_t type, const JS8Decoder& decoder, int cand) {
+        js8dsp_event_t event;
+        event.type = JS8DSP_EVENT_SYNC_STATE;
+        event.data.sync_state.type = type;
+        event.data.sync_state.mode = static_cast<int>(decoder.mode());
+        event.data.sync_state.frequency = decoder.candidate_freq(cand);
+        event.data.sync_state.dt = decoder.candidate_dt(cand);
+        event.data.sync_state.sync = decoder.candidate_sync(cand);
+        event.data.sync_state.channel = decoder.channel();
+        emit(event);
+    }
+
+    // Whether a decode is the first of its message this pass
+    bool claim(const JS8Decoder& decoder, int cand) {
+        const uint32_t hash = decoder.result_hash(cand);
+        if (!cache_enabled_ || hash == 0) return true;
+
+        const uint64_t key = (static_cast<uint64_t>(decoder.channel()) * NUM_MODES +
+                              static_cast<uint64_t>(decoder.mode())) << 32 | hash;
+        std::lock_guard<std::mutex> lock(event_mutex_);
+        for (size_t i = 0; i < claimed_count_; ++i) {
+            if (claimed_[i] == key) return false;
+        }
+        claimed_[claimed_count_++] = key;
+        return true;
+    }
+
+    // Report one decoded candidate as soon as its worker is done with it
+    void emit_candidate(const JS8Decoder& decoder, int cand) {
+        if (sync_stats_ && decoder.candidate_sync(cand) > ASYNCMIN) {
+            emit_sync_state(JS8DSP_SYNC_CANDIDATE, decoder, cand);
+        }
+        if (!decoder.has_result(cand) || !claim(decoder, cand)) return;
+
+        if (sync_stats_) emit_sync_state(JS8DSP_SYNC_DECODED, decoder, cand);
+
+        js8dsp_event_t event;
+        event.type = JS8DSP_EVENT_DECODED;
+        event.data.decoded = decoder.result(cand);
+        emit(event);
+    }
+
+    template <typename F>
+    void run(size_t count, F&& fn) {
+        if (pool_) {
+            pool_->parallel_for(count, fn);
+        } else {
+            for (size_t i = 0; i < count; ++i) fn(i, 0);
+        }
+    }
+
+    template <typename F>
+    void for_each_decoder(F&& fn) {
+        for (auto& channel : channels_) {
+            for (auto& decoder : channel->decoders) {
+                if (decoder) fn(*decoder);
+            }
+        }
+    }
+
+    // Now on the decode cache's clock: the stream position while
+    // streaming, otherwise 12 kHz samples since epoch_
+    uint64_t cache_clock() const {
+        if (stream_running_) return written_;
+
+        const auto elapsed = std::chrono::steady_clock::now() - epoch_;
+        return static_cast<uint64_t>(std::chrono::duration<double>(elapsed).count() * JS8_RX_SAMPLE_RATE);
+    }
+
+    // Saved decoder state: this header, then the tuning, the state of
+    // every decoder and the FFT wisdom, in host byte order
+    static constexpr uint32_t STATE_MAGIC = 0x5338534a;    // "JS8S"
+    static constexpr uint32_t STATE_VERSION = 1;
+
+    struct StateHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t payload;           // Bytes after the header
+        uint32_t checksum;          // Of those bytes
+    };
+
+    static int64_t wall_clock_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    static void write_state(StateWriter& out, const DecoderState& state) {
+        out.put(static_cast<uint8_t>(state.has_fit));
+        if (state.has_fit) out.put(state.fit);
+        out.put(static_cast<uint32_t>(state.seed_count));
+        out.write(state.seeds.data(), state.seed_count * sizeof(float));
+        out.put(static_cast<uint32_t>(state.decode_count));
+        for (int i = 0; i < state.decode_count; ++i) {
+            const DecoderState::Decode& decode = state.decodes[i];
+            out.put(decode.freq);
+            out.put(decode.age);
+            out.put(decode.hash);
+            out.put(decode.bits);
+        }
+    }
+
+    static bool read_state(StateReader& in, DecoderState& state) {
+        uint8_t has_fit;
+        uint32_t seeds, decodes;
+        if (!in.get(has_fit) || has_fit > 1) return false;
+        state.has_fit = has_fit != 0;
+        if (state.has_fit && !in.get(state.fit)) return false;
+
+        if (!in.get(seeds) || seeds > DecoderState::CACHE_SIZE ||
+            !in.read(state.seeds.data(), seeds * sizeof(float)) ||
+            !in.get(decodes) || decodes > DecoderState::CACHE_SIZE) {
+            return false;
+        }
+        state.seed_count = static_cast<int>(seeds);
+        state.decode_count = static_cast<int>(decodes);
+        for (int i = 0; i < state.decode_count; ++i) {
+            DecoderState::Decode& decode = state.decodes[i];
+            if (!in.get(decode.freq) || !in.get(decode.age) || !in.get(decode.hash) || !in.get(decode.bits)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Lock, or unlock, the memory of every decoder and every buffer a
+    // pass uses in RAM
+    MemoryLock lock_memory(bool lock) {
+        MemoryLock memory(lock);
+        memory.add(this, sizeof(*this));
+        memory.add(arenas_);
+        for (const Arena& arena : arenas_) arena.lock_memory(memory);
+        memory.add(claimed_);
+        memory.add(channels_);
+        for (const auto& channel : channels_) {
+            memory.add(channel.get(), sizeof(Channel));
+            channel->resampler.lock_memory(memory);
+            memory.add(channel->dd);
+        }
+        memory.add(tasks_);
+        memory.add(order_);
+        memory.add(ring_);
+        memory.add(pending_);
+        for_each_decoder([&memory](JS8Decoder& decoder) { decoder.lock_memory(memory); });
+        return memory;
+    }
+
+    // Lock what was allocated since memory was last locked. Buffers given
+    // up in the meantime stay locked until they are unmapped.
+    void relock_memory() {
+        const uint64_t allocations = metrics_.allocations.load(std::memory_order_relaxed);
+        if (!policy_.lock_memory || allocations == locked_allocations_) return;
+
+        locked_allocations_ = allocations;
+        metrics_.locked_bytes.store(lock_memory(true).bytes(), std::memory_order_relaxed);
+    }
+
+    // Create decoders for any newly requested submodes of the first
+    // channels; allocates only the first time a submode is used on a
+    // channel
+    void ensure_decoders(int submodes, int channels = 1) {
+        while (channels_.size() < static_cast<size_t>(channels)) {
+            channels_.push_back(std::make_unique<Channel>(sample_rate_));
+            DecodeMetrics::add(metrics_.allocations, 1);
+        }
+
+        for (int c = 0; c < channels; ++c) {
+            Channel& channel = *channels_[c];
+            for (int m = 0; m < NUM_MODES; ++m) {
+                if (!(submodes & (1 << m)) || channel.decoders[m]) continue;
+
+                const Mode mode = static_cast<Mode>(m);
+                auto decoder = make_decoder(mode, c, metrics_);
+                decoder->set_workers(pool_ ? pool_->size() : 1);
+                decoder->set_threshold(threshold_);
+                decoder->set_ldpc_decoder(ldpc_);
+                decoder->set_osd_budget(&osd_);
+                decoder->set_cache_enabled(cache_enabled_);
+                DecodeMetrics::add(metrics_.allocations, 1);
+                if (channel.dd.size() < decoder->input_samples()) {
+                    channel.dd.resize(decoder->input_samples());
+                    DecodeMetrics::add(metrics_.allocations, 1);
+                }
+                channel.decoders[m] = std::move(decoder);
+                published_[c * NUM_MODES + m].store(channel.decoders[m].get(), std::memory_order_release);
+                ++decoder_count_;
+            }
+        }
+
+        const size_t tasks = static_cast<size_t>(decoder_count_) * MAX_SLOT_CANDIDATES;
+        if (tasks_.size() < tasks) {
+            tasks_.resize(tasks);
+            order_.resize(tasks);
+            claimed_.resize(tasks);
+            DecodeMetrics::add(metrics_.allocations, 1);
+        }
+    }
+
+    // Bring one channel's input, every stride-th sample from in, to the
+    // 12 kHz rate all JS8 mode parameters assume, converting float or
+    // int16 samples as they are read
+    template <typename Sample>
+    void resample_input(Channel& channel, const Sample* in, size_t frames, size_t stride, size_t max_samples) {
+        const auto start = Clock::now();
+        size_t count = 0;
+
+        if (sample_rate_ == JS8_RX_SAMPLE_RATE) {
+            count = std::min(frames, max_samples);
+            convert_samples(in, stride, channel.dd.data(), count);
+        } else {
+            size_t consumed = 0;
+            channel.resampler.reset();
+            count = channel.resampler.process(in, frames, stride, channel.dd.data(), max_samples, consumed);
+        }
+
+        channel.dd_count = count;
+        metrics_.charge(JS8DSP_STAGE_INGEST, start);
+    }
+
+    // Queue tasks for the cluster heads, or else the neighbours, of the
+    // current round of every decoder in active_ at tasks_[first],
+    // strongest first; returns the end of the queue
+    size_t schedule(size_t first, bool heads) {
+        size_t end = first;
+        for (int slot = 0; slot < active_count_; ++slot) {
+            const int heads_end = active_[slot]->round_start() + active_[slot]->head_count();
+            const int begin = heads ? active_[slot]->round_start() : heads_end;
+            const int candidates = heads ? heads_end : active_[slot]->candidate_count();
+            const int batch = active_[slot]->batch_size();
+            for (int cand = begin; cand < candidates; cand += batch) {
+                tasks_[end++] = Task{static_cast<uint8_t>(slot), static_cast<uint16_t>(cand),
+                                     static_cast<uint16_t>(std::min(batch, candidates - cand))};
+            }
+        }
+
+        // Each decoder ranks its own candidates, so a task's first is its
+        // strongest
+        std::sort(tasks_.begin() + first, tasks_.begin() + end, [this](const Task& a, const Task& b) {
+            const float sa = active_[a.slot]->candidate_snr(a.cand);
+            const float sb = active_[b.slot]->candidate_snr(b.cand);
+            if (sa != sb) return sa > sb;
+            if (a.slot != b.slot) return a.slot < b.slot;
+            return a.cand < b.cand;
+        });
+
+        return end;
+    }
+
+    // Decode the queued tasks_[begin, end) in parallel, every worker
+    // taking the most promising left first; once the pass has used its
+    // time budget the rest are skipped
+    void run_tasks(size_t begin, size_t end) {
+        const size_t count = end - begin;
+        const bool limited = time_budget_ms_ > 0.0f;
+        const auto deadline = pass_start_ + std::chrono::duration_cast<Clock::duration>(
+                                                std::chrono::duration<float, std::milli>(time_budget_ms_));
+
+        run(count, [this, begin, count, limited, deadline](size_t index, size_t worker) {
+            const Task& task = tasks_[begin + (pool_ ? pool_->rank(index, count) : index)];
+            if (limited && Clock::now() >= deadline) {
+                DecodeMetrics::add(metrics_.pass.skipped, task.count);
+                return;
+            }
+
+            active_[task.slot]->decode(task.cand, task.count, worker, arenas_[worker]);
+            if (event_callback_) {
+                for (int cand = task.cand; cand < task.cand + task.count; ++cand) {
+                    emit_candidate(*active_[task.slot], cand);
+                }
+            }
+        });
+    }
+
+    // Decode the candidates of the prepared decoders in active_ as one
+    // batch, most promising first, leaving the results in order_ sorted by
+    // (channel, frequency, time, submode) so that output does not depend
+    // on how work was scheduled; returns the number of results
+    int decode_prepared() {
+        if (event_callback_ && sync_stats_) {
+            for (int slot = 0; slot < active_count_; ++slot) {
+                js8dsp_event_t event;
+                event.type = JS8DSP_EVENT_SYNC_START;
+                event.data.sync_start.mode = static_cast<int>(active_[slot]->mode());
+                event.data.sync_start.position = active_[slot]->slot_start();
+                event.data.sync_start.size = static_cast<uint32_t>(active_[slot]->slot_samples());
+                event.data.sync_start.channel = active_[slot]->channel();
+                emit(event);
+            }
+        }
+
+        osd_.spent_ns = 0;
+        claimed_count_ = 0;
+        for (Arena& arena : arenas_) {
+            if (arena.reset()) DecodeMetrics::add(metrics_.allocations, 1);
+        }
+
+        // Cluster heads first, then the neighbours that might still be
+        // another signal. Each further round subtracts what the last one
+        // decoded and revisits only the candidates that overlapped it,
+        // until a round decodes nothing new.
+        size_t task_count = 0;
+        for (int round = 1;; ++round) {
+            const size_t head_tasks = schedule(task_count, true);
+            run_tasks(task_count, head_tasks);
+            for (int slot = 0; slot < active_count_; ++slot) active_[slot]->prune_neighbours();
+            task_count = schedule(head_tasks, false);
+            run_tasks(head_tasks, task_count);
+            if (round >= rounds_) break;
+
+            std::atomic<int> queued{0};
+            run(static_cast<size_t>(active_count_), [this, &queued](size_t slot, size_t worker) {
+                queued.fetch_add(active_[slot]->next_round(worker), std::memory_order_relaxed);
+            });
+            if (queued.load() == 0) break;
+            DecodeMetrics::add(metrics_.pass.rounds, 1);
+        }
+
+        int valid_count = 0;
+        for (size_t i = 0; i < task_count; ++i) {
+            const Task& task = tasks_[i];
+            for (int cand = task.cand; cand < task.cand + task.count; ++cand) {
+                if (active_[task.slot]->has_result(cand)) {
+                    order_[valid_count++] = Task{task.slot, static_cast<uint16_t>(cand), 1};
+                }
+            }
+        }
+
+        std::sort(order_.begin(), order_.begin() + valid_count, [this](const Task& a, const Task& b) {
+            const JS8Decoder& da = *active_[a.slot];
+            const JS8Decoder& db = *active_[b.slot];
+            if (da.channel() != db.channel()) return da.channel() < db.channel();
+            float fa = da.candidate_freq(a.cand);
+            float fb = db.candidate_freq(b.cand);
+            if (fa != fb) return fa < fb;
+            uint32_t ta = da.result(a.cand).timestamp;
+            uint32_t tb = db.result(b.cand).timestamp;
+            if (ta != tb) return ta < tb;
+            return da.mode() < db.mode();
+        });
+
+        // Keep the first result of each message and remember them for
+        // later passes
+        if (cache_enabled_) {
+            int kept = 0;
+            for (int i = 0; i < valid_count; ++i) {
+                const Task task = order_[i];
+                const uint32_t hash = active_[task.slot]->result_hash(task.cand);
+                bool duplicate = false;
+                for (int j = 0; j < kept && hash != 0 && !duplicate; ++j) {
+                    duplicate = order_[j].slot == task.slot &&
+                                active_[task.slot]->result_hash(order_[j].cand) == hash;
+                }
+                if (!duplicate) order_[kept++] = task;
+            }
+            valid_count = kept;
+
+            for (int slot = 0; slot < active_count_; ++slot) active_[slot]->clear_seeds();
+            for (int i = 0; i < valid_count; ++i) active_[order_[i].slot]->remember(order_[i].cand);
+        }
+
+        size_t arena_peak = 0;
+        size_t arena_bytes = 0;
+        for (const Arena& arena : arenas_) {
+            arena_peak = std::max(arena_peak, arena.peak());
+            arena_bytes += arena.capacity();
+        }
+        metrics_.add_arena(arena_peak, arena_bytes);
+        const auto elapsed = Clock::now() - pass_start_;
+        metrics_.add_latency(elapsed);
+        metrics_.finish_pass();
+        relock_memory();
+
+        if (event_callback_) {
+            js8dsp_event_t event;
+            event.type = JS8DSP_EVENT_DECODE_FINISHED;
+            event.data.decode_finished.decoded = static_cast<uint32_t>(valid_count);
+            event.data.decode_finished.elapsed_ns = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            emit(event);
+        }
+
+        return valid_count;
+    }
+
+    const js8dsp_decoded_message_t& ordered_result(int i) const {
+        return active_[order_[i].slot]->result(order_[i].cand);
+    }
+
+    // Append up to count input samples to the stream ring, stopping at the
+    // 12 kHz stream position limit; returns the number of input samples used
+    template <typename Sample>
+    size_t stream_write(const Sample* samples, size_t count, uint64_t limit) {
+        const auto start = Clock::now();
+
+        if (sample_rate_ == JS8_RX_SAMPLE_RATE) {
+            size_t n = static_cast<size_t>(std::min<uint64_t>(count, limit - written_));
+            const size_t offset = static_cast<size_t>(written_ & ring_mask_);
+            const size_t first = std::min(n, ring_mask_ + 1 - offset);
+            convert_samples(samples, ring_.data() + offset, first);
+            convert_samples(samples + first, ring_.data(), n - first);
+            written_ += n;
+            consumed_ += n;
+            metrics_.charge(JS8DSP_STAGE_INGEST, start);
+            return n;
+        }
+
+        // The resampler carries its filter history across calls; write
+        // around the ring until the limit or the input runs out
+        size_t used = 0;
+        while (written_ < limit) {
+            const size_t offset = static_cast<size_t>(written_ & ring_mask_);
+            const size_t span = static_cast<size_t>(std::min<uint64_t>(limit - written_, ring_mask_ + 1 - offset));
+            size_t consumed = 0;
+            const size_t produced = channels_[0]->resampler.process(samples + used, count - used, ring_.data() + offset, span,
+                                                       consumed);
+            used += consumed;
+            written_ += produced;
+            if (produced < span) break;
+        }
+
+        consumed_ += used;
+        metrics_.charge(JS8DSP_STAGE_INGEST, start);
+        return used;
+    }
+
+    // Decode every streamed submode whose slot ends at the current stream
+    // position, queue the results unless they went out as events, and
+    // start their next slots
+    void stream_finish_slots() {
+        pass_start_ = Clock::now();
+        active_count_ = 0;
+        for (int i = 0; i < streaming_count_; ++i) {
+            if (streaming_[i]->slot_end() == written_) active_[active_count_++] = streaming_[i];
+        }
+        if (active_count_ == 0) return;
+
+        const ThreadPolicyScope policy(policy_);
+        int submodes = 0;
+        for (int slot = 0; slot < active_count_; ++slot) {
+            submodes |= 1 << static_cast<int>(active_[slot]->mode());
+        }
+        emit_decode_started(submodes);
+
+        run(active_count_, [this](size_t slot, size_t) {
+            active_[slot]->stream_finish(ring_.data(), ring_mask_);
+        });
+
+        int valid_count = decode_prepared();
+        stream_decoded_ += static_cast<uint32_t>(valid_count);
+        for (int i = 0; i < valid_count && !event_callback_; ++i) {
+            if (pending_count_ == pending_.size()) {
+                pending_head_ = (pending_head_ + 1) % pending_.size();
+                --pending_count_;
+            }
+            pending_[(pending_head_ + pending_count_) % pending_.size()] = ordered_result(i);
+            ++pending_count_;
+        }
+
+        for (int slot = 0; slot < active_count_; ++slot) {
+            active_[slot]->stream_reset(written_);
+        }
+    }
+
+public:
+    MultiModeDecoder(int sample_rate, int mode)
+        : sample_rate_(sample_rate), primary_mode_(static_cast<Mode>(mode)),
+          resample_step_(static_cast<double>(sample_rate) / JS8_RX_SAMPLE_RATE),
+          threshold_(-20.0f), ldpc_(JS8DSP_LDPC_BP_FLOODING), pool_(nullptr), osd_budget_ms_(0.0f),
+          time_budget_ms_(0.0f), rounds_(1), locked_allocations_(0), cache_enabled_(false), claimed_count_(0), epoch_(std::chrono::steady_clock::now()),
+          decoder_count_(0), active_count_(0),
+          stream_submodes_(0), stream_running_(false), ring_mask_(0), written_(0), consumed_(0),
+          streaming_count_(0), pending_head_(0), pending_count_(0), stream_decoded_(0),
+          event_callback_(nullptr), event_user_data_(nullptr), sync_stats_(false) {
+        arenas_.emplace_back();
+        ensure_decoders(1 << mode);
+    }
+
+    // Start, or restart, a stream of the given submodes; slots of every
+    // submode begin at the next sample pushed
+    int stream_start(int submodes) {
+        if (submodes <= 0 || (submodes & ~ALL_SUBMODES)) return -1;
+
+        auto& stream_decoders = channels_[0]->decoders;
+        try {
+            ensure_decoders(submodes);
+
+            size_t longest = 0;
+            for (int m = 0; m < NUM_MODES; ++m) {
+                if (submodes & (1 << m)) longest = std::max(longest, stream_decoders[m]->input_samples());
+            }
+
+            size_t capacity = 1;
+            while (capacity < longest) capacity <<= 1;
+            if (ring_.size() < capacity) {
+                ring_.resize(capacity);
+                DecodeMetrics::add(metrics_.allocations, 1);
+            }
+            ring_mask_ = ring_.size() - 1;
+
+            if (pending_.empty()) {
+                pending_.resize(NUM_MODES * NMAXCAND);
+                DecodeMetrics::add(metrics_.allocations, 1);
+            }
+        } catch (const std::bad_alloc&) {
+            stream_running_ = false;
+            return -1;
+        }
+
+        // Stream times restart, so cached decodes no longer line up
+        for_each_decoder([](JS8Decoder& decoder) { decoder.clear_cache(); });
+
+        streaming_count_ = 0;
+        for (int m = 0; m < NUM_MODES; ++m) {
+            if (submodes & (1 << m)) {
+                streaming_[streaming_count_++] = stream_decoders[m].get();
+                stream_decoders[m]->stream_reset(0);
+            }
+        }
+
+        stream_submodes_ = submodes;
+        stream_running_ = true;
+        written_ = 0;
+        consumed_ = 0;
+        channels_[0]->resampler.reset();
+        pending_head_ = 0;
+        pending_count_ = 0;
+        return 0;
+    }
+
+    // Feed audio into the stream. Symbol spectra are computed as soon as
+    // each frame is complete; sync and LDPC decoding run when a submode's
+    // slot ends. Returns the number of decodes waiting to be polled.
+    template <typename Sample>
+    int stream_push(const Sample* samples, size_t count) {
+        if (!samples) return -1;
+        if (!stream_running_) {
+            int submodes = stream_submodes_ ? stream_submodes_ : 1 << static_cast<int>(primary_mode_);
+            if (stream_start(submodes) < 0) return -1;
+        }
+
+        while (count > 0) {
+            uint64_t boundary = UINT64_MAX;
+            for (int i = 0; i < streaming_count_; ++i) {
+                boundary = std::min(boundary, streaming_[i]->slot_end());
+            }
+
+            size_t used = stream_write(samples, count, boundary);
+            samples += used;
+            count -= used;
+
+            for (int i = 0; i < streaming_count_; ++i) {
+                streaming_[i]->stream_advance(ring_.data(), ring_mask_, written_);
+            }
+
+            if (written_ == boundary) {
+                stream_finish_slots();
+            } else if (used == 0) {
+                break;
+            }
+        }
+
+        return static_cast<int>(pending_count_);
+    }
+
+    // Decodes stream passes have made since the last call, polled or not
+    uint32_t stream_take_decoded() {
+        const uint32_t decoded = stream_decoded_;
+        stream_decoded_ = 0;
+        return decoded;
+    }
+
+    // Take up to max_messages streamed decodes, oldest first
+    int stream_poll(js8dsp_decoded_message_t* messages, int max_messages) {
+        if (!messages || max_messages <= 0) return -1;
+
+        int count = static_cast<int>(std::min<size_t>(pending_count_, max_messages));
+        for (int i = 0; i < count; ++i) {
+            messages[i] = pending_[pending_head_];
+            pending_head_ = (pending_head_ + 1) % pending_.size();
+        }
+        pending_count_ -= count;
+
+        return count;
+    }
+
+    // Decode one slot of every channel in the given submodes. Channel c
+    // of interleaved input is every channels-th sample from c; of planar
+    // input, the frames samples from c * frames.
+    template <typename Sample>
+    int decode_channels(const Sample* audio_buffer, size_t frames, int channels, js8dsp_layout_t layout,
+                        int submodes, js8dsp_decoded_message_t* messages, int max_messages) {
+
+        if (!audio_buffer || (messages ? max_messages <= 0 : max_messages != 0) ||
+            submodes <= 0 || (submodes & ~ALL_SUBMODES) || channels < 1 || channels > MAX_CHANNELS ||
+            (layout != JS8DSP_LAYOUT_INTERLEAVED && layout != JS8DSP_LAYOUT_PLANAR)) {
+            return -1;
+        }
+
+        const ThreadPolicyScope policy(policy_);
+        pass_start_ = Clock::now();
+        try {
+            ensure_decoders(submodes, channels);
+        } catch (const std::bad_alloc&) {
+            return -1;
+        }
+
+        // Whole-slot decodes reuse the per-submode state a stream builds
+        // up, so any running stream restarts on its next push
+        if (stream_running_) {
+            for_each_decoder([](JS8Decoder& decoder) { decoder.clear_cache(); });
+        }
+        stream_running_ = false;
+
+        // The buffer is taken to end now
+        const uint64_t now = cache_clock();
+        const uint64_t duration = static_cast<uint64_t>(frames / resample_step_);
+        const uint64_t time = now - std::min(now, duration);
+
+        active_count_ = 0;
+        size_t max_samples = 0;
+        for (int c = 0; c < channels; ++c) {
+            for (int m = 0; m < NUM_MODES; ++m) {
+                if (submodes & (1 << m)) {
+                    active_[active_count_++] = channels_[c]->decoders[m].get();
+                    max_samples = std::max(max_samples, channels_[c]->decoders[m]->input_samples());
+                }
+            }
+        }
+
+        emit_decode_started(submodes);
+
+        const bool interleaved = layout == JS8DSP_LAYOUT_INTERLEAVED;
+        const size_t stride = interleaved ? static_cast<size_t>(channels) : 1;
+        run(channels, [&](size_t c, size_t) {
+            const Sample* in = audio_buffer + (interleaved ? c : c * frames);
+            resample_input(*channels_[c], in, frames, stride, max_samples);
+        });
+
+        // Per-channel and per-submode candidate search and baseband transform
+        run(active_count_, [this, time](size_t slot, size_t) {
+            const Channel& channel = *channels_[active_[slot]->channel()];
+            active_[slot]->prepare(channel.dd.data(), channel.dd_count, time);
+        });
+
+        // Decode the candidates of all channels and submodes as one batch
+        int valid_count = decode_prepared();
+        if (!messages) return valid_count;
+
+        int decoded_count = std::min(valid_count, max_messages);
+        for (int i = 0; i < decoded_count; ++i) {
+            messages[i] = ordered_result(i);
+        }
+
+        return decoded_count;
+    }
+
+    template <typename Sample>
+    int decode(const Sample* audio_buffer, size_t buffer_size, int submodes,
+               js8dsp_decoded_message_t* messages, int max_messages) {
+        return decode_channels(audio_buffer, buffer_size, 1, JS8DSP_LAYOUT_INTERLEAVED, submodes,
+                               messages, max_messages);
+    }
+
+    template <typename Sample>
+    int decode(const Sample* audio_buffer, size_t buffer_size,
+               js8dsp_decoded_message_t* messages, int max_messages) {
+        return decode(audio_buffer, buffer_size, 1 << static_cast<int>(primary_mode_),
+                      messages, max_messages);
+    }
+
+    // Attach a worker pool, or detach with nullptr. Scratch space and an
+    // arena for each worker are allocated here rather than during decode.
+    void set_thread_pool(ThreadPool* pool) {
+        pool_ = pool;
+        const size_t workers = pool ? pool->size() : 1;
+        if (arenas_.size() != workers) {
+            arenas_.resize(workers);
+            DecodeMetrics::add(metrics_.allocations, 1);
+        }
+        for_each_decoder([this, pool](JS8Decoder& decoder) {
+            decoder.set_workers(pool ? pool->size() : 1);
+            DecodeMetrics::add(metrics_.allocations, 1);
+        });
+        relock_memory();
+    }
+
+    // Take a threading policy for later passes; the pool's workers must
+    // have taken it already. Returns 0, or an errno value if the calling
+    // thread cannot take the policy or memory cannot be locked, in which
+    // case the default policy is left in place.
+    int set_thread_policy(const ThreadPolicy& policy) {
+        if (policy_.lock_memory) lock_memory(false);
+        policy_ = ThreadPolicy();
+        metrics_.locked_bytes.store(0, std::memory_order_relaxed);
+
+        int error = ThreadPolicyScope(policy).error();
+        if (error == 0 && policy.lock_memory) {
+            locked_allocations_ = metrics_.allocations.load(std::memory_order_relaxed);
+            const MemoryLock memory = lock_memory(true);
+            error = memory.error();
+            if (error == 0) {
+                metrics_.locked_bytes.store(memory.bytes(), std::memory_order_relaxed);
+            } else {
+                lock_memory(false);
+            }
+        }
+
+        if (error == 0) policy_ = policy;
+        return error;
+    }
+
+    void set_event_callback(js8dsp_event_callback_t callback, void* user_data, bool sync_stats) {
+        event_callback_ = callback;
+        event_user_data_ = user_data;
+        sync_stats_ = sync_stats;
+    }
+
+    void set_threshold(float threshold) {
+        threshold_ = threshold;
+        for_each_decoder([threshold](JS8Decoder& decoder) { decoder.set_threshold(threshold); });
+    }
+
+    void set_ldpc_decoder(js8dsp_ldpc_t ldpc) {
+        ldpc_ = ldpc;
+        for_each_decoder([ldpc](JS8Decoder& decoder) { decoder.set_ldpc_decoder(ldpc); });
+    }
+
+    void set_decode_cache(bool enabled) {
+        cache_enabled_ = enabled;
+        for_each_decoder([enabled](JS8Decoder& decoder) { decoder.set_cache_enabled(enabled); });
+    }
+
+    void set_osd_budget(float budget_ms) {
+        osd_budget_ms_ = budget_ms;
+        osd_.budget_ns = static_cast<int64_t>(budget_ms * 1e6);
+    }
+
+    void set_time_budget(float budget_ms) {
+        time_budget_ms_ = budget_ms;
+    }
+
+    void set_decode_rounds(int rounds) {
+        rounds_ = rounds;
+    }
+
+    void get_osd_stats(float* budget_ms, uint32_t* attempts, uint32_t* decoded, uint32_t* skipped) const {
+        *budget_ms = osd_budget_ms_;
+        *attempts = osd_.attempts.load();
+        *decoded = osd_.decoded.load();
+        *skipped = osd_.skipped.load();
+    }
+
+    uint64_t get_spectrum(int mode, int channel, const js8dsp_spectrum_layout_t& layout,
+                          void* power, void* baseline) const {
+        if (mode < 0 || mode >= NUM_MODES || channel < 0 || channel >= MAX_CHANNELS) return 0;
+
+        const JS8Decoder* decoder = published_[channel * NUM_MODES + mode].load(std::memory_order_acquire);
+        return decoder ? decoder->read_spectrum(layout, power, baseline) : 0;
+    }
+
+    void get_metrics(js8dsp_metrics_t* metrics) const {
+        auto load = [](const std::atomic<uint64_t>& counter) { return counter.load(std::memory_order_relaxed); };
+
+        metrics->passes = load(metrics_.passes);
+        for (int stage = 0; stage < JS8DSP_STAGE_COUNT; ++stage) {
+            metrics->stage_total_ns[stage] = load(metrics_.total.stage_ns[stage]);
+            metrics->stage_last_ns[stage] = load(metrics_.last.stage_ns[stage]);
+        }
+        metrics->candidates_found = load(metrics_.total.found);
+        metrics->candidates_attempted = load(metrics_.total.attempted);
+        metrics->candidates_decoded = load(metrics_.total.decoded);
+        metrics->last_candidates_found = static_cast<uint32_t>(load(metrics_.last.found));
+        metrics->last_candidates_attempted = static_cast<uint32_t>(load(metrics_.last.attempted));
+        metrics->last_candidates_decoded = static_cast<uint32_t>(load(metrics_.last.decoded));
+        metrics->candidates_suppressed = load(metrics_.total.suppressed);
+        metrics->candidates_skipped = load(metrics_.total.skipped);
+        metrics->last_candidates_suppressed = static_cast<uint32_t>(load(metrics_.last.suppressed));
+        metrics->last_candidates_skipped = static_cast<uint32_t>(load(metrics_.last.skipped));
+        for (int i = 0; i < JS8DSP_LDPC_ITERATION_BINS; ++i) {
+            metrics->ldpc_iterations[i] = load(metrics_.ldpc_iterations[i]);
+        }
+        metrics->ldpc_failures = load(metrics_.ldpc_failures);
+        metrics->allocations = load(metrics_.allocations);
+        metrics->arena_bytes = load(metrics_.arena_bytes);
+        metrics->arena_peak_bytes = load(metrics_.arena_peak);
+        metrics->last_arena_peak_bytes = load(metrics_.last_arena_peak);
+        metrics->decode_rounds = load(metrics_.total.rounds);
+        metrics->signals_subtracted = load(metrics_.total.subtracted);
+        metrics->last_decode_rounds = static_cast<uint32_t>(load(metrics_.last.rounds));
+        metrics->last_signals_subtracted = static_cast<uint32_t>(load(metrics_.last.subtracted));
+
+        // Ranked over the window of recent passes
+        const uint64_t passes = metrics->passes;
+        const size_t window = static_cast<size_t>(std::min<uint64_t>(passes, JS8DSP_LATENCY_WINDOW));
+        array<uint64_t, JS8DSP_LATENCY_WINDOW> latency;
+        for (size_t i = 0; i < window; ++i) latency[i] = load(metrics_.latency_ns[i]);
+        std::nth_element(latency.begin(), latency.begin() + window / 2, latency.begin() + window);
+        metrics->last_pass_ns = passes ? load(metrics_.latency_ns[(passes - 1) % JS8DSP_LATENCY_WINDOW]) : 0;
+        metrics->median_pass_ns = window ? latency[window / 2] : 0;
+        metrics->worst_pass_ns = window ? *std::max_element(latency.begin(), latency.begin() + window) : 0;
+        metrics->max_pass_ns = load(metrics_.max_latency_ns);
+        metrics->locked_bytes = load(metrics_.locked_bytes);
+    }
+
+    // Write what a later process can continue from into the buffer: the
+    // tuning, every decoder's noise floor fit, seeds and decode cache, and
+    // the FFT planner's wisdom. Returns the size of the state; nothing is
+    // written unless it fits.
+    size_t save_state(void* buffer, size_t size) const {
+        StateWriter out(buffer, size);
+        StateHeader header{STATE_MAGIC, STATE_VERSION, 0, 0};
+        out.put(header);
+        out.put(wall_clock_ns());
+
+        out.put(threshold_);
+        out.put(static_cast<int32_t>(ldpc_));
+        out.put(static_cast<uint8_t>(cache_enabled_));
+        out.put(osd_budget_ms_);
+        out.put(time_budget_ms_);
+        out.put(static_cast<int32_t>(rounds_));
+
+        const uint64_t now = cache_clock();
+        DecoderState state;
+        out.put(static_cast<uint32_t>(decoder_count_));
+        for (const auto& channel : channels_) {
+            for (const auto& decoder : channel->decoders) {
+                if (!decoder) continue;
+
+                out.put(static_cast<uint8_t>(decoder->channel()));
+                out.put(static_cast<uint8_t>(decoder->mode()));
+                decoder->save_state(state, now);
+                write_state(out, state);
+            }
+        }
+
+        const std::string wisdom = export_fft_wisdom();
+        out.put(static_cast<uint32_t>(wisdom.size()));
+        out.write(wisdom.data(), wisdom.size());
+
+        if (out.fits()) {
+            unsigned char* bytes = static_cast<unsigned char*>(buffer);
+            header.payload = static_cast<uint32_t>(out.used() - sizeof(header));
+            header.checksum = state_checksum(bytes + sizeof(header), header.payload);
+            std::memcpy(bytes, &header, sizeof(header));
+        }
+        return out.used();
+    }
+
+    // Continue from a state written by save_state, creating the decoders
+    // it has state for. Cached decodes are aged by the time since it was
+    // saved. Returns 0, or -1 if the buffer is not a whole state of this
+    // version, in which case nothing is changed, or its decoders cannot
+    // all be created, in which case those that were are kept, idle, and
+    // the tuning and caches are left as they were.
+    int load_state(const void* buffer, size_t size) {
+        StateReader in(buffer, size);
+        StateHeader header;
+        if (!in.get(header) || header.magic != STATE_MAGIC || header.version != STATE_VERSION ||
+            header.payload != in.remaining() ||
+            header.checksum != state_checksum(in.position(), in.remaining())) {
+            return -1;
+        }
+
+        int64_t saved_at;
+        float threshold, osd_budget_ms, time_budget_ms;
+        int32_t ldpc, rounds;
+        uint8_t cache_enabled;
+        uint32_t count;
+        if (!in.get(saved_at) || !in.get(threshold) || !in.get(ldpc) || !in.get(cache_enabled) ||
+            !in.get(osd_budget_ms) || !in.get(time_budget_ms) || !in.get(rounds) || !in.get(count) ||
+            !std::isfinite(threshold) || (ldpc != JS8DSP_LDPC_BP_FLOODING && ldpc != JS8DSP_LDPC_MIN_SUM_LAYERED) ||
+            cache_enabled > 1 || !(osd_budget_ms >= 0.0f) || !(time_budget_ms >= 0.0f) ||
+            rounds < 1 || rounds > JS8DSP_MAX_DECODE_ROUNDS || count > NUM_MODES * MAX_CHANNELS) {
+            return -1;
+        }
+
+        vector<DecoderState> states;
+        vector<int> slots;
+        std::string wisdom;
+        try {
+            states.resize(count);
+            slots.resize(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                uint8_t channel, mode;
+                if (!in.get(channel) || !in.get(mode) || channel >= MAX_CHANNELS || mode >= NUM_MODES ||
+                    !read_state(in, states[i])) {
+                    return -1;
+                }
+                slots[i] = channel * NUM_MODES + mode;
+            }
+
+            uint32_t wisdom_size;
+            if (!in.get(wisdom_size) || wisdom_size != in.remaining()) return -1;
+            wisdom.assign(reinterpret_cast<const char*>(in.position()), wisdom_size);
+
+            for (int slot : slots) ensure_decoders(1 << (slot % NUM_MODES), slot / NUM_MODES + 1);
+        } catch (const std::bad_alloc&) {
+            return -1;
+        }
+
+        set_threshold(threshold);
+        set_ldpc_decoder(static_cast<js8dsp_ldpc_t>(ldpc));
+        set_decode_cache(cache_enabled != 0);
+        set_osd_budget(osd_budget_ms);
+        set_time_budget(time_budget_ms);
+        set_decode_rounds(rounds);
+
+        // Move the whole-slot clock back far enough to place the oldest
+        // decode, which a stream's clock cannot be
+        const int64_t since_ns = std::max<int64_t>(0, wall_clock_ns() - saved_at);
+        const uint64_t elapsed = static_cast<uint64_t>(since_ns * 1e-9 * JS8_RX_SAMPLE_RATE);
+        uint64_t oldest = 0;
+        for (DecoderState& state : states) {
+            for (int i = 0; i < state.decode_count; ++i) {
+                state.decodes[i].age += elapsed;
+                oldest = std::max(oldest, state.decodes[i].age);
+            }
+        }
+        const uint64_t now = cache_clock();
+        if (!stream_running_ && oldest > now) {
+            epoch_ -= std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(static_cast<double>(oldest - now + 1) / JS8_RX_SAMPLE_RATE));
+        }
+
+        const uint64_t restored = cache_clock();
+        for (uint32_t i = 0; i < count; ++i) {
+            channels_[slots[i] / NUM_MODES]->decoders[slots[i] % NUM_MODES]->restore_state(states[i], restored);
+        }
+
+        import_fft_wisdom(wisdom);
+        relock_memory();
+        return 0;
+    }
+};
+
+} // namespace JS8DSP
+
+// C API implementation
+extern "C" {
+
+struct js8_decoder_context {
+    JS8DSP::MultiModeDecoder* decoder;
+};
+
+js8_decoder_t* js8_decoder_create(int sample_rate, int mode) {
+    try {
+        auto ctx = new js8_decoder_context;
+        ctx->decoder = new JS8DSP::MultiModeDecoder(sample_rate, mode);
+        return reinterpret_cast<js8_decoder_t*>(ctx);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void js8_decoder_destroy(js8_decoder_t* decoder) {
+    if (!decoder) return;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    delete ctx->decoder;
+    delete ctx;
+}
+
+int js8_decoder_decode(js8_decoder_t* decoder,
+                      const float* audio_buffer,
+                      size_t buffer_size,
+                      js8dsp_decoded_message_t* messages,
+                      int max_messages) {
+    if (!decoder) return -1;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    return ctx->decoder->decode(audio_buffer, buffer_size,
+                                messages, max_messages);
+}
+
+int js8_decoder_decode_multi(js8_decoder_t* decoder,
+                             const float* audio_buffer,
+                             size_t buffer_size,
+                             int submodes,
+                             js8dsp_decoded_message_t* messages,
+                             int max_messages) {
+    if (!decoder) return -1;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    return ctx->decoder->decode(audio_buffer, buffer_size, submodes,
+                                messages, max_messages);
+}
+
+int js8_decoder_decode_s16(js8_decoder_t* decoder,
+                           const int16_t* audio_buffer,
+                           size_t buffer_size,
+                           js8dsp_decoded_message_t* messages,
+                           int max_messages) {
+    if (!decoder) return -1;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    return ctx->decoder->decode(audio_buffer, buffer_size,
+                                messages, max_messages);
+}
+
+int js8_decoder_decode_multi_s16(js8_decoder_t* decoder,
+                                 const int16_t* audio_buffer,
+                                 size_t buffer_size,
+                                 int submodes,
+                                 js8dsp_decoded_message_t* messages,
+                                 int max_messages) {
+    if (!decoder) return -1;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    return ctx->decoder->decode(audio_buffer, buffer_size, submodes,
+                                messages, max_messages);
+}
+
+int js8_decoder_decode_channels(js8_decoder_t* decoder,
+                                const float* audio_buffer,
+                                size_t frames,
+                                int channels,
+                                js8dsp_layout_t layout,
+                                int submodes,
+                                js8dsp_decoded_message_t* messages,
+                                int max_messages) {
+    if (!decoder) return -1;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    return ctx->decoder->decode_channels(audio_buffer, frames, channels, layout, submodes,
+                                         messages, max_messages);
+}
+
+int js8_decoder_decode_channels_s16(js8_decoder_t* decoder,
+                                    const int16_t* audio_buffer,
+                                    size_t frames,
+                                    int channels,
+                                    js8dsp_layout_t layout,
+                                    int submodes,
+                                    js8dsp_decoded_message_t* messages,
+                                    int max_messages) {
+    if (!decoder) return -1;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    return ctx->decoder->decode_channels(audio_buffer, frames, channels, layout, submodes,
+                                         messages, max_messages);
+}
+
+int js8_decoder_stream_start(js8_decoder_t* decoder, int submodes) {
+    if (!decoder) return -1;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    return ctx->decoder->stream_start(submodes);
+}
+
+int js8_decoder_stream_push(js8_decoder_t* decoder,
+                            const float* samples,
+                            size_t sample_count) {
+    if (!decoder) return -1;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    return ctx->decoder->stream_push(samples, sample_count);
+}
+
+int js8_decoder_stream_push_s16(js8_decoder_t* decoder,
+                                const int16_t* samples,
+                                size_t sample_count) {
+    if (!decoder) return -1;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    return ctx->decoder->stream_push(samples, sample_count);
+}
+
+int js8_decoder_stream_poll(js8_decoder_t* decoder,
+                            js8dsp_decoded_message_t* messages,
+                            int max_messages) {
+    if (!decoder) return -1;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    return ctx->decoder->stream_poll(messages, max_messages);
+}
+
+uint32_t js8_decoder_stream_take_decoded(js8_decoder_t* decoder) {
+    if (!decoder) return 0;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    return ctx->decoder->stream_take_decoded();
+}
+
+void js8_decoder_set_threshold(js8_decoder_t* decoder, float threshold) {
+    if (!decoder) return;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    ctx->decoder->set_threshold(threshold);
+}
+
+void js8_decoder_set_event_callback(js8_decoder_t* decoder,
+                                    js8dsp_event_callback_t callback,
+                                    void* user_data,
+                                    int sync_stats) {
+    if (!decoder) return;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    ctx->decoder->set_event_callback(callback, user_data, sync_stats != 0);
+}
+
+void js8_decoder_set_ldpc_decoder(js8_decoder_t* decoder, js8dsp_ldpc_t ldpc) {
+    if (!decoder) return;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    ctx->decoder->set_ldpc_decoder(ldpc);
+}
+
+void js8_decoder_set_decode_cache(js8_decoder_t* decoder, int enabled) {
+    if (!decoder) return;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    ctx->decoder->set_decode_cache(enabled != 0);
+}
+
+void js8_decoder_set_osd_budget(js8_decoder_t* decoder, float budget_ms) {
+    if (!decoder) return;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    ctx->decoder->set_osd_budget(budget_ms);
+}
+
+void js8_decoder_set_time_budget(js8_decoder_t* decoder, float budget_ms) {
+    if (!decoder) return;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    ctx->decoder->set_time_budget(budget_ms);
+}
+
+void js8_decoder_set_decode_rounds(js8_decoder_t* decoder, int rounds) {
+    if (!decoder) return;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    ctx->decoder->set_decode_rounds(rounds);
+}
+
+void js8_decoder_get_osd_stats(js8_decoder_t* decoder, float* budget_ms,
+                               uint32_t* attempts, uint32_t* decoded, uint32_t* skipped) {
+    if (!decoder) return;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    ctx->decoder->get_osd_stats(budget_ms, attempts, decoded, skipped);
+}
+
+void js8_decoder_get_metrics(js8_decoder_t* decoder, js8dsp_metrics_t* metrics) {
+    if (!decoder) return;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    ctx->decoder->get_metrics(metrics);
+}
+
+uint64_t js8_decoder_get_spectrum(js8_decoder_t* decoder, int mode, int channel,
+                                  const js8dsp_spectrum_layout_t* layout,
+                                  void* power, void* baseline) {
+    if (!decoder || !layout || !power) return 0;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    return ctx->decoder->get_spectrum(mode, channel, *layout, power, baseline);
+}
+
+size_t js8_decoder_save_state(js8_decoder_t* decoder, void* buffer, size_t size) {
+    if (!decoder) return 0;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    return ctx->decoder->save_state(buffer, size);
+}
+
+int js8_decoder_load_state(js8_decoder_t* decoder, const void* buffer, size_t size) {
+    if (!decoder || !buffer) return -1;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    return ctx->decoder->load_state(buffer, size);
+}
+
+} // extern "C"
+
+// C++ linkage; these take C++ types
+void js8_decoder_set_thread_pool(js8_decoder_t* decoder, JS8DSP::ThreadPool* pool) {
+    if (!decoder) return;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    ctx->decoder->set_thread_pool(pool);
+}
+
+int js8_decoder_set_thread_policy(js8_decoder_t* decoder, const JS8DSP::ThreadPolicy& policy) {
+    if (!decoder) return EINVAL;
+
+    auto ctx = reinterpret_cast<js8_decoder_context*>(decoder);
+    return ctx->decoder->set_thread_policy(policy);
+}
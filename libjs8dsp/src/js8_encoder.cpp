@@ -0,0 +1,231 @@
+/**
+ * JS8 transmit path: frame to tones, tones to audio
+ */
+
+#include "../include/js8_encoder.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <string_view>
+
+namespace JS8DSP {
+
+using namespace JS8Constants;
+
+namespace {
+
+// Generator parity rows of the (174,87) code, from JS8Call: bit j of row
+// i set where message bit j is summed, modulo 2, into parity bit i. Each
+// row is packed into two words, message bit 0 the most significant bit
+// of the first, so that the first word lines up with Frame72::value.
+using ParityRow = std::array<uint64_t, 2>;
+
+constexpr std::array<std::string_view, K> PARITY_HEX = {
+    "23bba830e23b6b6f50982e", "1f8e55da218c5df3309052", "ca7b3217cd92bd59a5ae20",
+    "56f78313537d0f4382964e", "6be396b5e2e819e373340c", "293548a138858328af4210",
+    "cb6c6afcdc28bb3f7c6e86", "3f2a86f5c5bd225c961150", "849dd2d63673481860f62c",
+    "56cdaec6e7ae14b43feeee", "04ef5cfa3766ba778f45a4", "c525ae4bd4f627320a3974",
+    "41fd9520b2e4abeb2f989c", "7fb36c24085a34d8c1dbc4", "40fc3e44bb7d2bb2756e44",
+    "d38ab0a1d2e52a8ec3bc76", "3d0f929ef3949bd84d4734", "45d3814f504064f80549ae",
+    "f14dbf263825d0bd04b05e", "db714f8f64e8ac7af1a76e", "8d0274de71e7c1a8055eb0",
+    "51f81573dd4049b082de14", "d8f937f31822e57c562370", "b6537f417e61d1a7085336",
+    "ecbd7c73b9cd34c3720c8a", "3d188ea477f6fa41317a4e", "1ac4672b549cd6dba79bcc",
+    "a377253773ea678367c3f6", "0dbd816fba1543f721dc72", "ca4186dd44c3121565cf5c",
+    "29c29dba9c545e267762fe", "1616d78018d0b4745ca0f2", "fe37802941d66dde02b99c",
+    "a9fa8e50bcb032c85e3304", "83f640f1a48a8ebc0443ea", "3776af54ccfbae916afde6",
+    "a8fc906976c35669e79ce0", "f08a91fb2e1f78290619a8", "cc9da55fe046d0cb3a770c",
+    "d36d662a69ae24b74dcbd8", "40907b01280f03c0323946", "d037db825175d851f3af00",
+    "1bf1490607c54032660ede", "0af7723161ec223080be86", "eca9afa0f6b01d92305edc",
+    "7a8dec79a51e8ac5388022", "9059dfa2bb20ef7ef73ad4", "6abb212d9739dfc02580f2",
+    "f6ad4824b87c80ebfce466", "d747bfc5fd65ef70fbd9bc", "612f63acc025b6ab476f7c",
+    "05209a0abb530b9e7e34b0", "45b7ab6242b77474d9f11a", "6c280d2a0523d9c4bc5946",
+    "f1627701a2d692fd9449e6", "8d9071b7e7a6a2eed6965e", "bf4f56e073271f6ab4bf80",
+    "c0fc3ec4fb7d2bb2756644", "57da6d13cb96a7689b2790", "a9fa2eefa6f8796a355772",
+    "164cc861bdd803c547f2ac", "cc6de59755420925f90ed2", "a0c0033a52ab6299802fd2",
+    "b274db8abd3c6f396ea356", "97d4169cb33e7435718d90", "81cfc6f18c35b1e1f17114",
+    "481a2a0df8a23583f82d6c", "081c29a10d468ccdbcecb6", "2c4142bf42b01e71076acc",
+    "a6573f3dc8b16c9d19f746", "c87af9a5d5206abca532a8", "012dee2198eba82b19a1da",
+    "b1ca4ea2e3d173bad4379c", "b33ec97be83ce413f9acc8", "5b0f7742bca86b8012609a",
+    "37d8e0af9258b9e8c5f9b2", "35ad3fb0faeb5f1b0c30dc", "6114e08483043fd3f38a8a",
+    "cd921fdf59e882683763f6", "95e45ecd0135aca9d6e6ae", "2e547dd7a05f6597aac516",
+    "14cd0f642fc0c5fe3a65ca", "3a0a1dfd7eee29c2e827e0", "c8b5dffc335095dcdcaf2a",
+    "3dd01a59d86310743ec752", "8abdb889efbe39a510a118", "3f231f212055371cf3e2a2"
+};
+
+constexpr int hex_value(char c) {
+    return c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1;
+}
+
+constexpr auto PARITY = []() {
+    std::array<ParityRow, K> rows{};
+    for (int i = 0; i < K; ++i) {
+        for (int j = 0; j < K; ++j) {
+            const int digit = hex_value(PARITY_HEX[i][j / 4]);
+            if (digit < 0) throw "invalid parity row";
+            if ((digit >> (3 - j % 4)) & 1) rows[i][j / 64] |= uint64_t{1} << (63 - j % 64);
+        }
+    }
+    return rows;
+}();
+
+constexpr uint16_t CRC12_POLY = 0xc06;
+constexpr uint16_t CRC12_XOR = 42;
+
+constexpr int SINE_BITS = 10;                  // Sine table entries, log2
+constexpr int SINE_SHIFT = 32 - SINE_BITS;     // Phase bits below the table index
+constexpr double PHASE_STEPS = 4294967296.0;   // Phase accumulator steps per cycle
+
+// Frequency pulse of a Gaussian filtered unit symbol, t in symbols from
+// its centre
+double gfsk_pulse(double bt, double t) {
+    const double c = M_PI * std::sqrt(2.0 / std::log(2.0));
+    return 0.5 * (std::erf(c * bt * (t + 0.5)) - std::erf(c * bt * (t - 0.5)));
+}
+
+} // namespace
+
+uint16_t crc12(const std::array<uint8_t, 11>& bytes) {
+    uint16_t crc = 0;
+    for (uint8_t byte : bytes) {
+        for (int bit = 7; bit >= 0; --bit) {
+            const bool carry = crc & 0x800;
+            crc = static_cast<uint16_t>(((crc << 1) | ((byte >> bit) & 1)) & 0xfff);
+            if (carry) crc ^= CRC12_POLY;
+        }
+    }
+    return crc ^ CRC12_XOR;
+}
+
+void encode_tones(Frame72 frame, int transmission, Mode mode, ToneSequence& tones) {
+    // 72 frame bits, 3 transmission type bits, then the CRC-12 of all 11
+    // bytes with its own bits clear
+    std::array<uint8_t, 11> bytes{};
+    for (int i = 0; i < 8; ++i) bytes[i] = static_cast<uint8_t>(frame.value >> (56 - 8 * i));
+    bytes[8] = frame.rem;
+    bytes[9] = static_cast<uint8_t>((transmission & 0b111) << 5);
+
+    const uint16_t crc = crc12(bytes);
+    bytes[9] |= (crc >> 7) & 0x1f;
+    bytes[10] = static_cast<uint8_t>((crc & 0x7f) << 1);
+
+    // The same 87 bits as two words for the parity rows; bits past the
+    // message in the second word are clear
+    ParityRow message{frame.value, 0};
+    for (int i = 8; i < 11; ++i) message[1] |= uint64_t{bytes[i]} << (56 - 8 * (i - 8));
+
+    const auto& costas = getModeParams(mode).costas == CostasType::ORIGINAL ? COSTAS_ORIGINAL : COSTAS_MODIFIED;
+    for (int a = 0; a < 3; ++a) {
+        std::copy(costas[a], costas[a] + 7, tones.begin() + 36 * a);
+    }
+
+    // Three bits a symbol, most significant first: parity symbols carry
+    // codeword bits 0..86 and message symbols bits 87..173
+    for (int s = 0; s < ND / 2; ++s) {
+        uint8_t parity = 0;
+        uint8_t data = 0;
+        for (int b = 0; b < 3; ++b) {
+            const int bit = 3 * s + b;
+            const auto& row = PARITY[bit];
+            parity = static_cast<uint8_t>((parity << 1) |
+                                          (std::popcount((row[0] & message[0]) ^ (row[1] & message[1])) & 1));
+            data = static_cast<uint8_t>((data << 1) | ((message[bit / 64] >> (63 - bit % 64)) & 1));
+        }
+        tones[7 + s] = parity;
+        tones[43 + s] = data;
+    }
+}
+
+GfskModulator::GfskModulator(int sample_rate, Mode mode)
+    : sample_rate_(sample_rate) {
+    const int nsps = getModeParams(mode).nsps;
+    samples_per_symbol_ = std::max(1, static_cast<int>(std::lround(static_cast<double>(nsps) * sample_rate /
+                                                                   JS8_RX_SAMPLE_RATE)));
+    tone_spacing_ = static_cast<float>(JS8_RX_SAMPLE_RATE) / nsps;
+
+    // A pulse spans the previous, current and next symbol
+    const int sps = samples_per_symbol_;
+    const double step = tone_spacing_ / sample_rate_ * PHASE_STEPS;
+    pulse_.resize(3 * sps);
+    for (int i = 0; i < 3 * sps; ++i) {
+        const double t = (i + 0.5 - 1.5 * sps) / sps;
+        pulse_[i] = static_cast<float>(gfsk_pulse(GFSK_BT, t) * step);
+    }
+
+    // Ramp up and down over an eighth of a symbol to keep key clicks out
+    ramp_.resize(std::max(1, sps / 8));
+    for (size_t i = 0; i < ramp_.size(); ++i) {
+        ramp_[i] = static_cast<float>(0.5 * (1.0 - std::cos(M_PI * (i + 0.5) / ramp_.size())));
+    }
+
+    sine_.resize((1 << SINE_BITS) + 1);
+    for (size_t i = 0; i < sine_.size(); ++i) {
+        sine_[i] = static_cast<float>(std::sin(2.0 * M_PI * i / (1 << SINE_BITS)));
+    }
+}
+
+template <typename Write>
+void GfskModulator::modulate(const ToneSequence& tones, uint32_t carrier, Write&& write) const {
+    const int sps = samples_per_symbol_;
+    const float* previous_pulse = pulse_.data() + 2 * sps;
+    const float* current_pulse = pulse_.data() + sps;
+    const float* next_pulse = pulse_.data();
+
+    // The symbols before the first and after the last repeat the end tones
+    uint32_t phase = 0;
+    for (int k = 0; k < NN; ++k) {
+        const float previous = tones[std::max(k - 1, 0)];
+        const float current = tones[k];
+        const float next = tones[std::min(k + 1, NN - 1)];
+
+        for (int i = 0; i < sps; ++i) {
+            write(phase);
+
+            const float deviation = previous * previous_pulse[i] + current * current_pulse[i] + next * next_pulse[i];
+            phase += carrier + static_cast<uint32_t>(static_cast<int64_t>(std::lrint(deviation)));
+        }
+    }
+}
+
+float GfskModulator::sine(uint32_t phase) const {
+    const uint32_t index = phase >> SINE_SHIFT;
+    const float fraction = (phase & ((1u << SINE_SHIFT) - 1)) * (1.0f / (1u << SINE_SHIFT));
+    return sine_[index] + fraction * (sine_[index + 1] - sine_[index]);
+}
+
+size_t GfskModulator::render(const ToneSequence& tones, float frequency, float* out, size_t size) const {
+    const size_t total = samples();
+    if (size < total) return 0;
+
+    const auto carrier = static_cast<uint32_t>(static_cast<int64_t>(
+        std::llround(static_cast<double>(frequency) / sample_rate_ * PHASE_STEPS)));
+    float* sample = out;
+    modulate(tones, carrier, [this, &sample](uint32_t phase) { *sample++ = sine(phase); });
+
+    const size_t ramp = std::min(ramp_.size(), total / 2);
+    for (size_t i = 0; i < ramp; ++i) {
+        out[i] *= ramp_[i];
+        out[total - 1 - i] *= ramp_[i];
+    }
+
+    return total;
+}
+
+size_t GfskModulator::render_baseband(const ToneSequence& tones, std::complex<float>* out, size_t size) const {
+    const size_t total = samples();
+    if (size < total) return 0;
+
+    // A quarter cycle ahead, the sine is the cosine
+    constexpr uint32_t quarter = 1u << 30;
+    std::complex<float>* sample = out;
+    modulate(tones, 0, [this, &sample](uint32_t phase) { *sample++ = {sine(phase + quarter), sine(phase)}; });
+
+    const size_t ramp = std::min(ramp_.size(), total / 2);
+    for (size_t i = 0; i < ramp; ++i) {
+        out[i] *= ramp_[i];
+        out[total - 1 - i] *= ramp_[i];
+    }
+
+    return total;
+}
+
+} // namespace JS8DSP
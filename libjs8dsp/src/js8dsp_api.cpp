@@ -1,21 +1,44 @@
 #include "js8dsp.h"
+#include "js8_decoder.h"
+#include "thread_pool.h"
+#include "thread_policy.h"
+#include "frame_codec.h"
+#include "js8_encoder.h"
+#include <atomic>
+#include <cstddef>
 #include <cstring>
 #include <memory>
+#include <new>
 #include <string>
 #include <cstdio>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
 
 // Internal context structure
 struct js8dsp_context {
     int sample_rate;
     js8dsp_mode_t mode;
     float decode_threshold;
-    uint32_t total_decoded;
-    uint32_t total_errors;
+
+    // Read by js8dsp_get_metrics from any thread
+    std::atomic<uint32_t> total_decoded;
+    std::atomic<uint32_t> total_errors;
     std::string last_error;
 
-    // DSP components will be added here
-    // js8_decoder* decoder;
-    // varicode_encoder* encoder;
+    // Long-lived decoder; owns all per-slot scratch state for this handle
+    js8_decoder_t* decoder;
+
+    // Optional candidate decode workers; null when decoding serially
+    std::unique_ptr<JS8DSP::ThreadPool> pool;
+
+    // Taken by the workers, and by the caller during decode passes
+    JS8DSP::ThreadPolicy policy;
+
+    // Transmit tables for the mode at the context's sample rate, and the
+    // audio frequency of tone 0
+    std::unique_ptr<JS8DSP::GfskModulator> modulator;
+    float tx_frequency;
 };
 
 // Version information
@@ -32,16 +55,30 @@ js8dsp_handle_t js8dsp_init(int sample_rate, js8dsp_mode_t mode) {
         return nullptr;
     }
 
-    auto ctx = std::make_unique<js8dsp_context>();
-    ctx->sample_rate = sample_rate;
-    ctx->mode = mode;
-    ctx->decode_threshold = -20.0f; // Default threshold
-    ctx->total_decoded = 0;
-    ctx->total_errors = 0;
-
-    // TODO: Initialize actual DSP components
-    // ctx->decoder = new js8_decoder(sample_rate, mode);
-    // ctx->encoder = new varicode_encoder(sample_rate, mode);
+    std::unique_ptr<js8dsp_context> ctx;
+    try {
+        ctx = std::make_unique<js8dsp_context>();
+        ctx->sample_rate = sample_rate;
+        ctx->mode = mode;
+        ctx->decode_threshold = -20.0f; // Default threshold
+        ctx->total_decoded = 0;
+        ctx->total_errors = 0;
+
+        // Decoder buffers are sized here, once, for the chosen mode
+        ctx->decoder = js8_decoder_create(sample_rate, mode);
+        if (!ctx->decoder) {
+            return nullptr;
+        }
+        js8_decoder_set_threshold(ctx->decoder, ctx->decode_threshold);
+
+        // As are the transmit tables, so encoding does not allocate
+        ctx->modulator = std::make_unique<JS8DSP::GfskModulator>(sample_rate, static_cast<JS8Constants::Mode>(mode));
+        ctx->tx_frequency = JS8DSP_DEFAULT_TX_FREQUENCY;
+    } catch (const std::bad_alloc&) {
+        // The context does not destroy its decoder; js8dsp_cleanup does
+        if (ctx) js8_decoder_destroy(ctx->decoder);
+        return nullptr;
+    }
 
     return ctx.release();
 }
@@ -52,34 +89,232 @@ void js8dsp_cleanup(js8dsp_handle_t handle) {
 
     auto ctx = static_cast<js8dsp_context*>(handle);
 
-    // TODO: Clean up DSP components
-    // delete ctx->decoder;
-    // delete ctx->encoder;
+    js8_decoder_destroy(ctx->decoder);
+    ctx->pool.reset();
 
     delete ctx;
 }
 
-// Decode audio buffer (stub implementation)
+// A message array is optional when decodes are taken from events
+static bool valid_output(const js8dsp_decoded_message_t* messages, int max_messages) {
+    return messages ? max_messages > 0 : max_messages == 0;
+}
+
+static bool valid_submodes(uint32_t submodes) {
+    return submodes != 0 && !(submodes & ~static_cast<uint32_t>(JS8DSP_SUBMODE_ALL));
+}
+
+// Update statistics and error state after a decoder call
+static int finish_decode(js8dsp_context* ctx, int decoded) {
+    if (decoded < 0) {
+        ++ctx->total_errors;
+        ctx->last_error = "Decoder failed to process audio buffer";
+        return JS8DSP_ERROR;
+    }
+
+    ctx->total_decoded += static_cast<uint32_t>(decoded);
+    return decoded;
+}
+
+// As finish_decode, counting the slots the push completed as they finish
+static int finish_stream_push(js8dsp_context* ctx, int pending) {
+    ctx->total_decoded += js8_decoder_stream_take_decoded(ctx->decoder);
+    if (pending < 0) {
+        ++ctx->total_errors;
+        ctx->last_error = "Decoder failed to process audio stream";
+        return JS8DSP_ERROR;
+    }
+
+    return pending;
+}
+
+// Decode audio buffer
 int js8dsp_decode_buffer(js8dsp_handle_t handle,
                         const float* audio_buffer,
                         size_t buffer_size,
                         js8dsp_decoded_message_t* messages,
                         int max_messages) {
-    if (!handle || !audio_buffer || !messages || max_messages <= 0) {
+    if (!handle || !audio_buffer || !valid_output(messages, max_messages)) {
+        return JS8DSP_INVALID_PARAM;
+    }
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    return finish_decode(ctx, js8_decoder_decode(ctx->decoder, audio_buffer, buffer_size,
+                                                 messages, max_messages));
+}
+
+// Decode 16-bit audio buffer
+int js8dsp_decode_buffer_s16(js8dsp_handle_t handle,
+                            const int16_t* audio_buffer,
+                            size_t buffer_size,
+                            js8dsp_decoded_message_t* messages,
+                            int max_messages) {
+    if (!handle || !audio_buffer || !valid_output(messages, max_messages)) {
         return JS8DSP_INVALID_PARAM;
     }
 
     auto ctx = static_cast<js8dsp_context*>(handle);
+    return finish_decode(ctx, js8_decoder_decode_s16(ctx->decoder, audio_buffer, buffer_size,
+                                                     messages, max_messages));
+}
 
-    // TODO: Implement actual decoding
-    // For now, return 0 (no messages decoded)
-    (void)ctx;          // Suppress unused variable warning
-    (void)buffer_size;  // Suppress unused variable warning
+// Decode audio buffer in several submodes
+int js8dsp_decode_buffer_multi(js8dsp_handle_t handle,
+                              const float* audio_buffer,
+                              size_t buffer_size,
+                              uint32_t submodes,
+                              js8dsp_decoded_message_t* messages,
+                              int max_messages) {
+    if (!handle || !audio_buffer || !valid_output(messages, max_messages) ||
+        !valid_submodes(submodes)) {
+        return JS8DSP_INVALID_PARAM;
+    }
 
-    return 0; // No messages decoded yet
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    return finish_decode(ctx, js8_decoder_decode_multi(ctx->decoder, audio_buffer, buffer_size,
+                                                       static_cast<int>(submodes),
+                                                       messages, max_messages));
 }
 
-// Encode message to audio (stub implementation)
+// Decode 16-bit audio buffer in several submodes
+int js8dsp_decode_buffer_multi_s16(js8dsp_handle_t handle,
+                                  const int16_t* audio_buffer,
+                                  size_t buffer_size,
+                                  uint32_t submodes,
+                                  js8dsp_decoded_message_t* messages,
+                                  int max_messages) {
+    if (!handle || !audio_buffer || !valid_output(messages, max_messages) ||
+        !valid_submodes(submodes)) {
+        return JS8DSP_INVALID_PARAM;
+    }
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    return finish_decode(ctx, js8_decoder_decode_multi_s16(ctx->decoder, audio_buffer, buffer_size,
+                                                           static_cast<int>(submodes),
+                                                           messages, max_messages));
+}
+
+static bool valid_channels(int channels, js8dsp_layout_t layout) {
+    return channels >= 1 && channels <= JS8DSP_MAX_CHANNELS &&
+           (layout == JS8DSP_LAYOUT_INTERLEAVED || layout == JS8DSP_LAYOUT_PLANAR);
+}
+
+// Decode several receiver channels
+int js8dsp_decode_channels(js8dsp_handle_t handle,
+                          const float* audio_buffer,
+                          size_t frames,
+                          int channels,
+                          js8dsp_layout_t layout,
+                          uint32_t submodes,
+                          js8dsp_decoded_message_t* messages,
+                          int max_messages) {
+    if (!handle || !audio_buffer || !valid_output(messages, max_messages) ||
+        !valid_submodes(submodes) || !valid_channels(channels, layout)) {
+        return JS8DSP_INVALID_PARAM;
+    }
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    return finish_decode(ctx, js8_decoder_decode_channels(ctx->decoder, audio_buffer, frames, channels, layout,
+                                                          static_cast<int>(submodes),
+                                                          messages, max_messages));
+}
+
+// Decode several 16-bit receiver channels
+int js8dsp_decode_channels_s16(js8dsp_handle_t handle,
+                              const int16_t* audio_buffer,
+                              size_t frames,
+                              int channels,
+                              js8dsp_layout_t layout,
+                              uint32_t submodes,
+                              js8dsp_decoded_message_t* messages,
+                              int max_messages) {
+    if (!handle || !audio_buffer || !valid_output(messages, max_messages) ||
+        !valid_submodes(submodes) || !valid_channels(channels, layout)) {
+        return JS8DSP_INVALID_PARAM;
+    }
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    return finish_decode(ctx, js8_decoder_decode_channels_s16(ctx->decoder, audio_buffer, frames, channels,
+                                                              layout, static_cast<int>(submodes),
+                                                              messages, max_messages));
+}
+
+// Start streaming decode
+js8dsp_result_t js8dsp_stream_start(js8dsp_handle_t handle, uint32_t submodes) {
+    if (!handle || !valid_submodes(submodes)) {
+        return JS8DSP_INVALID_PARAM;
+    }
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+
+    if (js8_decoder_stream_start(ctx->decoder, static_cast<int>(submodes)) < 0) {
+        ctx->last_error = "Failed to allocate stream buffers";
+        return JS8DSP_OUT_OF_MEMORY;
+    }
+
+    return JS8DSP_OK;
+}
+
+// Push audio into the stream
+int js8dsp_stream_push(js8dsp_handle_t handle,
+                      const float* samples,
+                      size_t sample_count) {
+    if (!handle || !samples) {
+        return JS8DSP_INVALID_PARAM;
+    }
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    return finish_stream_push(ctx, js8_decoder_stream_push(ctx->decoder, samples, sample_count));
+}
+
+// Push 16-bit audio into the stream
+int js8dsp_stream_push_s16(js8dsp_handle_t handle,
+                          const int16_t* samples,
+                          size_t sample_count) {
+    if (!handle || !samples) {
+        return JS8DSP_INVALID_PARAM;
+    }
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    return finish_stream_push(ctx, js8_decoder_stream_push_s16(ctx->decoder, samples, sample_count));
+}
+
+// Take streamed decodes
+int js8dsp_stream_poll(js8dsp_handle_t handle,
+                      js8dsp_decoded_message_t* messages,
+                      int max_messages) {
+    if (!handle || !messages || max_messages <= 0) {
+        return JS8DSP_INVALID_PARAM;
+    }
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+
+    // Counted when their slot was decoded
+    int count = js8_decoder_stream_poll(ctx->decoder, messages, max_messages);
+    if (count < 0) {
+        return JS8DSP_ERROR;
+    }
+
+    return count;
+}
+
+// Render one frame into the caller's buffer
+static int render_frame(js8dsp_context* ctx,
+                        JS8DSP::Frame72 frame,
+                        int transmission_type,
+                        float* audio_buffer,
+                        size_t buffer_size) {
+    if (buffer_size < ctx->modulator->samples()) {
+        ctx->last_error = "Encode buffer too small for transmission";
+        return JS8DSP_INVALID_PARAM;
+    }
+
+    JS8DSP::ToneSequence tones;
+    JS8DSP::encode_tones(frame, transmission_type, static_cast<JS8Constants::Mode>(ctx->mode), tones);
+    return static_cast<int>(ctx->modulator->render(tones, ctx->tx_frequency, audio_buffer, buffer_size));
+}
+
+// Encode message to audio
 int js8dsp_encode_message(js8dsp_handle_t handle,
                          const char* message,
                          float* audio_buffer,
@@ -90,14 +325,34 @@ int js8dsp_encode_message(js8dsp_handle_t handle,
 
     auto ctx = static_cast<js8dsp_context*>(handle);
 
-    // TODO: Implement actual encoding
-    // For now, generate silence
-    memset(audio_buffer, 0, buffer_size * sizeof(float));
+    JS8DSP::Frame72 frame{0, 0};
+    JS8DSP::FrameType type = JS8DSP::FRAME_UNKNOWN;
+    const int packed = JS8DSP::pack_message(message, "", frame, type);
+    if (packed <= 0) {
+        ctx->last_error = "Message cannot be packed into a frame";
+        return JS8DSP_INVALID_PARAM;
+    }
 
-    (void)ctx;    // Suppress unused variable warning
-    (void)message; // Suppress unused variable warning
+    // A message that fits in one frame is both the first and the last
+    int transmission = JS8DSP::TRANSMISSION_FIRST;
+    if (message[packed] == '\0') transmission |= JS8DSP::TRANSMISSION_LAST;
+
+    return render_frame(ctx, frame, transmission, audio_buffer, buffer_size);
+}
+
+// Encode a packed frame to audio
+int js8dsp_encode_frame(js8dsp_handle_t handle,
+                       const js8dsp_frame_t* frame,
+                       int transmission_type,
+                       float* audio_buffer,
+                       size_t buffer_size) {
+    if (!handle || !frame || transmission_type < 0 || transmission_type > 7 ||
+        !audio_buffer || buffer_size == 0) {
+        return JS8DSP_INVALID_PARAM;
+    }
 
-    return static_cast<int>(buffer_size); // Return number of samples generated
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    return render_frame(ctx, {frame->bits, frame->rem}, transmission_type, audio_buffer, buffer_size);
 }
 
 // Get required buffer size for encoding
@@ -106,15 +361,24 @@ int js8dsp_get_encode_buffer_size(js8dsp_handle_t handle, const char* message) {
         return JS8DSP_INVALID_PARAM;
     }
 
+    // One transmission of 79 symbols at the mode's symbol rate, whatever
+    // the message; longer messages are sent a frame per transmission
     auto ctx = static_cast<js8dsp_context*>(handle);
+    return static_cast<int>(ctx->modulator->samples());
+}
 
-    // JS8 Normal mode: ~12.64 seconds at sample rate
-    // TODO: Calculate based on actual message length and mode
-    int duration_samples = 13 * ctx->sample_rate; // Approximate
+// Set transmit audio frequency
+js8dsp_result_t js8dsp_set_tx_frequency(js8dsp_handle_t handle, float frequency) {
+    if (!handle) return JS8DSP_INVALID_PARAM;
 
-    (void)message; // Suppress unused variable warning
+    // All eight tones must lie below Nyquist
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    const float top = frequency + 7.0f * ctx->modulator->tone_spacing();
+    if (!(frequency > 0.0f) || !(top < 0.5f * ctx->sample_rate)) return JS8DSP_INVALID_PARAM;
 
-    return duration_samples;
+    ctx->tx_frequency = frequency;
+
+    return JS8DSP_OK;
 }
 
 // Get last error message
@@ -131,8 +395,199 @@ js8dsp_result_t js8dsp_set_decode_threshold(js8dsp_handle_t handle, float thresh
 
     auto ctx = static_cast<js8dsp_context*>(handle);
     ctx->decode_threshold = threshold;
+    js8_decoder_set_threshold(ctx->decoder, threshold);
+
+    return JS8DSP_OK;
+}
+
+// Start candidate decode workers under the context's thread policy, in
+// place of any running; returns 0, the errno value the workers refused
+// the policy with, or -1 if they could not be started
+static int start_pool(js8dsp_context* ctx, int threads) {
+    // Detach before replacing so the decoder never sees a destroyed pool
+    js8_decoder_set_thread_pool(ctx->decoder, nullptr);
+    ctx->pool.reset();
+    if (threads <= 1) return 0;
+
+    try {
+        ctx->pool = std::make_unique<JS8DSP::ThreadPool>(threads, ctx->policy);
+    } catch (const std::exception&) {
+        return -1;
+    }
+    if (const int error = ctx->pool->policy_error()) {
+        ctx->pool.reset();
+        return error;
+    }
+
+    js8_decoder_set_thread_pool(ctx->decoder, ctx->pool.get());
+    return 0;
+}
 
-    // TODO: Update decoder threshold
+// Fall back to the default thread policy once the system refused one
+static js8dsp_result_t refuse_policy(js8dsp_context* ctx, int threads, int error) {
+    ctx->policy = JS8DSP::ThreadPolicy();
+    js8_decoder_set_thread_policy(ctx->decoder, ctx->policy);
+    start_pool(ctx, threads);
+
+    ctx->last_error = std::string("Thread policy refused: ") + std::strerror(error);
+    return JS8DSP_ERROR;
+}
+
+// Set candidate decode thread count
+js8dsp_result_t js8dsp_set_threads(js8dsp_handle_t handle, int threads) {
+    if (!handle || threads < 0) return JS8DSP_INVALID_PARAM;
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const int error = start_pool(ctx, threads);
+    if (error < 0) {
+        ctx->last_error = "Failed to start decode threads";
+        return JS8DSP_ERROR;
+    }
+    if (error > 0) return refuse_policy(ctx, threads, error);
+
+    return JS8DSP_OK;
+}
+
+// Set where and how decode passes run
+js8dsp_result_t js8dsp_set_thread_policy(js8dsp_handle_t handle, const js8dsp_thread_policy_t* policy) {
+    if (!handle) return JS8DSP_INVALID_PARAM;
+
+    JS8DSP::ThreadPolicy next;
+    if (policy) {
+        if (policy->cpu_count < 0 || policy->cpu_count > JS8DSP_MAX_PINNED_CPUS) return JS8DSP_INVALID_PARAM;
+        for (int i = 0; i < policy->cpu_count; ++i) {
+            if (policy->cpus[i] < 0) return JS8DSP_INVALID_PARAM;
+            next.cpus[i] = policy->cpus[i];
+        }
+        next.cpu_count = policy->cpu_count;
+
+        switch (policy->sched) {
+        case JS8DSP_SCHED_OTHER:
+            if (policy->priority != 0) return JS8DSP_INVALID_PARAM;
+            next.sched = JS8DSP::ThreadPolicy::Sched::OTHER;
+            break;
+        case JS8DSP_SCHED_FIFO:
+        case JS8DSP_SCHED_RR:
+            if (policy->priority < 1) return JS8DSP_INVALID_PARAM;
+            next.sched = policy->sched == JS8DSP_SCHED_FIFO ? JS8DSP::ThreadPolicy::Sched::FIFO
+                                                            : JS8DSP::ThreadPolicy::Sched::RR;
+            break;
+        default:
+            return JS8DSP_INVALID_PARAM;
+        }
+        next.priority = policy->priority;
+        next.lock_memory = policy->lock_memory != 0;
+    }
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    const int threads = ctx->pool ? static_cast<int>(ctx->pool->size()) : 1;
+
+    // The calling thread first, which also stands for the workers when
+    // decoding serially, then workers restarted under the policy
+    ctx->policy = next;
+    int error = js8_decoder_set_thread_policy(ctx->decoder, ctx->policy);
+    if (error == 0) error = start_pool(ctx, threads);
+    if (error < 0) {
+        ctx->policy = JS8DSP::ThreadPolicy();
+        js8_decoder_set_thread_policy(ctx->decoder, ctx->policy);
+        ctx->last_error = "Failed to start decode threads";
+        return JS8DSP_ERROR;
+    }
+    if (error > 0) return refuse_policy(ctx, threads, error);
+
+    return JS8DSP_OK;
+}
+
+// Set decode event callback
+js8dsp_result_t js8dsp_set_event_callback(js8dsp_handle_t handle,
+                                         js8dsp_event_callback_t callback,
+                                         void* user_data,
+                                         int sync_stats) {
+    if (!handle) return JS8DSP_INVALID_PARAM;
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    js8_decoder_set_event_callback(ctx->decoder, callback, user_data, sync_stats);
+
+    return JS8DSP_OK;
+}
+
+// Select the LDPC decoder
+js8dsp_result_t js8dsp_set_ldpc_decoder(js8dsp_handle_t handle, js8dsp_ldpc_t ldpc) {
+    if (!handle || (ldpc != JS8DSP_LDPC_BP_FLOODING && ldpc != JS8DSP_LDPC_MIN_SUM_LAYERED)) {
+        return JS8DSP_INVALID_PARAM;
+    }
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    js8_decoder_set_ldpc_decoder(ctx->decoder, ldpc);
+
+    return JS8DSP_OK;
+}
+
+// Enable or disable the decode cache
+js8dsp_result_t js8dsp_set_decode_cache(js8dsp_handle_t handle, int enabled) {
+    if (!handle) return JS8DSP_INVALID_PARAM;
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    js8_decoder_set_decode_cache(ctx->decoder, enabled);
+
+    return JS8DSP_OK;
+}
+
+// Set OSD time budget
+js8dsp_result_t js8dsp_set_osd_budget(js8dsp_handle_t handle, float budget_ms) {
+    if (!handle || !(budget_ms >= 0.0f)) return JS8DSP_INVALID_PARAM;
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    js8_decoder_set_osd_budget(ctx->decoder, budget_ms);
+
+    return JS8DSP_OK;
+}
+
+// Set decode pass time budget
+js8dsp_result_t js8dsp_set_time_budget(js8dsp_handle_t handle, float budget_ms) {
+    if (!handle || !(budget_ms >= 0.0f)) return JS8DSP_INVALID_PARAM;
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    js8_decoder_set_time_budget(ctx->decoder, budget_ms);
+
+    return JS8DSP_OK;
+}
+
+js8dsp_result_t js8dsp_set_decode_rounds(js8dsp_handle_t handle, int rounds) {
+    if (!handle || rounds < 1 || rounds > JS8DSP_MAX_DECODE_ROUNDS) return JS8DSP_INVALID_PARAM;
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    js8_decoder_set_decode_rounds(ctx->decoder, rounds);
+
+    return JS8DSP_OK;
+}
+
+js8dsp_result_t js8dsp_save_state(js8dsp_handle_t handle, void* buffer, size_t size, size_t* state_size) {
+    if (!handle || !state_size) return JS8DSP_INVALID_PARAM;
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    *state_size = js8_decoder_save_state(ctx->decoder, buffer, size);
+    if (buffer && *state_size > size) {
+        ctx->last_error = "State buffer too small";
+        return JS8DSP_ERROR;
+    }
+
+    return JS8DSP_OK;
+}
+
+js8dsp_result_t js8dsp_load_state(js8dsp_handle_t handle, const void* buffer, size_t size) {
+    if (!handle || !buffer) return JS8DSP_INVALID_PARAM;
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    if (js8_decoder_load_state(ctx->decoder, buffer, size) != 0) {
+        ctx->last_error = "Not a decoder state this library can load";
+        return JS8DSP_ERROR;
+    }
 
     return JS8DSP_OK;
 }
@@ -150,4 +605,122 @@ js8dsp_result_t js8dsp_get_stats(js8dsp_handle_t handle,
     *total_errors = ctx->total_errors;
 
     return JS8DSP_OK;
-}
\ No newline at end of file
+}
+
+// Get decoder metrics
+js8dsp_result_t js8dsp_get_metrics(js8dsp_handle_t handle, js8dsp_metrics_t* metrics, size_t size) {
+    if (!handle || !metrics || size < offsetof(js8dsp_metrics_t, passes)) {
+        return JS8DSP_INVALID_PARAM;
+    }
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+
+    js8dsp_metrics_t snapshot{};
+    js8_decoder_get_metrics(ctx->decoder, &snapshot);
+    snapshot.total_decoded = ctx->total_decoded;
+    snapshot.total_errors = ctx->total_errors;
+
+    // Callers built against an older layout get the fields they know of
+    snapshot.version = JS8DSP_METRICS_VERSION;
+    snapshot.size = static_cast<uint32_t>(std::min(size, sizeof(snapshot)));
+    memcpy(metrics, &snapshot, snapshot.size);
+
+    return JS8DSP_OK;
+}
+
+// Get the latest symbol frame spectrum for a waterfall
+js8dsp_result_t js8dsp_get_spectrum(js8dsp_handle_t handle,
+                                   int mode,
+                                   int channel,
+                                   const js8dsp_spectrum_layout_t* layout,
+                                   void* power,
+                                   void* baseline,
+                                   uint64_t* frame) {
+    if (!handle || !layout || !power || layout->bins == 0 ||
+        mode < JS8DSP_MODE_NORMAL || mode > JS8DSP_MODE_ULTRA || channel < 0 || channel >= JS8DSP_MAX_CHANNELS ||
+        !(layout->low_hz >= 0.0f) || !(layout->high_hz > layout->low_hz) ||
+        !(layout->high_hz <= JS8Constants::JS8_RX_SAMPLE_RATE / 2.0f) ||
+        (layout->format != JS8DSP_SPECTRUM_F16 && layout->format != JS8DSP_SPECTRUM_U8) ||
+        (layout->format == JS8DSP_SPECTRUM_U8 && !(layout->db_max > layout->db_min))) {
+        return JS8DSP_INVALID_PARAM;
+    }
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    const uint64_t frames = js8_decoder_get_spectrum(ctx->decoder, mode, channel, layout, power, baseline);
+    if (frames == 0) return JS8DSP_ERROR;
+
+    if (frame) *frame = frames;
+    return JS8DSP_OK;
+}
+
+// Get OSD statistics
+js8dsp_result_t js8dsp_get_osd_stats(js8dsp_handle_t handle,
+                                    float* budget_ms,
+                                    uint32_t* attempts,
+                                    uint32_t* decoded,
+                                    uint32_t* skipped) {
+    if (!handle || !budget_ms || !attempts || !decoded || !skipped) {
+        return JS8DSP_INVALID_PARAM;
+    }
+
+    auto ctx = static_cast<js8dsp_context*>(handle);
+    js8_decoder_get_osd_stats(ctx->decoder, budget_ms, attempts, decoded, skipped);
+
+    return JS8DSP_OK;
+}
+
+// Pack the start of a message into a frame
+int js8dsp_frame_pack(const char* text,
+                      const char* mycall,
+                      js8dsp_frame_t* frame,
+                      js8dsp_frame_type_t* frame_type) {
+    if (!text || !mycall || !frame) return JS8DSP_INVALID_PARAM;
+
+    JS8DSP::Frame72 packed{0, 0};
+    JS8DSP::FrameType type = JS8DSP::FRAME_UNKNOWN;
+    const int length = JS8DSP::pack_message(text, mycall, packed, type);
+
+    frame->bits = packed.value;
+    frame->rem = packed.rem;
+    if (frame_type) *frame_type = static_cast<js8dsp_frame_type_t>(type);
+
+    return length;
+}
+
+// Unpack a frame into message text
+int js8dsp_frame_unpack(const js8dsp_frame_t* frame,
+                        int transmission_type,
+                        char* text,
+                        size_t text_size,
+                        js8dsp_frame_type_t* frame_type) {
+    if (!frame || !text || text_size == 0) return JS8DSP_INVALID_PARAM;
+
+    JS8DSP::FrameType type = JS8DSP::FRAME_UNKNOWN;
+    const int length = JS8DSP::unpack_message({frame->bits, frame->rem}, transmission_type, text, text_size, type);
+    if (frame_type) *frame_type = static_cast<js8dsp_frame_type_t>(type);
+
+    return length < 0 ? JS8DSP_ERROR : length;
+}
+
+// Convert a frame to its text
+int js8dsp_frame_to_text(const js8dsp_frame_t* frame, char* text, size_t text_size) {
+    if (!frame || !text || text_size <= JS8DSP::FRAME_TEXT_LENGTH) return JS8DSP_INVALID_PARAM;
+
+    JS8DSP::pack72({frame->bits, frame->rem}, text);
+    text[JS8DSP::FRAME_TEXT_LENGTH] = '\0';
+
+    return static_cast<int>(JS8DSP::FRAME_TEXT_LENGTH);
+}
+
+// Convert frame text to a frame
+js8dsp_result_t js8dsp_frame_from_text(const char* text, js8dsp_frame_t* frame) {
+    if (!text || !frame) return JS8DSP_INVALID_PARAM;
+
+    JS8DSP::Frame72 unpacked{0, 0};
+    if (!JS8DSP::unpack72(text, unpacked)) return JS8DSP_INVALID_PARAM;
+
+    frame->bits = unpacked.value;
+    frame->rem = unpacked.rem;
+
+    return JS8DSP_OK;
+}
@@ -0,0 +1,126 @@
+/**
+ * Per-mode decoder tables, computed at compile time
+ */
+
+#include "../include/mode_tables.h"
+#include <array>
+#include <cmath>
+
+using namespace JS8Constants;
+
+namespace JS8DSP {
+
+namespace {
+
+// std::cos is not constexpr before C++26; reduce to [-pi/2, pi/2] and sum
+// the Taylor series, which is exact to double precision well before the
+// tables are rounded to float
+constexpr double const_cos(double x) {
+    constexpr double two_pi = 2.0 * M_PI;
+    const double turns = x / two_pi;
+    x -= two_pi * static_cast<double>(static_cast<long long>(turns + (turns < 0.0 ? -0.5 : 0.5)));
+
+    double sign = 1.0;
+    if (x > M_PI / 2) {
+        x -= M_PI;
+        sign = -1.0;
+    } else if (x < -M_PI / 2) {
+        x += M_PI;
+        sign = -1.0;
+    }
+
+    const double x2 = x * x;
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 2; n <= 24; n += 2) {
+        term *= -x2 / (n * (n - 1));
+        sum += term;
+    }
+    return sign * sum;
+}
+
+constexpr double const_sin(double x) {
+    return const_cos(x - M_PI / 2);
+}
+
+template <Mode MODE>
+struct ModeTableData {
+    static constexpr ModeParams params = getModeParams(MODE);
+    static constexpr int TONE_SIZE = 8 * SYNC_SHIFTS * params.ndownsps;
+    static constexpr int WINDOW_SIZE = params.nsps * NFOS;
+    static constexpr int TAPER_SIZE = params.ndd + 1;
+
+    std::array<float, TONE_SIZE> tone_re{};
+    std::array<float, TONE_SIZE> tone_im{};
+    std::array<float, WINDOW_SIZE> nuttal{};
+    std::array<float, TAPER_SIZE> taper_head{};
+    std::array<float, TAPER_SIZE> taper_tail{};
+
+    constexpr ModeTableData() {
+        const int n = params.ndownsps;
+        for (int tone = 0; tone < 8; ++tone) {
+            for (int shift = 0; shift < SYNC_SHIFTS; ++shift) {
+                const double cycles = tone + (shift - SYNC_SHIFTS / 2) * static_cast<double>(SYNC_SHIFT_STEP);
+                const int base = (tone * SYNC_SHIFTS + shift) * n;
+                for (int k = 0; k < n; ++k) {
+                    const double phase = 2.0 * M_PI * cycles * k / n;
+                    tone_re[base + k] = static_cast<float>(const_cos(phase));
+                    tone_im[base + k] = static_cast<float>(const_sin(phase));
+                }
+            }
+        }
+
+        constexpr double a0 = 0.3635819;
+        constexpr double a1 = -0.4891775;
+        constexpr double a2 = 0.1365995;
+        constexpr double a3 = -0.0106411;
+
+        std::array<double, WINDOW_SIZE> window{};
+        double sum = 0.0;
+        for (int i = 0; i < WINDOW_SIZE; ++i) {
+            window[i] = a0 + a1 * const_cos(2.0 * M_PI * i / WINDOW_SIZE)
+                           + a2 * const_cos(4.0 * M_PI * i / WINDOW_SIZE)
+                           + a3 * const_cos(6.0 * M_PI * i / WINDOW_SIZE);
+            sum += window[i];
+        }
+        for (int i = 0; i < WINDOW_SIZE; ++i) {
+            nuttal[i] = static_cast<float>(static_cast<float>(window[i]) / sum * WINDOW_SIZE / 300.0);
+        }
+
+        const int ndd = params.ndd;
+        for (int i = 0; i <= ndd; ++i) {
+            const float value = static_cast<float>(0.5 * (1.0 + const_cos(i * M_PI / ndd)));
+            taper_tail[i] = value;
+            taper_head[ndd - i] = value;
+        }
+    }
+
+    constexpr ModeTables view() const {
+        return {tone_re, tone_im,
+                params.costas == CostasType::ORIGINAL ? COSTAS_ORIGINAL : COSTAS_MODIFIED,
+                nuttal, taper_head, taper_tail};
+    }
+};
+
+constexpr ModeTableData<Mode::NORMAL> NORMAL_TABLES;
+constexpr ModeTableData<Mode::FAST> FAST_TABLES;
+constexpr ModeTableData<Mode::TURBO> TURBO_TABLES;
+constexpr ModeTableData<Mode::SLOW> SLOW_TABLES;
+constexpr ModeTableData<Mode::ULTRA> ULTRA_TABLES;
+
+// Indexed by Mode
+constexpr ModeTables MODE_TABLES[] = {
+    NORMAL_TABLES.view(),
+    FAST_TABLES.view(),
+    TURBO_TABLES.view(),
+    SLOW_TABLES.view(),
+    ULTRA_TABLES.view(),
+};
+
+} // namespace
+
+const ModeTables& mode_tables(Mode mode) {
+    return MODE_TABLES[static_cast<int>(mode)];
+}
+
+} // namespace JS8DSP
@@ -0,0 +1,185 @@
+/**
+ * Ordered statistics decoder for the (174,87) LDPC code
+ */
+
+#include "../include/osd_decoder.h"
+#include <algorithm>
+#include <cmath>
+
+namespace BPDSP {
+
+namespace {
+
+constexpr int WORDS = OSD_ROW_WORDS;        // Codeword bits per parity row
+constexpr int ROW_WORDS = OSD_SET_WORDS;    // Rows of the reduced checks
+
+using RowSet = std::array<uint64_t, ROW_WORDS>;
+
+inline bool test_bit(const uint64_t* bits, int i) {
+    return (bits[i >> 6] >> (i & 63)) & 1;
+}
+
+inline void flip_bit(uint64_t* bits, int i) {
+    bits[i >> 6] ^= uint64_t{1} << (i & 63);
+}
+
+} // namespace
+
+int osd174(const std::array<float, N>& llr,
+           int order,
+           std::array<int8_t, K>& decoded,
+           std::array<int8_t, N>& cw) {
+    OsdWorkspace work;
+    return osd174(llr, order, decoded, cw, work);
+}
+
+int osd174(const std::array<float, N>& llr,
+           int order,
+           std::array<int8_t, K>& decoded,
+           std::array<int8_t, N>& cw,
+           OsdWorkspace& work) {
+    order = std::max(0, std::min(order, OSD_MAX_ORDER));
+
+    std::array<float, N> reliability;
+    std::array<int8_t, N> hard;
+    std::array<int16_t, N> ranked;       // Least reliable first
+    for (int i = 0; i < N; ++i) {
+        reliability[i] = std::fabs(llr[i]);
+        hard[i] = llr[i] > 0.0f ? 1 : 0;
+        ranked[i] = static_cast<int16_t>(i);
+    }
+    // Ties broken by position; std::stable_sort would allocate
+    std::sort(ranked.begin(), ranked.end(), [&](int16_t a, int16_t b) {
+        return reliability[a] != reliability[b] ? reliability[a] < reliability[b] : a < b;
+    });
+
+    // Reduce the parity checks, taking pivots from the least reliable bits
+    // so that each check determines one of them from information bits only
+    auto& rows = work.rows;
+    rows = {};
+    for (int r = 0; r < M; ++r) {
+        for (int j = 0; j < Nm[r].valid_neighbors; ++j) flip_bit(rows[r].data(), Nm[r].neighbors[j]);
+    }
+
+    std::array<int16_t, M> pivot;
+    std::array<bool, N> is_pivot{};
+    int rank = 0;
+    for (int n = 0; n < N && rank < M; ++n) {
+        const int col = ranked[n];
+
+        int found = -1;
+        for (int r = rank; r < M; ++r) {
+            if (test_bit(rows[r].data(), col)) {
+                found = r;
+                break;
+            }
+        }
+        if (found < 0) continue;
+
+        std::swap(rows[rank], rows[found]);
+        for (int r = 0; r < M; ++r) {
+            if (r != rank && test_bit(rows[r].data(), col)) {
+                for (int w = 0; w < WORDS; ++w) rows[r][w] ^= rows[rank][w];
+            }
+        }
+
+        pivot[rank++] = static_cast<int16_t>(col);
+        is_pivot[col] = true;
+    }
+
+    // Information bits, least reliable first, and the rows each one feeds
+    std::array<int16_t, N> info;
+    int info_count = 0;
+    for (int n = 0; n < N; ++n) {
+        if (!is_pivot[ranked[n]]) info[info_count++] = ranked[n];
+    }
+
+    auto& feeds = work.feeds;
+    feeds = {};
+    for (int r = 0; r < rank; ++r) {
+        for (int n = 0; n < info_count; ++n) {
+            if (test_bit(rows[r].data(), info[n])) flip_bit(feeds[info[n]].data(), r);
+        }
+    }
+
+    // Re-encode the hard decisions; mismatch marks the pivots that then
+    // disagree with their own hard decision
+    RowSet mismatch{};
+    for (int r = 0; r < rank; ++r) {
+        int parity = 0;
+        for (int n = 0; n < info_count; ++n) {
+            if (hard[info[n]] && test_bit(rows[r].data(), info[n])) parity ^= 1;
+        }
+        if (parity != hard[pivot[r]]) flip_bit(mismatch.data(), r);
+    }
+
+    auto weight = [&](const RowSet& set) {
+        float sum = 0.0f;
+        for (int w = 0; w < ROW_WORDS; ++w) {
+            for (uint64_t bits = set[w]; bits; bits &= bits - 1) {
+                sum += reliability[pivot[w * 64 + __builtin_ctzll(bits)]];
+            }
+        }
+        return sum;
+    };
+
+    float best_distance = weight(mismatch);
+    int best_flip[2] = {-1, -1};
+
+    if (order >= 1) {
+        for (int a = 0; a < info_count; ++a) {
+            RowSet trial;
+            for (int w = 0; w < ROW_WORDS; ++w) trial[w] = mismatch[w] ^ feeds[info[a]][w];
+
+            float distance = reliability[info[a]] + weight(trial);
+            if (distance < best_distance) {
+                best_distance = distance;
+                best_flip[0] = a;
+                best_flip[1] = -1;
+            }
+        }
+    }
+
+    if (order >= 2) {
+        const int paired = std::min(info_count, OSD_ORDER2_BITS);
+        for (int a = 0; a < paired; ++a) {
+            for (int b = a + 1; b < paired; ++b) {
+                RowSet trial;
+                for (int w = 0; w < ROW_WORDS; ++w) {
+                    trial[w] = mismatch[w] ^ feeds[info[a]][w] ^ feeds[info[b]][w];
+                }
+
+                float distance = reliability[info[a]] + reliability[info[b]];
+                if (distance >= best_distance) continue;
+                distance += weight(trial);
+                if (distance < best_distance) {
+                    best_distance = distance;
+                    best_flip[0] = a;
+                    best_flip[1] = b;
+                }
+            }
+        }
+    }
+
+    // Build the chosen codeword and count its disagreements
+    cw = hard;
+    RowSet flipped = mismatch;
+    for (int f : best_flip) {
+        if (f < 0) continue;
+        cw[info[f]] ^= 1;
+        for (int w = 0; w < ROW_WORDS; ++w) flipped[w] ^= feeds[info[f]][w];
+    }
+    for (int r = 0; r < rank; ++r) {
+        if (test_bit(flipped.data(), r)) cw[pivot[r]] ^= 1;
+    }
+
+    std::copy(cw.begin() + M, cw.end(), decoded.begin());
+
+    int nerr = 0;
+    for (int i = 0; i < N; ++i) {
+        if ((2 * cw[i] - 1) * llr[i] < 0.0f) ++nerr;
+    }
+    return nerr;
+}
+
+} // namespace BPDSP
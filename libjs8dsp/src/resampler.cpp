@@ -0,0 +1,235 @@
+/**
+ * Polyphase FIR sample rate conversion
+ */
+
+#include "../include/resampler.h"
+#include "../include/sample_convert.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define JS8DSP_RESAMPLE_X86 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#define JS8DSP_RESAMPLE_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace JS8DSP {
+
+namespace {
+
+constexpr int TAP_MULTIPLE = 8;     // Taps per phase rounded up to a whole vector
+
+using DotFn = float (*)(const float* x, const float* h, int length);
+
+float dot_scalar(const float* x, const float* h, int length) {
+    float sum = 0.0f;
+    for (int k = 0; k < length; ++k) sum += x[k] * h[k];
+    return sum;
+}
+
+#if defined(JS8DSP_RESAMPLE_X86)
+
+#if defined(__SSE2__)
+float dot_sse2(const float* x, const float* h, int length) {
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    int k = 0;
+    for (; k + 8 <= length; k += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(x + k), _mm_loadu_ps(h + k)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(x + k + 4), _mm_loadu_ps(h + k + 4)));
+    }
+
+    __m128 sums = _mm_add_ps(acc0, acc1);
+    __m128 shuffled = _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(2, 3, 0, 1));
+    sums = _mm_add_ps(sums, shuffled);
+    shuffled = _mm_movehl_ps(shuffled, sums);
+    float sum = _mm_cvtss_f32(_mm_add_ss(sums, shuffled));
+
+    for (; k < length; ++k) sum += x[k] * h[k];
+    return sum;
+}
+#endif
+
+__attribute__((target("avx2,fma")))
+float dot_avx2(const float* x, const float* h, int length) {
+    __m256 acc = _mm256_setzero_ps();
+    int k = 0;
+    for (; k + 8 <= length; k += 8) {
+        acc = _mm256_fmadd_ps(_mm256_loadu_ps(x + k), _mm256_loadu_ps(h + k), acc);
+    }
+
+    __m128 sums = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    sums = _mm_hadd_ps(sums, sums);
+    sums = _mm_hadd_ps(sums, sums);
+    float sum = _mm_cvtss_f32(sums);
+
+    for (; k < length; ++k) sum += x[k] * h[k];
+    return sum;
+}
+
+#elif defined(JS8DSP_RESAMPLE_NEON)
+
+float dot_neon(const float* x, const float* h, int length) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    int k = 0;
+    for (; k + 8 <= length; k += 8) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(x + k), vld1q_f32(h + k));
+        acc1 = vmlaq_f32(acc1, vld1q_f32(x + k + 4), vld1q_f32(h + k + 4));
+    }
+
+    float lanes[4];
+    vst1q_f32(lanes, vaddq_f32(acc0, acc1));
+    float sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+    for (; k < length; ++k) sum += x[k] * h[k];
+    return sum;
+}
+
+#endif
+
+struct KernelChoice {
+    DotFn fn;
+    const char* name;
+};
+
+KernelChoice select_kernel() {
+#if defined(JS8DSP_RESAMPLE_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return {dot_avx2, "avx2"};
+    }
+#if defined(__SSE2__)
+    return {dot_sse2, "sse2"};
+#endif
+#elif defined(JS8DSP_RESAMPLE_NEON)
+    return {dot_neon, "neon"};
+#endif
+    return {dot_scalar, "scalar"};
+}
+
+const KernelChoice& kernel_choice() {
+    static const KernelChoice choice = select_kernel();
+    return choice;
+}
+
+// Zeroth order modified Bessel function of the first kind, for the
+// Kaiser window
+double bessel_i0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 50 && term > 1e-12 * sum; ++k) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+} // namespace
+
+Resampler::Resampler(int input_rate, int output_rate) {
+    const int divisor = std::gcd(input_rate, output_rate);
+    interpolation_ = output_rate / divisor;
+    decimation_ = input_rate / divisor;
+
+    // Kaiser's estimates of the length and shape for the attenuation
+    // over a transition band of a quarter of the lower Nyquist frequency
+    const double upsampled_rate = static_cast<double>(input_rate) * interpolation_;
+    const double nyquist = 0.5 * std::min(input_rate, output_rate);
+    const double transition = 2.0 * M_PI * 0.25 * nyquist / upsampled_rate;
+    const double beta = 0.1102 * (RESAMPLER_ATTENUATION_DB - 8.7);
+    const int length = static_cast<int>(std::ceil((RESAMPLER_ATTENUATION_DB - 8.0) / (2.285 * transition))) + 1;
+
+    taps_ = (length + interpolation_ - 1) / interpolation_;
+    taps_ = (taps_ + TAP_MULTIPLE - 1) / TAP_MULTIPLE * TAP_MULTIPLE;
+
+    // Prototype h[k], k = p + L * j, weights input sample j back from the
+    // newest for an output at phase p
+    const int total = taps_ * interpolation_;
+    const double cutoff = 0.875 * nyquist / upsampled_rate;
+    const double centre = 0.5 * (total - 1);
+    std::vector<double> prototype(total);
+    for (int k = 0; k < total; ++k) {
+        const double t = k - centre;
+        const double sinc = t == 0.0 ? 1.0 : std::sin(2.0 * M_PI * cutoff * t) / (2.0 * M_PI * cutoff * t);
+        const double r = 2.0 * t / (total - 1);
+        prototype[k] = 2.0 * cutoff * sinc * bessel_i0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / bessel_i0(beta);
+    }
+
+    // Each phase is normalised to unit gain at DC
+    coeffs_.resize(static_cast<size_t>(total));
+    for (int p = 0; p < interpolation_; ++p) {
+        double gain = 0.0;
+        for (int j = 0; j < taps_; ++j) gain += prototype[p + interpolation_ * j];
+        for (int j = 0; j < taps_; ++j) {
+            coeffs_[p * taps_ + (taps_ - 1 - j)] = static_cast<float>(prototype[p + interpolation_ * j] / gain);
+        }
+    }
+
+    history_.resize(2 * static_cast<size_t>(taps_));
+    reset();
+}
+
+void Resampler::reset() {
+    std::fill(history_.begin(), history_.end(), 0.0f);
+    position_ = 0;
+    received_ = 0;
+    newest_ = 0;
+    phase_ = 0;
+}
+
+template <typename Sample>
+size_t Resampler::run(const Sample* in, size_t count, size_t stride, float* out, size_t out_size,
+                      size_t& consumed) {
+    const DotFn dot = kernel_choice().fn;
+    size_t written = 0;
+    size_t used = 0;
+
+    for (;;) {
+        // Outputs whose newest input sample has arrived; the window then
+        // ends at that sample
+        while (written < out_size && newest_ < received_) {
+            out[written++] = dot(history_.data() + position_, coeffs_.data() + phase_ * taps_, taps_);
+            phase_ += decimation_;
+            newest_ += phase_ / interpolation_;
+            phase_ %= interpolation_;
+        }
+        if (written == out_size || used == count) break;
+
+        const float sample = sample_to_float(in[used++ * stride]);
+        history_[position_] = sample;
+        history_[position_ + taps_] = sample;
+        position_ = position_ + 1 == taps_ ? 0 : position_ + 1;
+        ++received_;
+    }
+
+    consumed = used;
+    return written;
+}
+
+size_t Resampler::process(const float* in, size_t count, float* out, size_t out_size, size_t& consumed) {
+    return run(in, count, 1, out, out_size, consumed);
+}
+
+size_t Resampler::process(const int16_t* in, size_t count, float* out, size_t out_size, size_t& consumed) {
+    return run(in, count, 1, out, out_size, consumed);
+}
+
+size_t Resampler::process(const float* in, size_t count, size_t stride, float* out, size_t out_size,
+                          size_t& consumed) {
+    return run(in, count, stride, out, out_size, consumed);
+}
+
+size_t Resampler::process(const int16_t* in, size_t count, size_t stride, float* out, size_t out_size,
+                          size_t& consumed) {
+    return run(in, count, stride, out, out_size, consumed);
+}
+
+const char* Resampler::kernel_name() {
+    return kernel_choice().name;
+}
+
+} // namespace JS8DSP
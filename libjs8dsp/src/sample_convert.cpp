@@ -0,0 +1,99 @@
+/**
+ * Sample format conversion
+ */
+
+#include "../include/sample_convert.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace JS8DSP {
+
+void convert_samples(const int16_t* in, float* out, size_t count) {
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128 scale = _mm_set1_ps(S16_SCALE);
+    for (; i + 8 <= count; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        // Sign-extend each half to 32 bits by unpacking into the high
+        // 16 bits and shifting back down arithmetically
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+#elif defined(__ARM_NEON)
+    const float32x4_t scale = vdupq_n_f32(S16_SCALE);
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t v = vld1q_s16(in + i);
+        int32x4_t lo = vmovl_s16(vget_low_s16(v));
+        int32x4_t hi = vmovl_s16(vget_high_s16(v));
+        vst1q_f32(out + i, vmulq_f32(vcvtq_f32_s32(lo), scale));
+        vst1q_f32(out + i + 4, vmulq_f32(vcvtq_f32_s32(hi), scale));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        out[i] = sample_to_float(in[i]);
+    }
+}
+
+void convert_samples(const float* in, float* out, size_t count) {
+    std::copy(in, in + count, out);
+}
+
+void convert_samples(const int16_t* in, size_t stride, float* out, size_t count) {
+    if (stride == 1) {
+        convert_samples(in, out, count);
+        return;
+    }
+    for (size_t i = 0; i < count; ++i) out[i] = sample_to_float(in[i * stride]);
+}
+
+void convert_samples(const float* in, size_t stride, float* out, size_t count) {
+    if (stride == 1) {
+        convert_samples(in, out, count);
+        return;
+    }
+    for (size_t i = 0; i < count; ++i) out[i] = in[i * stride];
+}
+
+uint16_t float_to_half(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    const uint32_t magnitude = bits & 0x7fffffff;
+
+    if (magnitude > 0x7f800000) return sign | 0x7e00;      // NaN
+    if (magnitude >= 0x477ff000) return sign | 0x7c00;     // 65520 and up round to infinity
+
+    // Below 2^-14 the half is subnormal, in units of 2^-24; below 2^-25
+    // it rounds to zero
+    uint32_t half;
+    uint32_t rest;
+    uint32_t midpoint;
+    if (magnitude < 0x38800000) {
+        if (magnitude < 0x33000000) return sign;
+        const int shift = 126 - static_cast<int>(magnitude >> 23);
+        const uint32_t mantissa = (magnitude & 0x7fffff) | 0x800000;
+        half = mantissa >> shift;
+        rest = mantissa & ((1u << shift) - 1);
+        midpoint = 1u << (shift - 1);
+    } else {
+        half = (magnitude >> 13) - (112u << 10);             // Exponent bias 127 to 15
+        rest = magnitude & 0x1fff;
+        midpoint = 0x1000;
+    }
+
+    // A carry out of the mantissa correctly moves to the next exponent
+    if (rest > midpoint || (rest == midpoint && (half & 1))) ++half;
+    return static_cast<uint16_t>(sign | half);
+}
+
+} // namespace JS8DSP
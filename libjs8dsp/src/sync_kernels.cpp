@@ -0,0 +1,193 @@
+/**
+ * Vectorized tone correlation kernels
+ *
+ * Each kernel accumulates the real and imaginary parts of x * conj(t)
+ * across the vector lanes and reduces them once per template, finishing
+ * lengths that are not a multiple of the vector width with scalar code.
+ */
+
+#include "../include/sync_kernels.h"
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define JS8DSP_SYNC_X86 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#define JS8DSP_SYNC_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace JS8DSP {
+
+void correlate_scalar(const float* x_re, const float* x_im,
+                      const float* t_re, const float* t_im,
+                      int length, int count, float* magnitudes) {
+    for (int c = 0; c < count; ++c) {
+        const float* tr = t_re + c * length;
+        const float* ti = t_im + c * length;
+        float re = 0.0f;
+        float im = 0.0f;
+
+        for (int k = 0; k < length; ++k) {
+            re += x_re[k] * tr[k] + x_im[k] * ti[k];
+            im += x_im[k] * tr[k] - x_re[k] * ti[k];
+        }
+
+        magnitudes[c] = std::sqrt(re * re + im * im);
+    }
+}
+
+#if defined(JS8DSP_SYNC_X86)
+
+#if defined(__SSE2__)
+static inline float horizontal_sum(__m128 v) {
+    __m128 shuffled = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(v, shuffled);
+    shuffled = _mm_movehl_ps(shuffled, sums);
+    return _mm_cvtss_f32(_mm_add_ss(sums, shuffled));
+}
+
+static void correlate_sse2(const float* x_re, const float* x_im,
+                           const float* t_re, const float* t_im,
+                           int length, int count, float* magnitudes) {
+    for (int c = 0; c < count; ++c) {
+        const float* tr = t_re + c * length;
+        const float* ti = t_im + c * length;
+        __m128 acc_re = _mm_setzero_ps();
+        __m128 acc_im = _mm_setzero_ps();
+        int k = 0;
+
+        for (; k + 4 <= length; k += 4) {
+            __m128 xr = _mm_loadu_ps(x_re + k);
+            __m128 xi = _mm_loadu_ps(x_im + k);
+            __m128 vr = _mm_loadu_ps(tr + k);
+            __m128 vi = _mm_loadu_ps(ti + k);
+            acc_re = _mm_add_ps(acc_re, _mm_add_ps(_mm_mul_ps(xr, vr), _mm_mul_ps(xi, vi)));
+            acc_im = _mm_add_ps(acc_im, _mm_sub_ps(_mm_mul_ps(xi, vr), _mm_mul_ps(xr, vi)));
+        }
+
+        float re = horizontal_sum(acc_re);
+        float im = horizontal_sum(acc_im);
+        for (; k < length; ++k) {
+            re += x_re[k] * tr[k] + x_im[k] * ti[k];
+            im += x_im[k] * tr[k] - x_re[k] * ti[k];
+        }
+
+        magnitudes[c] = std::sqrt(re * re + im * im);
+    }
+}
+#endif
+
+__attribute__((target("avx2,fma")))
+static void correlate_avx2(const float* x_re, const float* x_im,
+                           const float* t_re, const float* t_im,
+                           int length, int count, float* magnitudes) {
+    for (int c = 0; c < count; ++c) {
+        const float* tr = t_re + c * length;
+        const float* ti = t_im + c * length;
+        __m256 acc_re = _mm256_setzero_ps();
+        __m256 acc_im = _mm256_setzero_ps();
+        int k = 0;
+
+        for (; k + 8 <= length; k += 8) {
+            __m256 xr = _mm256_loadu_ps(x_re + k);
+            __m256 xi = _mm256_loadu_ps(x_im + k);
+            __m256 vr = _mm256_loadu_ps(tr + k);
+            __m256 vi = _mm256_loadu_ps(ti + k);
+            acc_re = _mm256_fmadd_ps(xr, vr, _mm256_fmadd_ps(xi, vi, acc_re));
+            acc_im = _mm256_fmadd_ps(xi, vr, _mm256_fnmadd_ps(xr, vi, acc_im));
+        }
+
+        __m128 re4 = _mm_add_ps(_mm256_castps256_ps128(acc_re), _mm256_extractf128_ps(acc_re, 1));
+        __m128 im4 = _mm_add_ps(_mm256_castps256_ps128(acc_im), _mm256_extractf128_ps(acc_im, 1));
+        re4 = _mm_hadd_ps(re4, im4);
+        re4 = _mm_hadd_ps(re4, re4);
+        float re = _mm_cvtss_f32(re4);
+        float im = _mm_cvtss_f32(_mm_shuffle_ps(re4, re4, _MM_SHUFFLE(1, 1, 1, 1)));
+
+        for (; k < length; ++k) {
+            re += x_re[k] * tr[k] + x_im[k] * ti[k];
+            im += x_im[k] * tr[k] - x_re[k] * ti[k];
+        }
+
+        magnitudes[c] = std::sqrt(re * re + im * im);
+    }
+}
+
+#elif defined(JS8DSP_SYNC_NEON)
+
+static void correlate_neon(const float* x_re, const float* x_im,
+                           const float* t_re, const float* t_im,
+                           int length, int count, float* magnitudes) {
+    for (int c = 0; c < count; ++c) {
+        const float* tr = t_re + c * length;
+        const float* ti = t_im + c * length;
+        float32x4_t acc_re = vdupq_n_f32(0.0f);
+        float32x4_t acc_im = vdupq_n_f32(0.0f);
+        int k = 0;
+
+        for (; k + 4 <= length; k += 4) {
+            float32x4_t xr = vld1q_f32(x_re + k);
+            float32x4_t xi = vld1q_f32(x_im + k);
+            float32x4_t vr = vld1q_f32(tr + k);
+            float32x4_t vi = vld1q_f32(ti + k);
+            acc_re = vmlaq_f32(vmlaq_f32(acc_re, xr, vr), xi, vi);
+            acc_im = vmlsq_f32(vmlaq_f32(acc_im, xi, vr), xr, vi);
+        }
+
+        float re_lanes[4];
+        float im_lanes[4];
+        vst1q_f32(re_lanes, acc_re);
+        vst1q_f32(im_lanes, acc_im);
+        float re = (re_lanes[0] + re_lanes[1]) + (re_lanes[2] + re_lanes[3]);
+        float im = (im_lanes[0] + im_lanes[1]) + (im_lanes[2] + im_lanes[3]);
+
+        for (; k < length; ++k) {
+            re += x_re[k] * tr[k] + x_im[k] * ti[k];
+            im += x_im[k] * tr[k] - x_re[k] * ti[k];
+        }
+
+        magnitudes[c] = std::sqrt(re * re + im * im);
+    }
+}
+
+#endif
+
+namespace {
+
+struct KernelChoice {
+    CorrelateFn fn;
+    const char* name;
+};
+
+KernelChoice select_kernel() {
+#if defined(JS8DSP_SYNC_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return {correlate_avx2, "avx2"};
+    }
+#if defined(__SSE2__)
+    return {correlate_sse2, "sse2"};
+#endif
+#elif defined(JS8DSP_SYNC_NEON)
+    return {correlate_neon, "neon"};
+#endif
+    return {correlate_scalar, "scalar"};
+}
+
+const KernelChoice& kernel_choice() {
+    static const KernelChoice choice = select_kernel();
+    return choice;
+}
+
+} // namespace
+
+CorrelateFn correlate_kernel() {
+    return kernel_choice().fn;
+}
+
+const char* correlate_kernel_name() {
+    return kernel_choice().name;
+}
+
+} // namespace JS8DSP
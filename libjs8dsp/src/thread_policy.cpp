@@ -0,0 +1,171 @@
+/**
+ * CPU pinning, real-time scheduling and memory locking of decode threads
+ *
+ * js8d project
+ */
+
+#include "../include/thread_policy.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <alloca.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace JS8DSP {
+
+#if defined(__linux__)
+
+namespace {
+
+int sched_class(ThreadPolicy::Sched sched) {
+    switch (sched) {
+    case ThreadPolicy::Sched::FIFO: return SCHED_FIFO;
+    case ThreadPolicy::Sched::RR: return SCHED_RR;
+    default: return SCHED_OTHER;
+    }
+}
+
+int pin(const ThreadPolicy& policy, size_t worker) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    const int cpu = policy.cpus[worker % static_cast<size_t>(policy.cpu_count)];
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return EINVAL;
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+int schedule(const ThreadPolicy& policy) {
+    sched_param param{};
+    param.sched_priority = policy.priority;
+    return pthread_setschedparam(pthread_self(), sched_class(policy.sched), &param);
+}
+
+// Lowest address of the calling thread's stack, found once per thread;
+// for the main thread that means reading the process's mappings
+const char* stack_low() {
+    thread_local const char* low = [] {
+        pthread_attr_t attr;
+        void* addr = nullptr;
+        size_t size = 0;
+        if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+            pthread_attr_getstack(&attr, &addr, &size);
+            pthread_attr_destroy(&attr);
+        }
+        return static_cast<const char*>(addr);
+    }();
+    return low;
+}
+
+// Touch bytes of stack below the caller's frame. The main thread's stack
+// is only mapped as far down as it has been used, so this also grows it
+// over them.
+__attribute__((noinline)) void fault_in_stack(size_t bytes, size_t page) {
+    volatile char* stack = static_cast<volatile char*>(alloca(bytes));
+    for (size_t i = 0; i < bytes; i += page) stack[i] = 0;
+}
+
+// Fault in the pages of up to LOCKED_STACK_SIZE of stack below the
+// caller's frame, and of the frame itself, and find where they are; some
+// pages are left above the bottom of the stack for the frames on the way
+void stack_range(const void*& data, size_t& bytes) {
+    const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    volatile char here = 0;
+    const uintptr_t top = (reinterpret_cast<uintptr_t>(&here) + page) & ~(page - 1);
+    uintptr_t bottom = top - LOCKED_STACK_SIZE;
+    const uintptr_t low = reinterpret_cast<uintptr_t>(stack_low());
+    if (low != 0) bottom = std::max(bottom, ((low + page - 1) & ~(page - 1)) + 4 * page);
+
+    data = reinterpret_cast<const void*>(bottom);
+    bytes = top > bottom ? static_cast<size_t>(top - bottom) : 0;
+    if (bytes > 0) fault_in_stack(bytes, static_cast<size_t>(page));
+}
+
+} // namespace
+
+int apply_thread_policy(const ThreadPolicy& policy, size_t worker) {
+    if (policy.pinned()) {
+        if (const int error = pin(policy, worker)) return error;
+    }
+    if (policy.realtime()) {
+        if (const int error = schedule(policy)) return error;
+    }
+    if (policy.lock_memory) {
+        const void* stack;
+        size_t size;
+        stack_range(stack, size);
+        MemoryLock lock(true);
+        lock.add(stack, size);
+        if (lock.error()) return lock.error();
+    }
+    return 0;
+}
+
+ThreadPolicyScope::ThreadPolicyScope(const ThreadPolicy& policy) {
+    if (!policy.active()) return;
+
+    const pthread_t self = pthread_self();
+    if (policy.pinned()) {
+        restore_affinity_ = pthread_getaffinity_np(self, sizeof(affinity_), &affinity_) == 0;
+        error_ = pin(policy, 0);
+    }
+    if (policy.realtime() && error_ == 0) {
+        restore_sched_ = pthread_getschedparam(self, &sched_policy_, &sched_param_) == 0;
+        error_ = schedule(policy);
+    }
+    if (policy.lock_memory && error_ == 0) {
+        const void* stack;
+        size_t size;
+        stack_range(stack, size);
+        MemoryLock lock(true);
+        lock.add(stack, size);
+        error_ = lock.error();
+        if (error_ == 0) {
+            stack_ = stack;
+            stack_size_ = size;
+        }
+    }
+}
+
+ThreadPolicyScope::~ThreadPolicyScope() {
+    const pthread_t self = pthread_self();
+    if (stack_) {
+        MemoryLock unlock(false);
+        unlock.add(stack_, stack_size_);
+    }
+    if (restore_sched_) pthread_setschedparam(self, sched_policy_, &sched_param_);
+    if (restore_affinity_) pthread_setaffinity_np(self, sizeof(affinity_), &affinity_);
+}
+
+void MemoryLock::add(const void* data, size_t bytes) {
+    if (!data || bytes == 0) return;
+
+    bytes_ += bytes;
+    if ((lock_ ? mlock(data, bytes) : munlock(data, bytes)) != 0 && error_ == 0) error_ = errno;
+}
+
+#else
+
+int apply_thread_policy(const ThreadPolicy& policy, size_t) {
+    return policy.active() ? ENOTSUP : 0;
+}
+
+ThreadPolicyScope::ThreadPolicyScope(const ThreadPolicy& policy) {
+    if (policy.active()) error_ = ENOTSUP;
+}
+
+ThreadPolicyScope::~ThreadPolicyScope() = default;
+
+void MemoryLock::add(const void* data, size_t bytes) {
+    if (!data || bytes == 0) return;
+
+    bytes_ += bytes;
+    if (lock_ && error_ == 0) error_ = ENOTSUP;
+}
+
+#endif
+
+} // namespace JS8DSP
@@ -0,0 +1,205 @@
+/**
+ * Work-stealing thread pool for parallel candidate decoding
+ *
+ * js8d project
+ */
+
+#include "../include/thread_pool.h"
+#include <algorithm>
+
+namespace JS8DSP {
+
+ThreadPool::ThreadPool(int threads, const ThreadPolicy& policy) {
+    const size_t count = static_cast<size_t>(std::max(threads, 1));
+
+    queues_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+
+    threads_.reserve(count - 1);
+    for (size_t i = 1; i < count; ++i) {
+        threads_.emplace_back(&ThreadPool::worker_loop, this, i, policy);
+    }
+
+    // Wait for the threads to take the policy, so policy_error() is known
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return started_ == threads_.size(); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+size_t ThreadPool::rank(size_t index, size_t count) const {
+    const size_t workers = queues_.size();
+    if (workers == 1 || count <= 1) return index;
+
+    // Find the block and offset of index within it, with the blocks split
+    // as run() does
+    const size_t block = count / workers;
+    const size_t extra = count % workers;
+    const size_t long_blocks = extra * (block + 1);
+
+    size_t worker;
+    size_t offset;
+    if (index < long_blocks) {
+        worker = index / (block + 1);
+        offset = index % (block + 1);
+    } else {
+        worker = extra + (index - long_blocks) / block;
+        offset = (index - long_blocks) % block;
+    }
+
+    return offset * workers + worker;
+}
+
+void ThreadPool::run(size_t count, Task task, void* context) {
+    if (count == 0) return;
+
+    const size_t workers = queues_.size();
+
+    // Serial fast path; no point waking anyone for a single worker
+    if (workers == 1 || count == 1) {
+        for (size_t i = 0; i < count; ++i) task(context, i, 0);
+        return;
+    }
+
+    // Hand out contiguous blocks; the first count % workers blocks take
+    // one extra index
+    const size_t block = count / workers;
+    const size_t extra = count % workers;
+    size_t begin = 0;
+
+    for (size_t w = 0; w < workers; ++w) {
+        size_t end = begin + block + (w < extra ? 1 : 0);
+        std::lock_guard<std::mutex> lock(queues_[w]->mutex);
+        queues_[w]->begin = begin;
+        queues_[w]->end = end;
+        begin = end;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = task;
+        context_ = context;
+        pending_.store(count, std::memory_order_relaxed);
+        busy_ = threads_.size();
+        ++generation_;
+    }
+    start_cv_.notify_all();
+
+    drain(0);
+
+    // Wait until every index has run and every worker has left drain(), so
+    // nothing touches the task context after we return
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] {
+        return busy_ == 0 && pending_.load(std::memory_order_acquire) == 0;
+    });
+    task_ = nullptr;
+    context_ = nullptr;
+}
+
+void ThreadPool::worker_loop(size_t worker, ThreadPolicy policy) {
+    const int error = apply_thread_policy(policy, worker);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error && !policy_error_) policy_error_ = error;
+        ++started_;
+    }
+    done_cv_.notify_one();
+
+    uint64_t seen = 0;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+        }
+
+        drain(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --busy_;
+        }
+        done_cv_.notify_one();
+    }
+}
+
+void ThreadPool::drain(size_t worker) {
+    size_t index;
+
+    while (pop(worker, index) || steal(worker, index)) {
+        task_(context_, index, worker);
+        pending_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+bool ThreadPool::pop(size_t worker, size_t& index) {
+    Queue& queue = *queues_[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.begin == queue.end) return false;
+
+    index = queue.begin++;
+    return true;
+}
+
+bool ThreadPool::steal(size_t worker, size_t& index) {
+    Queue& own = *queues_[worker];
+
+    for (;;) {
+        // Pick the victim with the most work left; sizes are read without
+        // locking, so recheck under the victim's lock below
+        size_t victim = worker;
+        size_t most = 0;
+
+        for (size_t w = 0; w < queues_.size(); ++w) {
+            if (w == worker) continue;
+            std::lock_guard<std::mutex> lock(queues_[w]->mutex);
+            size_t remaining = queues_[w]->end - queues_[w]->begin;
+            if (remaining > most) {
+                most = remaining;
+                victim = w;
+            }
+        }
+
+        if (victim == worker) return false;
+
+        size_t begin;
+        size_t end;
+        {
+            Queue& queue = *queues_[victim];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            size_t remaining = queue.end - queue.begin;
+            if (remaining == 0) continue;
+
+            // Leave the victim the front half it is about to work on
+            size_t take = (remaining + 1) / 2;
+            end = queue.end;
+            begin = end - take;
+            queue.end = begin;
+        }
+
+        std::lock_guard<std::mutex> lock(own.mutex);
+        index = begin;
+        own.begin = begin + 1;
+        own.end = end;
+        return true;
+    }
+}
+
+} // namespace JS8DSP
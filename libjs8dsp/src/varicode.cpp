@@ -8,9 +8,9 @@
 
 #include "../include/varicode.h"
 #include <cstring>
+#include <cstdint>
 #include <algorithm>
-#include <unordered_map>
-#include <string>
+#include <array>
 
 // JS8 alphabet constants (extracted from original varicode.cpp)
 const char* js8_alphabet = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ+-./?";
@@ -18,133 +18,296 @@ const char* js8_alphabet72 = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmn
 
 namespace JS8DSP {
 
-class VaricodeEncoder {
-private:
-    std::unordered_map<char, std::string> encode_map_;
-    std::unordered_map<std::string, char> decode_map_;
-
-    void initialize_maps() {
-        // Actual Huffman varicode table extracted from JS8Call
-        const std::pair<char, const char*> huffman_table[] = {
-            {' ', "01"},           // Space - most common
-            {'E', "100"},          // E - most common letter
-            {'T', "1101"},
-            {'A', "0011"},
-            {'O', "11111"},
-            {'I', "11100"},
-            {'N', "10111"},
-            {'S', "10100"},
-            {'H', "00011"},
-            {'R', "00000"},
-            {'D', "111011"},
-            {'L', "110011"},
-            {'C', "110001"},
-            {'U', "101101"},
-            {'M', "101011"},
-            {'W', "001011"},
-            {'F', "001001"},
-            {'G', "000101"},
-            {'Y', "000011"},
-            {'P', "1111011"},
-            {'B', "1111001"},
-            {'.', "1110100"},
-            {'V', "1100101"},
-            {'K', "1100100"},
-            {'-', "1100001"},
-            {'+', "1100000"},
-            {'?', "1011001"},
-            {'!', "1011000"},
-            {'"', "1010101"},
-            {'X', "1010100"},
-            {'0', "0010101"},
-            {'J', "0010100"},
-            {'1', "0010001"},
-            {'Q', "0010000"},
-            {'2', "0001001"},
-            {'Z', "0001000"},
-            {'3', "0000101"},
-            {'5', "0000100"},
-            {'4', "11110101"},
-            {'9', "11110100"},
-            {'8', "11110001"},
-            {'6', "11110000"},
-            {'7', "11101011"},
-            {'/', "11101010"}
-        };
-
-        // Build encode and decode maps
-        for (const auto& entry : huffman_table) {
-            encode_map_[entry.first] = entry.second;
-            decode_map_[entry.second] = entry.first;
+namespace {
+
+// Huffman varicode table extracted from JS8Call; a complete prefix code
+struct VaricodeEntry {
+    char character;
+    const char* code;
+};
+
+constexpr VaricodeEntry HUFFMAN_TABLE[] = {
+    {' ', "01"},           // Space - most common
+    {'E', "100"},          // E - most common letter
+    {'T', "1101"},
+    {'A', "0011"},
+    {'O', "11111"},
+    {'I', "11100"},
+    {'N', "10111"},
+    {'S', "10100"},
+    {'H', "00011"},
+    {'R', "00000"},
+    {'D', "111011"},
+    {'L', "110011"},
+    {'C', "110001"},
+    {'U', "101101"},
+    {'M', "101011"},
+    {'W', "001011"},
+    {'F', "001001"},
+    {'G', "000101"},
+    {'Y', "000011"},
+    {'P', "1111011"},
+    {'B', "1111001"},
+    {'.', "1110100"},
+    {'V', "1100101"},
+    {'K', "1100100"},
+    {'-', "1100001"},
+    {'+', "1100000"},
+    {'?', "1011001"},
+    {'!', "1011000"},
+    {'"', "1010101"},
+    {'X', "1010100"},
+    {'0', "0010101"},
+    {'J', "0010100"},
+    {'1', "0010001"},
+    {'Q', "0010000"},
+    {'2', "0001001"},
+    {'Z', "0001000"},
+    {'3', "0000101"},
+    {'5', "0000100"},
+    {'4', "11110101"},
+    {'9', "11110100"},
+    {'8', "11110001"},
+    {'6', "11110000"},
+    {'7', "11101011"},
+        {'/', "11101010"}
+
+};
+
+constexpr int MAX_CODE_LENGTH = 8;
+
+struct DecodeEntry {
+    char character;
+    uint8_t length;     // Bits of the code starting the looked-up byte
+};
+
+constexpr int code_length(const char* code) {
+    int length = 0;
+    while (code[length]) ++length;
+    return length;
+}
+
+constexpr char to_upper(char c) {
+    return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+// Encode table indexed by 7-bit character; lower case letters encode as
+// upper case
+constexpr auto ENCODE_TABLE = []() {
+    std::array<VaricodeCode, 128> table{};
+    for (const auto& entry : HUFFMAN_TABLE) {
+        VaricodeCode code{0, static_cast<uint8_t>(code_length(entry.code))};
+        for (int i = 0; i < code.length; ++i) {
+            code.bits = static_cast<uint8_t>(code.bits << 1 | (entry.code[i] == '1'));
         }
+        table[static_cast<unsigned char>(entry.character)] = code;
+    }
+    for (char c = 'a'; c <= 'z'; ++c) table[static_cast<unsigned char>(c)] = table[to_upper(c)];
+    return table;
+}();
+
+// Decode table indexed by the next MAX_CODE_LENGTH bits of the stream;
+// every byte starts with exactly one code since the code is complete
+constexpr auto DECODE_TABLE = []() {
+    std::array<DecodeEntry, 1 << MAX_CODE_LENGTH> table{};
+    for (const auto& entry : HUFFMAN_TABLE) {
+        const VaricodeCode code = ENCODE_TABLE[static_cast<unsigned char>(entry.character)];
+        const int shift = MAX_CODE_LENGTH - code.length;
+        for (int rest = 0; rest < (1 << shift); ++rest) {
+            table[code.bits << shift | rest] = DecodeEntry{entry.character, code.length};
+        }
+    }
+    return table;
+}();
+
+constexpr bool decode_table_complete() {
+    for (const auto& entry : DECODE_TABLE) {
+        if (entry.length == 0) return false;
     }
+    return true;
+}
+static_assert(decode_table_complete(), "varicode table must be a complete prefix code");
+
+inline VaricodeCode lookup_code(char c) {
+    const auto index = static_cast<unsigned char>(c);
+    return index < ENCODE_TABLE.size() ? ENCODE_TABLE[index] : VaricodeCode{0, 0};
+}
 
+// Bit sources for the table decoder: a '0'/'1' character string, in
+// which other characters are skipped, or a packed buffer, first bit in
+// the most significant bit of the first byte
+class SymbolBits {
 public:
-    VaricodeEncoder() {
-        initialize_maps();
+    explicit SymbolBits(const char* symbols) : p_(symbols) { fill(); }
+
+    // The next MAX_CODE_LENGTH bits, zero padded past the end
+    unsigned peek(int& available) const {
+        available = count_;
+        return window_ << (MAX_CODE_LENGTH - count_);
     }
 
-    std::string encode_message(const char* message) {
-        if (!message) return "";
+    void consume(int bits) {
+        count_ -= bits;
+        window_ &= (1u << count_) - 1;
+        fill();
+    }
 
-        std::string encoded;
-        for (const char* p = message; *p; p++) {
-            char c = std::toupper(*p);
-            auto it = encode_map_.find(c);
-            if (it != encode_map_.end()) {
-                encoded += it->second;
-                // In real varicode, there's no separator - codes are prefix-free
-            } else {
-                // Handle unknown characters - could skip or use default
-                // For now, skip unknown characters
+private:
+    void fill() {
+        while (count_ < MAX_CODE_LENGTH && *p_) {
+            const char c = *p_++;
+            if (c == '0' || c == '1') {
+                window_ = window_ << 1 | static_cast<unsigned>(c == '1');
+                ++count_;
             }
         }
-        return encoded;
     }
 
-    std::string decode_symbols(const char* symbols) {
-        if (!symbols) return "";
+    const char* p_;
+    unsigned window_ = 0;
+    int count_ = 0;
+};
 
-        std::string decoded;
-        std::string current_code;
+class PackedBits {
+public:
+    PackedBits(const uint8_t* bits, size_t bit_count) : bits_(bits), bit_count_(bit_count) {}
 
-        // Parse bit stream using prefix-free property
-        for (const char* p = symbols; *p; p++) {
-            if (*p == '0' || *p == '1') {
-                current_code += *p;
+    unsigned peek(int& available) const {
+        const size_t remaining = bit_count_ - position_;
+        available = static_cast<int>(std::min<size_t>(remaining, MAX_CODE_LENGTH));
 
-                // Check if current code matches any character
-                auto it = decode_map_.find(current_code);
-                if (it != decode_map_.end()) {
-                    decoded += it->second;
-                    current_code.clear();
-                }
-                // If code gets too long without match, it might be corrupted
-                else if (current_code.length() > 10) {
-                    // Skip this bit and try to resync
-                    current_code.erase(0, 1);
-                }
+        unsigned window = 0;
+        for (int i = 0; i < available; ++i) {
+            const size_t bit = position_ + i;
+            window = window << 1 | ((bits_[bit >> 3] >> (7 - (bit & 7))) & 1u);
+        }
+        return window << (MAX_CODE_LENGTH - available);
+    }
+
+    void consume(int bits) { position_ += bits; }
+
+private:
+    const uint8_t* bits_;
+    size_t bit_count_;
+    size_t position_ = 0;
+};
+
+// Decode codes from a bit source into output; stops at the end of the
+// stream or at a partial code. Returns the decoded length, or -1 if the
+// output (including its terminator) does not fit.
+template <typename Bits>
+int decode_bits(Bits bits, char* output, size_t output_size) {
+    size_t length = 0;
+
+    for (;;) {
+        int available = 0;
+        const unsigned window = bits.peek(available);
+        const DecodeEntry& entry = DECODE_TABLE[window];
+        if (available == 0 || entry.length > available) break;
+
+        if (length + 1 >= output_size) return -1;
+        output[length++] = entry.character;
+        bits.consume(entry.length);
+    }
+
+    output[length] = '\0';
+    return static_cast<int>(length);
+}
+
+} // namespace
+
+class VaricodeEncoder {
+public:
+    // Encode message as a '0'/'1' string into output; returns its length,
+    // or -1 if it does not fit. Characters without a code are skipped.
+    int encode_message(const char* message, char* output, size_t output_size) const {
+        size_t length = 0;
+
+        for (const char* p = message; *p; p++) {
+            const VaricodeCode code = lookup_code(*p);
+            if (length + code.length >= output_size) return -1;
+            for (int i = code.length - 1; i >= 0; --i) {
+                output[length++] = (code.bits >> i) & 1 ? '1' : '0';
             }
-            // Skip non-binary characters
         }
 
-        return decoded;
+        output[length] = '\0';
+        return static_cast<int>(length);
     }
 
-    bool is_valid_message(const char* message) {
-        if (!message) return false;
+    // Encode message into packed bits; returns the number of bits, or -1
+    // if they do not fit in output_size bytes
+    int encode_bits(const char* message, uint8_t* output, size_t output_size) const {
+        size_t bit_count = 0;
 
-        // Basic validation - check if all characters are in alphabet
         for (const char* p = message; *p; p++) {
-            char c = std::toupper(*p);
-            if (encode_map_.find(c) == encode_map_.end()) {
-                return false;
+            const VaricodeCode code = lookup_code(*p);
+            if (bit_count + code.length > output_size * 8) return -1;
+            for (int i = code.length - 1; i >= 0; --i, ++bit_count) {
+                const uint8_t mask = static_cast<uint8_t>(0x80u >> (bit_count & 7));
+                if ((code.bits >> i) & 1) {
+                    output[bit_count >> 3] |= mask;
+                } else {
+                    output[bit_count >> 3] &= static_cast<uint8_t>(~mask);
+                }
             }
         }
+
+        return static_cast<int>(bit_count);
+    }
+
+    int decode_symbols(const char* symbols, char* output, size_t output_size) const {
+        return decode_bits(SymbolBits(symbols), output, output_size);
+    }
+
+    int decode_bits_packed(const uint8_t* bits, size_t bit_count, char* output, size_t output_size) const {
+        return varicode_decode_packed(bits, bit_count, output, output_size);
+    }
+
+    bool is_valid_message(const char* message) const {
+        // Check all characters are in the alphabet
+        for (const char* p = message; *p; p++) {
+            if (lookup_code(*p).length == 0) return false;
+        }
         return true;
     }
 };
 
+namespace {
+
+// Run one encode or decode per input into consecutive parts of output
+template <typename F>
+int run_batch(const char* const* inputs, size_t count, char* output, size_t output_size,
+             int* lengths, F&& convert) {
+    size_t used = 0;
+    size_t done = 0;
+
+    for (; done < count; ++done) {
+        int length = -1;
+        if (inputs[done] && used < output_size) {
+            length = convert(inputs[done], output + used, output_size - used);
+        }
+        if (length < 0) break;
+
+        lengths[done] = length;
+        used += static_cast<size_t>(length) + 1;
+    }
+
+    for (size_t i = done; i < count; ++i) lengths[i] = -1;
+    return static_cast<int>(done);
+}
+
+} // namespace
+
+VaricodeCode varicode_code(char c) {
+    return lookup_code(c);
+}
+
+int varicode_decode_packed(const uint8_t* bits, size_t bit_count, char* output, size_t output_size) {
+    if (output_size == 0) return -1;
+    return decode_bits(PackedBits(bits, bit_count), output, output_size);
+}
+
 } // namespace JS8DSP
 
 // C API implementation
@@ -181,16 +344,10 @@ int varicode_encode_message(varicode_encoder_t* encoder,
     }
 
     auto ctx = reinterpret_cast<varicode_encoder_context*>(encoder);
-    std::string encoded = ctx->encoder->encode_message(message);
-
-    if (encoded.length() >= output_size) {
-        return -1; // Buffer too small
-    }
+    int length = ctx->encoder->encode_message(message, output, output_size);
+    if (length < 0) output[0] = '\0';
 
-    strncpy(output, encoded.c_str(), output_size - 1);
-    output[output_size - 1] = '\0';
-
-    return static_cast<int>(encoded.length());
+    return length;
 }
 
 int varicode_decode_symbols(varicode_encoder_t* encoder,
@@ -202,16 +359,72 @@ int varicode_decode_symbols(varicode_encoder_t* encoder,
     }
 
     auto ctx = reinterpret_cast<varicode_encoder_context*>(encoder);
-    std::string decoded = ctx->encoder->decode_symbols(symbols);
+    int length = ctx->encoder->decode_symbols(symbols, output, output_size);
+    if (length < 0) output[0] = '\0';
+
+    return length;
+}
+
+int varicode_encode_bits(varicode_encoder_t* encoder,
+                         const char* message,
+                         uint8_t* output,
+                         size_t output_size) {
+    if (!encoder || !message || !output) {
+        return -1;
+    }
+
+    auto ctx = reinterpret_cast<varicode_encoder_context*>(encoder);
+    return ctx->encoder->encode_bits(message, output, output_size);
+}
 
-    if (decoded.length() >= output_size) {
-        return -1; // Buffer too small
+int varicode_decode_bits(varicode_encoder_t* encoder,
+                         const uint8_t* bits,
+                         size_t bit_count,
+                         char* output,
+                         size_t output_size) {
+    if (!encoder || (!bits && bit_count > 0) || !output || output_size == 0) {
+        return -1;
     }
 
-    strncpy(output, decoded.c_str(), output_size - 1);
-    output[output_size - 1] = '\0';
+    auto ctx = reinterpret_cast<varicode_encoder_context*>(encoder);
+    int length = ctx->encoder->decode_bits_packed(bits, bit_count, output, output_size);
+    if (length < 0) output[0] = '\0';
 
-    return static_cast<int>(decoded.length());
+    return length;
+}
+
+int varicode_encode_batch(varicode_encoder_t* encoder,
+                          const char* const* messages,
+                          size_t count,
+                          char* output,
+                          size_t output_size,
+                          int* lengths) {
+    if (!encoder || !messages || !output || !lengths) {
+        return -1;
+    }
+
+    auto ctx = reinterpret_cast<varicode_encoder_context*>(encoder);
+    return JS8DSP::run_batch(messages, count, output, output_size, lengths,
+                     [ctx](const char* message, char* out, size_t size) {
+                         return ctx->encoder->encode_message(message, out, size);
+                     });
+}
+
+int varicode_decode_batch(varicode_encoder_t* encoder,
+                          const char* const* symbols,
+                          size_t count,
+                          char* output,
+                          size_t output_size,
+                          int* lengths) {
+    if (!encoder || !symbols || !output || !lengths) {
+        return -1;
+    }
+
+    auto ctx = reinterpret_cast<varicode_encoder_context*>(encoder);
+    return JS8DSP::run_batch(symbols, count, output, output_size, lengths,
+                     [ctx](const char* input, char* out, size_t size) {
+                         return ctx->encoder->decode_symbols(input, out, size);
+                     });
 }
 
 int varicode_validate_message(varicode_encoder_t* encoder, const char* message) {
@@ -1,7 +1,68 @@
 #include "js8dsp.h"
+#include "arena.h"
+#include "baseline_computation.h"
+#include "bp_decoder.h"
+#include "osd_decoder.h"
+#include "resampler.h"
+#include "fft.h"
+#include "js8_encoder.h"
+#include "mode_tables.h"
+#include "sample_convert.h"
+#include "sync_kernels.h"
 #include "varicode.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <new>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+// Count heap allocations so we can verify that steady-state decoding
+// does not touch the allocator
+static std::atomic<size_t> g_allocations{0};
+
+void* operator new(size_t size) {
+    ++g_allocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+// Tally of decode events seen by the event callback test
+struct EventCounts {
+    int started = 0;
+    int sync_start = 0;
+    int sync_state = 0;
+    int decoded = 0;
+    int finished = 0;
+    uint32_t finished_total = 0;
+    uint64_t finished_ns = 0;
+};
+
+static void count_event(const js8dsp_event_t* event, void* user_data) {
+    auto counts = static_cast<EventCounts*>(user_data);
+    switch (event->type) {
+    case JS8DSP_EVENT_DECODE_STARTED: ++counts->started; break;
+    case JS8DSP_EVENT_SYNC_START: ++counts->sync_start; break;
+    case JS8DSP_EVENT_SYNC_STATE: ++counts->sync_state; break;
+    case JS8DSP_EVENT_DECODED: ++counts->decoded; break;
+    case JS8DSP_EVENT_DECODE_FINISHED:
+        ++counts->finished;
+        counts->finished_total += event->data.decode_finished.decoded;
+        counts->finished_ns = event->data.decode_finished.elapsed_ns;
+        break;
+    }
+}
 
 int main() {
     printf("JS8DSP Library Test\n");
@@ -55,10 +116,1320 @@ int main() {
         printf("ERROR: Failed to encode message\n");
     }
 
-    // Test buffer size calculation
-    int buffer_size = js8dsp_get_encode_buffer_size(handle, test_message);
-    if (buffer_size > 0) {
-        printf("✓ Required buffer size: %d samples\n", buffer_size);
+    // Packed bits must carry the same code as the symbol string
+    {
+        uint8_t bits[64];
+        char decoded[256];
+        int bit_count = varicode_encode_bits(encoder, test_message, bits, sizeof(bits));
+        int decode_result = bit_count > 0
+            ? varicode_decode_bits(encoder, bits, bit_count, decoded, sizeof(decoded))
+            : -1;
+        bool same_bits = bit_count == encode_result;
+        for (int i = 0; same_bits && i < bit_count; ++i) {
+            same_bits = ((bits[i >> 3] >> (7 - (i & 7))) & 1) == (encoded[i] == '1');
+        }
+        if (decode_result < 0 || !same_bits || strcmp(decoded, test_message) != 0) {
+            printf("ERROR: Packed varicode round trip failed (%d bits)\n", bit_count);
+            varicode_encoder_destroy(encoder);
+            js8dsp_cleanup(handle);
+            return 1;
+        }
+        printf("✓ Packed varicode round trip: %d bits\n", bit_count);
+    }
+
+    // Batch encode and decode into caller buffers without allocating
+    {
+        const char* messages[] = {"CQ CQ DE N0CALL", "hello world", "73 DE K1ABC/P"};
+        const char* expected[] = {"CQ CQ DE N0CALL", "HELLO WORLD", "73 DE K1ABC/P"};
+        char symbols[1024];
+        char text[256];
+        int symbol_lengths[3];
+        int text_lengths[3];
+        const char* inputs[3];
+
+        size_t before = g_allocations.load();
+        int encoded_count = varicode_encode_batch(encoder, messages, 3, symbols, sizeof(symbols), symbol_lengths);
+        size_t offset = 0;
+        for (int i = 0; i < 3 && i < encoded_count; ++i) {
+            inputs[i] = symbols + offset;
+            offset += symbol_lengths[i] + 1;
+        }
+        int decoded_count = encoded_count == 3
+            ? varicode_decode_batch(encoder, inputs, 3, text, sizeof(text), text_lengths)
+            : -1;
+        size_t allocations = g_allocations.load() - before;
+
+        bool batch_ok = decoded_count == 3 && allocations == 0;
+        offset = 0;
+        for (int i = 0; batch_ok && i < 3; ++i) {
+            batch_ok = strcmp(text + offset, expected[i]) == 0;
+            offset += text_lengths[i] + 1;
+        }
+
+        // A buffer too small for the second message stops the batch there
+        int short_lengths[3];
+        int short_count = varicode_encode_batch(encoder, messages, 3, symbols, symbol_lengths[0] + 2, short_lengths);
+        batch_ok = batch_ok && short_count == 1 && short_lengths[1] == -1 && short_lengths[2] == -1;
+
+        if (!batch_ok) {
+            printf("ERROR: Varicode batch failed (%d encoded, %d decoded, %zu allocations)\n",
+                   encoded_count, decoded_count, allocations);
+            varicode_encoder_destroy(encoder);
+            js8dsp_cleanup(handle);
+            return 1;
+        }
+        printf("✓ Varicode batch of 3 round-tripped with no heap allocations\n");
+    }
+
+    // Pack and unpack each kind of frame without allocating
+    printf("\nTesting frame codec...\n");
+    {
+        struct FrameCase {
+            const char* text;
+            int packed;
+            js8dsp_frame_type_t type;
+            const char* unpacked;
+        };
+        const FrameCase cases[] = {
+            {"CQ CQ EM73", 10, JS8DSP_FRAME_HEARTBEAT, "KN4CRD: @ALLCALL CQ CQ EM73"},
+            {"HB EM73", 7, JS8DSP_FRAME_HEARTBEAT, "KN4CRD: @HB HEARTBEAT EM73"},
+            {"`KN4CRD/P EM73", 14, JS8DSP_FRAME_COMPOUND, "KN4CRD/P: EM73"},
+            {"J1Y SNR -05", 11, JS8DSP_FRAME_DIRECTED, "KN4CRD: J1Y SNR -05"},
+            {"J1Y SNR? HELLO", 8, JS8DSP_FRAME_DIRECTED, "KN4CRD: J1Y SNR?"},
+            {"@ALLCALL QSL?", 13, JS8DSP_FRAME_DIRECTED, "KN4CRD: @ALLCALL QSL?"},
+            {"HELLO WORLD", 11, JS8DSP_FRAME_DATA, "HELLO WORLD"},
+        };
+
+        size_t before = g_allocations.load();
+        bool frames_ok = true;
+        for (const auto& c : cases) {
+            js8dsp_frame_t frame;
+            js8dsp_frame_type_t type = JS8DSP_FRAME_UNKNOWN;
+            int packed = js8dsp_frame_pack(c.text, "KN4CRD", &frame, &type);
+
+            char frame_text[13];
+            js8dsp_frame_t round_trip = {0, 0};
+            js8dsp_frame_to_text(&frame, frame_text, sizeof(frame_text));
+            js8dsp_frame_from_text(frame_text, &round_trip);
+
+            char unpacked[128];
+            int length = js8dsp_frame_unpack(&round_trip, 0, unpacked, sizeof(unpacked), &type);
+            if (packed != c.packed || type != c.type || length < 0 || strcmp(unpacked, c.unpacked) != 0) {
+                printf("ERROR: Frame '%s' packed %d chars, unpacked '%s'\n", c.text, packed, length < 0 ? "" : unpacked);
+                frames_ok = false;
+            }
+        }
+        size_t allocations = g_allocations.load() - before;
+
+        // Free text with nothing directed in it is not a frame of its own
+        js8dsp_frame_t frame;
+        if (js8dsp_frame_pack("hello\x01", "KN4CRD", &frame, nullptr) != 0) frames_ok = false;
+
+        if (!frames_ok || allocations != 0) {
+            printf("ERROR: Frame codec failed (%zu allocations)\n", allocations);
+            varicode_encoder_destroy(encoder);
+            js8dsp_cleanup(handle);
+            return 1;
+        }
+        printf("✓ %zu frames packed and unpacked with no heap allocations\n", sizeof(cases) / sizeof(cases[0]));
+    }
+
+    // Test the tones of a frame are a codeword the LDPC decoder accepts
+    // as it stands, carrying the frame bits
+    printf("\nTesting encoder...\n");
+    {
+        JS8DSP::Frame72 frame{0x0123456789abcdefull, 0x5a};
+        JS8DSP::ToneSequence tones;
+        JS8DSP::encode_tones(frame, JS8DSP::TRANSMISSION_FIRST | JS8DSP::TRANSMISSION_LAST,
+                             JS8Constants::Mode::NORMAL, tones);
+
+        std::array<float, BPDSP::N> llr;
+        for (int j = 0; j < JS8Constants::ND; ++j) {
+            const int tone = tones[j < 29 ? j + 7 : j + 14];
+            for (int b = 0; b < 3; ++b) llr[3 * j + b] = ((tone >> (2 - b)) & 1) ? 3.0f : -3.0f;
+        }
+        std::array<int8_t, BPDSP::K> decoded;
+        std::array<int8_t, BPDSP::N> codeword;
+        int errors = BPDSP::bpdecode174(llr, decoded, codeword);
+
+        uint64_t value = 0;
+        uint8_t rem = 0;
+        for (int i = 0; i < 64; ++i) value = (value << 1) | decoded[i];
+        for (int i = 64; i < 72; ++i) rem = static_cast<uint8_t>((rem << 1) | decoded[i]);
+        int transmission = (decoded[72] << 2) | (decoded[73] << 1) | decoded[74];
+        if (errors != 0 || value != frame.value || rem != frame.rem || transmission != 3 ||
+            !std::equal(tones.begin(), tones.begin() + 7, JS8Constants::COSTAS_ORIGINAL[0])) {
+            printf("ERROR: Encoded tones decode with %d errors\n", errors);
+            return 1;
+        }
+        printf("✓ Encoded tones are a valid codeword\n");
+    }
+
+    // Test a message rendered at 48 kHz decodes, without allocating
+    {
+        js8dsp_handle_t tx = js8dsp_init(48000, JS8DSP_MODE_NORMAL);
+        const int buffer_size = js8dsp_get_encode_buffer_size(tx, "HELLO WORLD");
+        if (buffer_size != 79 * 1920 * 4) {
+            printf("ERROR: Encode buffer size %d samples\n", buffer_size);
+            return 1;
+        }
+
+        std::vector<float> slot(48000 * 15);
+        const size_t start = 24000;   // Transmissions start 0.5 s into the slot
+        size_t before = g_allocations.load();
+        int rendered = js8dsp_encode_message(tx, "HELLO WORLD", slot.data() + start, buffer_size);
+        size_t allocations = g_allocations.load() - before;
+        float peak = 0.0f;
+        for (float sample : slot) peak = std::max(peak, std::fabs(sample));
+
+        // Offsets are reported from 1500 Hz
+        js8dsp_decoded_message_t decoded[64];
+        int count = js8dsp_decode_buffer(tx, slot.data(), slot.size(), decoded, 64);
+        bool found = false;
+        for (int i = 0; i < count; ++i) {
+            found = found || (strcmp(decoded[i].message, "HELLO WORLD") == 0 &&
+                              std::fabs(decoded[i].freq_offset + 1500.0f - JS8DSP_DEFAULT_TX_FREQUENCY) < 3.0f);
+        }
+
+        bool checked = js8dsp_encode_message(tx, "HELLO WORLD", slot.data(), buffer_size - 1) ==
+                           JS8DSP_INVALID_PARAM &&
+                       js8dsp_set_tx_frequency(tx, 23990.0f) == JS8DSP_INVALID_PARAM &&
+                       js8dsp_set_tx_frequency(tx, 1000.0f) == JS8DSP_OK;
+        js8dsp_cleanup(tx);
+
+        if (rendered != buffer_size || allocations != 0 || peak > 1.0f || !found || !checked) {
+            printf("ERROR: Encoded message rendered %d samples (%zu allocations), %d decodes\n",
+                   rendered, allocations, count);
+            return 1;
+        }
+        printf("✓ Encoded %d samples with no heap allocations and decoded them\n", rendered);
+    }
+
+    // Test FFT plans
+    printf("\nTesting FFT...\n");
+    {
+        using JS8DSP::FFTPlanManager;
+        using JS8DSP::FFTKind;
+        using JS8DSP::FFTDirection;
+
+        const size_t n = 3840;
+        const auto& real_plan = FFTPlanManager::instance().get(n, FFTKind::REAL, FFTDirection::FORWARD);
+        const auto& forward = FFTPlanManager::instance().get(n, FFTKind::COMPLEX, FFTDirection::FORWARD);
+        const auto& backward = FFTPlanManager::instance().get(n, FFTKind::COMPLEX, FFTDirection::BACKWARD);
+
+        std::vector<float> tone(n);
+        for (size_t i = 0; i < n; ++i) {
+            tone[i] = std::cos(2.0f * static_cast<float>(M_PI) * 37.0f * i / n);
+        }
+        std::vector<JS8DSP::Complex> bins(n / 2 + 1);
+        std::vector<JS8DSP::Complex> work(std::max(real_plan.workspace_size(), forward.workspace_size()) + 1);
+        real_plan.execute(tone.data(), bins.data(), work.data());
+
+        size_t peak = 0;
+        for (size_t k = 1; k < bins.size(); ++k) {
+            if (std::norm(bins[k]) > std::norm(bins[peak])) peak = k;
+        }
+        if (peak != 37 || std::fabs(std::abs(bins[peak]) - n / 2.0f) > 0.01f * n) {
+            printf("ERROR: Real FFT peak at bin %zu (expected 37)\n", peak);
+            return 1;
+        }
+
+        std::vector<JS8DSP::Complex> signal(n);
+        for (size_t i = 0; i < n; ++i) signal[i] = JS8DSP::Complex(tone[i], 0.5f * tone[(i * 7) % n]);
+        std::vector<JS8DSP::Complex> round_trip(signal);
+        forward.execute(round_trip.data(), round_trip.data(), work.data());
+        backward.execute(round_trip.data(), round_trip.data(), work.data());
+
+        float max_error = 0.0f;
+        for (size_t i = 0; i < n; ++i) {
+            max_error = std::max(max_error, std::abs(round_trip[i] / static_cast<float>(n) - signal[i]));
+        }
+        if (max_error > 1e-4f) {
+            printf("ERROR: FFT round trip error %g\n", max_error);
+            return 1;
+        }
+        printf("✓ FFT tone peak and round trip correct\n");
+    }
+
+    // Test belief propagation corrects a few weak wrong bits of the
+    // all-zero codeword
+    printf("\nTesting LDPC decoder...\n");
+    {
+        std::array<float, BPDSP::N> llr;
+        llr.fill(-3.0f);
+        const int flipped[] = {3, 40, 77, 120, 171};
+        for (int bit : flipped) llr[bit] = 1.0f;
+
+        std::array<int8_t, BPDSP::K> decoded;
+        std::array<int8_t, BPDSP::N> codeword;
+        int errors = BPDSP::bpdecode174(llr, decoded, codeword);
+        bool zero = std::all_of(codeword.begin(), codeword.end(), [](int8_t bit) { return bit == 0; });
+        if (errors != 5 || !zero) {
+            printf("ERROR: LDPC decode returned %d hard errors\n", errors);
+            return 1;
+        }
+        printf("✓ LDPC decoder corrected %d bit errors\n", errors);
+
+        // The min-sum decoder handles the same codeword alongside others
+        std::array<float, BPDSP::N> clean;
+        clean.fill(-3.0f);
+        const std::array<float, BPDSP::N>* batch_llr[] = {&clean, &llr, &clean};
+        std::array<int8_t, BPDSP::K> batch_decoded[3];
+        std::array<int8_t, BPDSP::N> batch_codeword[3];
+        std::array<int8_t, BPDSP::K>* decoded_out[] = {&batch_decoded[0], &batch_decoded[1], &batch_decoded[2]};
+        std::array<int8_t, BPDSP::N>* codeword_out[] = {&batch_codeword[0], &batch_codeword[1], &batch_codeword[2]};
+        int nerr[3];
+        BPDSP::minsum_decode174(batch_llr, 3, decoded_out, codeword_out, nerr);
+        for (int lane = 0; lane < 3; ++lane) {
+            const int expected = lane == 1 ? 5 : 0;
+            bool lane_zero = std::all_of(batch_codeword[lane].begin(), batch_codeword[lane].end(),
+                                         [](int8_t bit) { return bit == 0; });
+            if (nerr[lane] != expected || !lane_zero) {
+                printf("ERROR: Min-sum lane %d returned %d hard errors\n", lane, nerr[lane]);
+                return 1;
+            }
+        }
+        printf("✓ Min-sum decoder corrected a batch of 3 codewords\n");
+
+        // OSD recovers errors on the least reliable bits even when they are
+        // too many for belief propagation, and one error on a reliable bit
+        std::array<float, BPDSP::N> noisy;
+        for (int i = 0; i < BPDSP::N; ++i) noisy[i] = -2.0f - 0.01f * i;
+        for (int i = 0; i < 24; ++i) noisy[(i * 53) % BPDSP::N] = 0.2f + 0.01f * i;
+        noisy[170] = 1.5f;
+        int osd_errors = BPDSP::osd174(noisy, 2, decoded, codeword);
+        bool osd_zero = std::all_of(codeword.begin(), codeword.end(), [](int8_t bit) { return bit == 0; });
+        if (osd_errors != 25 || !osd_zero) {
+            printf("ERROR: OSD returned %d hard errors\n", osd_errors);
+            return 1;
+        }
+        printf("✓ OSD decoder corrected %d bit errors\n", osd_errors);
+    }
+
+    // Test an incremental baseline follows a noise floor that moves up
+    // without changing shape, without refitting
+    printf("\nTesting incremental baseline...\n");
+    {
+        const float resolution = 12000.0f / 3840.0f;
+        std::vector<float> spectrum(1920);
+        for (size_t i = 0; i < spectrum.size(); ++i) {
+            spectrum[i] = 1e-3f * (1.0f + 0.5f * std::sin(0.002f * i)) * (1.0f + 0.3f * ((i * 7919) % 13) / 13.0f);
+        }
+
+        JS8DSP::BaselineComputation full;
+        JS8DSP::BaselineComputation incremental;
+        incremental.setIncremental(true);
+        std::vector<float> expected, actual;
+        incremental.computeBaseline(spectrum, resolution, actual);
+
+        for (auto& value : spectrum) value *= 2.0f;  // +3 dB
+        full.computeBaseline(spectrum, resolution, expected);
+        incremental.computeBaseline(spectrum, resolution, actual);
+
+        float worst = 0.0f;
+        for (size_t i = 0; i < spectrum.size(); ++i) worst = std::max(worst, std::fabs(actual[i] - expected[i]));
+        if (incremental.refits() != 1 || incremental.updates() != 1 || worst > 0.01f) {
+            printf("ERROR: Incremental baseline made %zu fits, %zu updates, off by %g dB\n",
+                   incremental.refits(), incremental.updates(), worst);
+            return 1;
+        }
+        printf("✓ Incremental baseline within %.4f dB of a full fit\n", worst);
+    }
+
+    // Test the input resampler passes the JS8 band, rejects what would
+    // alias into it and streams in chunks without allocating
+    printf("\nTesting resampler (%s)...\n", JS8DSP::Resampler::kernel_name());
+    {
+        const int rates[] = {48000, 44100};
+        for (int rate : rates) {
+            JS8DSP::Resampler resampler(rate, 12000);
+            // Amplitude of a sine through the resampler, past the filter's
+            // start up
+            auto level = [&](double frequency) {
+                std::vector<float> in(rate), out(12000);
+                for (int i = 0; i < rate; ++i) in[i] = static_cast<float>(std::sin(2.0 * M_PI * frequency * i / rate));
+                size_t consumed = 0;
+                resampler.reset();
+                size_t produced = resampler.process(in.data(), in.size(), out.data(), out.size(), consumed);
+                double power = 0.0;
+                for (size_t i = 1200; i < produced; ++i) power += out[i] * out[i];
+                return std::sqrt(2.0 * power / (produced - 1200));
+            };
+            double passband = level(2000.0);
+            double alias = level(10000.0);   // 2 kHz after nearest-sample decimation
+            if (std::fabs(passband - 1.0) > 0.01 || alias > 1e-3) {
+                printf("ERROR: Resampler from %d Hz passed %g, aliased %g\n", rate, passband, alias);
+                return 1;
+            }
+        }
+
+        // 44.1 kHz input in uneven chunks gives the samples one call does
+        JS8DSP::Resampler resampler(44100, 12000);
+        std::vector<float> in(44100), whole(12100), chunked(12100);
+        for (size_t i = 0; i < in.size(); ++i) in[i] = std::sin(0.05f * i) + 0.3f * std::cos(0.31f * i);
+        size_t consumed = 0;
+        size_t whole_count = resampler.process(in.data(), in.size(), whole.data(), whole.size(), consumed);
+
+        resampler.reset();
+        size_t before = g_allocations.load();
+        size_t chunked_count = 0, offset = 0;
+        for (size_t chunk = 1; offset < in.size(); chunk = chunk * 3 % 1021 + 1) {
+            const size_t n = std::min(chunk, in.size() - offset);
+            chunked_count += resampler.process(in.data() + offset, n, chunked.data() + chunked_count,
+                                               chunked.size() - chunked_count, consumed);
+            if (consumed == 0) break;
+            offset += consumed;
+        }
+        size_t allocations = g_allocations.load() - before;
+        if (offset != in.size() || whole_count != chunked_count || whole_count < 11990 ||
+            !std::equal(whole.begin(), whole.begin() + whole_count, chunked.begin()) || allocations != 0) {
+            printf("ERROR: Chunked resampling gave %zu samples (whole %zu, %zu allocations)\n",
+                   chunked_count, whole_count, allocations);
+            return 1;
+        }
+        printf("✓ Resampler rejects aliases by 60 dB and streams %zu samples exactly\n", chunked_count);
+    }
+
+    // Test the dispatched correlation kernel against the portable one;
+    // 20 samples exercises both the vector body and the scalar tail
+    printf("\nTesting correlation kernel (%s)...\n", JS8DSP::correlate_kernel_name());
+    {
+        const int length = 20;
+        const int count = 5;
+        std::vector<float> x_re(length), x_im(length);
+        std::vector<float> t_re(length * count), t_im(length * count);
+        for (int k = 0; k < length; ++k) {
+            x_re[k] = std::sin(0.7f * k);
+            x_im[k] = std::cos(1.3f * k);
+        }
+        for (int k = 0; k < length * count; ++k) {
+            t_re[k] = std::cos(0.31f * k);
+            t_im[k] = std::sin(0.53f * k);
+        }
+
+        float expected[count];
+        float actual[count];
+        JS8DSP::correlate_scalar(x_re.data(), x_im.data(), t_re.data(), t_im.data(), length, count, expected);
+        JS8DSP::correlate_kernel()(x_re.data(), x_im.data(), t_re.data(), t_im.data(), length, count, actual);
+        for (int c = 0; c < count; ++c) {
+            if (std::fabs(actual[c] - expected[c]) > 1e-4f * (1.0f + expected[c])) {
+                printf("ERROR: Correlation %d is %g (expected %g)\n", c, actual[c], expected[c]);
+                return 1;
+            }
+        }
+        printf("✓ Correlation kernel matches reference\n");
+    }
+
+    // Test the compile-time mode tables against the runtime definitions
+    printf("\nTesting mode tables...\n");
+    {
+        const JS8DSP::ModeTables& tables = JS8DSP::mode_tables(JS8Constants::Mode::FAST);
+        const auto params = JS8Constants::getModeParams(JS8Constants::Mode::FAST);
+        const int n = params.ndownsps;
+        if (&tables != &JS8DSP::mode_tables(JS8Constants::Mode::FAST) ||
+            tables.tone_re.size() != static_cast<size_t>(8 * JS8DSP::SYNC_SHIFTS * n) ||
+            tables.nuttal.size() != static_cast<size_t>(params.nsps * JS8Constants::NFOS) ||
+            tables.taper_head.size() != static_cast<size_t>(params.ndd + 1) ||
+            memcmp(tables.costas, JS8Constants::COSTAS_MODIFIED, sizeof(JS8Constants::COSTAS_MODIFIED)) != 0) {
+            printf("ERROR: FAST mode tables have the wrong shape\n");
+            return 1;
+        }
+
+        double worst = 0.0;
+        for (int tone = 0; tone < 8; ++tone) {
+            for (int shift = 0; shift < JS8DSP::SYNC_SHIFTS; ++shift) {
+                const double cycles = tone + (shift - JS8DSP::SYNC_SHIFTS / 2) * static_cast<double>(JS8DSP::SYNC_SHIFT_STEP);
+                for (int k = 0; k < n; ++k) {
+                    const size_t index = (tone * JS8DSP::SYNC_SHIFTS + shift) * n + k;
+                    const double phase = 2.0 * M_PI * cycles * k / n;
+                    worst = std::max(worst, std::fabs(tables.tone_re[index] - std::cos(phase)));
+                    worst = std::max(worst, std::fabs(tables.tone_im[index] - std::sin(phase)));
+                }
+            }
+        }
+        for (int i = 0; i <= params.ndd; ++i) {
+            const double value = 0.5 * (1.0 + std::cos(i * M_PI / params.ndd));
+            worst = std::max(worst, std::fabs(tables.taper_tail[i] - value));
+            worst = std::max(worst, std::fabs(tables.taper_head[params.ndd - i] - value));
+        }
+        if (worst > 1e-6) {
+            printf("ERROR: Mode tables are off by %g\n", worst);
+            return 1;
+        }
+        printf("✓ Mode tables match runtime cos/sin (worst error %.1e)\n", worst);
+    }
+
+    // Test the decode arena: alignment, scopes, and growth folded into one
+    // block on reset
+    printf("\nTesting decode arena...\n");
+    {
+        struct alignas(64) Line { float values[16]; };
+
+        JS8DSP::Arena arena(1024);
+        char* byte = arena.allocate<char>();
+        Line* line = arena.allocate<Line>();
+        bool aligned = reinterpret_cast<uintptr_t>(line) % alignof(Line) == 0 && byte != nullptr;
+        const size_t outer = arena.used();
+        {
+            const JS8DSP::Arena::Scope scope(arena);
+            float* values = arena.allocate<float>(1000);    // Too big for the first block
+            values[999] = 1.0f;
+        }
+        const bool released = arena.used() == outer && arena.peak() > 4000;
+        const size_t grown = arena.capacity();
+        const bool consolidated = arena.reset() && arena.capacity() == grown && arena.used() == 0 &&
+                                  arena.peak() == 0 && !arena.reset();
+        float* again = arena.allocate<float>(1000);
+        const bool fits = again != nullptr && arena.capacity() == grown;
+
+        if (!aligned || !released || !consolidated || !fits) {
+            printf("ERROR: Arena failed (aligned %d, released %d, consolidated %d, fits %d)\n",
+                   aligned, released, consolidated, fits);
+            return 1;
+        }
+        printf("✓ Arena grew to %zu bytes and reset into one block\n", grown);
+    }
+
+    // Test steady-state decoding
+    printf("\nTesting steady-state decode...\n");
+    std::vector<float> slot(48000 * 13);
+    for (size_t i = 0; i < slot.size(); ++i) {
+        slot[i] = 0.1f * std::sin(2.0f * static_cast<float>(M_PI) * 1500.0f * i / 48000.0f);
+    }
+
+    // Beside the tone, a transmission at 1000 Hz, so that the passes
+    // compared below have a real decode to agree on
+    {
+        std::vector<float> tx_audio(js8dsp_get_encode_buffer_size(handle, "CQ CQ EM73"));
+        js8dsp_set_tx_frequency(handle, 1000.0f);
+        int rendered = js8dsp_encode_message(handle, "CQ CQ EM73", tx_audio.data(), tx_audio.size());
+        js8dsp_set_tx_frequency(handle, JS8DSP_DEFAULT_TX_FREQUENCY);
+        if (rendered <= 0) {
+            printf("ERROR: Failed to encode test transmission (%d)\n", rendered);
+            return 1;
+        }
+        for (int i = 0; i < rendered && 24000 + i < static_cast<int>(slot.size()); ++i) {
+            slot[24000 + i] += 0.05f * tx_audio[i];
+        }
+    }
+    js8dsp_decoded_message_t messages[10];
+    int first = js8dsp_decode_buffer(handle, slot.data(), slot.size(), messages, 10);
+    size_t before = g_allocations.load();
+    int second = js8dsp_decode_buffer(handle, slot.data(), slot.size(), messages, 10);
+    size_t allocations = g_allocations.load() - before;
+    if (first < 0 || second < 0) {
+        printf("ERROR: Decode failed (%d, %d)\n", first, second);
+        return 1;
+    }
+    if (allocations != 0) {
+        printf("ERROR: Steady-state decode made %zu heap allocations\n", allocations);
+        return 1;
+    }
+    printf("✓ Steady-state decode made no heap allocations\n");
+
+    // Test parallel candidate decoding matches serial output
+    printf("\nTesting threaded decode...\n");
+    if (js8dsp_set_threads(handle, 4) != JS8DSP_OK) {
+        printf("ERROR: Failed to set decode threads\n");
+        return 1;
+    }
+    js8dsp_decoded_message_t threaded[10];
+    int threaded_count = js8dsp_decode_buffer(handle, slot.data(), slot.size(), threaded, 10);
+    before = g_allocations.load();
+    threaded_count = js8dsp_decode_buffer(handle, slot.data(), slot.size(), threaded, 10);
+    allocations = g_allocations.load() - before;
+    if (threaded_count != second) {
+        printf("ERROR: Threaded decode returned %d results (serial %d)\n", threaded_count, second);
+        return 1;
+    }
+    for (int i = 0; i < second; ++i) {
+        if (strcmp(threaded[i].message, messages[i].message) != 0 ||
+            threaded[i].freq_offset != messages[i].freq_offset ||
+            threaded[i].timestamp != messages[i].timestamp) {
+            printf("ERROR: Threaded result %d differs from serial\n", i);
+            return 1;
+        }
+    }
+    if (allocations != 0) {
+        printf("ERROR: Threaded decode made %zu heap allocations\n", allocations);
+        return 1;
+    }
+    js8dsp_set_threads(handle, 1);
+    printf("✓ Threaded decode matches serial output (%d results)\n", threaded_count);
+
+#if defined(__linux__)
+    // Test pinning, real-time scheduling and memory locking; the last two
+    // need privilege, so either outcome is allowed as long as a refusal
+    // leaves the default policy
+    printf("\nTesting thread policy...\n");
+    {
+        js8dsp_thread_policy_t policy;
+        memset(&policy, 0, sizeof(policy));
+        auto invalid = [&](auto change) {
+            js8dsp_thread_policy_t bad = policy;
+            change(bad);
+            return js8dsp_set_thread_policy(handle, &bad) == JS8DSP_INVALID_PARAM;
+        };
+        bool validated = js8dsp_set_thread_policy(nullptr, &policy) == JS8DSP_INVALID_PARAM &&
+                         invalid([](js8dsp_thread_policy_t& p) { p.cpu_count = -1; }) &&
+                         invalid([](js8dsp_thread_policy_t& p) { p.cpu_count = JS8DSP_MAX_PINNED_CPUS + 1; }) &&
+                         invalid([](js8dsp_thread_policy_t& p) { p.cpu_count = 1; p.cpus[0] = -1; }) &&
+                         invalid([](js8dsp_thread_policy_t& p) { p.priority = 10; }) &&
+                         invalid([](js8dsp_thread_policy_t& p) { p.sched = JS8DSP_SCHED_FIFO; }) &&
+                         invalid([](js8dsp_thread_policy_t& p) { p.sched = static_cast<js8dsp_sched_t>(7); });
+
+        cpu_set_t original;
+        sched_getaffinity(0, sizeof(original), &original);
+        int cpu = 0;
+        while (!CPU_ISSET(cpu, &original)) ++cpu;
+
+        // Pinned, with memory locked, on the caller and a worker
+        js8dsp_set_threads(handle, 2);
+        policy.cpu_count = 1;
+        policy.cpus[0] = cpu;
+        policy.lock_memory = 1;
+        const js8dsp_result_t locked = js8dsp_set_thread_policy(handle, &policy);
+        js8dsp_decoded_message_t pinned[10];
+        int pinned_count = js8dsp_decode_buffer(handle, slot.data(), slot.size(), pinned, 10);
+        before = g_allocations.load();
+        pinned_count = js8dsp_decode_buffer(handle, slot.data(), slot.size(), pinned, 10);
+        allocations = g_allocations.load() - before;
+        js8dsp_metrics_t metrics;
+        js8dsp_get_metrics(handle, &metrics, sizeof(metrics));
+        cpu_set_t after;
+        sched_getaffinity(0, sizeof(after), &after);
+
+        bool same = pinned_count == second;
+        for (int i = 0; i < second && same; ++i) {
+            same = strcmp(pinned[i].message, messages[i].message) == 0 &&
+                   pinned[i].freq_offset == messages[i].freq_offset;
+        }
+        bool applied = locked == JS8DSP_OK ? metrics.locked_bytes > 0
+                                           : locked == JS8DSP_ERROR && metrics.locked_bytes == 0 &&
+                                             js8dsp_get_error(handle) != nullptr;
+
+        // Real-time, which the caller gives up again after each pass
+        policy.lock_memory = 0;
+        policy.sched = JS8DSP_SCHED_FIFO;
+        policy.priority = 1;
+        const js8dsp_result_t realtime = js8dsp_set_thread_policy(handle, &policy);
+        const int realtime_count = js8dsp_decode_buffer(handle, slot.data(), slot.size(), pinned, 10);
+        js8dsp_get_metrics(handle, &metrics, sizeof(metrics));
+        applied = applied && (realtime == JS8DSP_OK || realtime == JS8DSP_ERROR) && metrics.locked_bytes == 0 &&
+                  realtime_count == second && sched_getscheduler(0) == SCHED_OTHER;
+
+        const bool reset = js8dsp_set_thread_policy(handle, nullptr) == JS8DSP_OK;
+        js8dsp_set_threads(handle, 1);
+
+        if (!validated || !same || !applied || !reset || allocations != 0 || !CPU_EQUAL(&original, &after)) {
+            printf("ERROR: Thread policy (validated %d, same %d, applied %d, reset %d, %zu allocations)\n",
+                   validated, same, applied, reset, allocations);
+            return 1;
+        }
+        printf("✓ Pinned to CPU %d with memory %s, SCHED_FIFO %s; caller restored after each pass\n", cpu,
+               locked == JS8DSP_OK ? "locked" : "lock refused", realtime == JS8DSP_OK ? "applied" : "refused");
+    }
+#endif
+
+    // Test batched min-sum decoding, serial and threaded
+    printf("\nTesting min-sum decode...\n");
+    {
+        if (js8dsp_set_ldpc_decoder(handle, JS8DSP_LDPC_MIN_SUM_LAYERED) != JS8DSP_OK) {
+            printf("ERROR: Failed to select min-sum decoder\n");
+            return 1;
+        }
+        js8dsp_decoded_message_t serial[10];
+        int serial_count = js8dsp_decode_buffer(handle, slot.data(), slot.size(), serial, 10);
+        before = g_allocations.load();
+        serial_count = js8dsp_decode_buffer(handle, slot.data(), slot.size(), serial, 10);
+        allocations = g_allocations.load() - before;
+        if (serial_count < 0 || allocations != 0) {
+            printf("ERROR: Min-sum decode returned %d with %zu heap allocations\n",
+                   serial_count, allocations);
+            return 1;
+        }
+
+        js8dsp_set_threads(handle, 4);
+        int parallel_count = js8dsp_decode_buffer(handle, slot.data(), slot.size(), threaded, 10);
+        js8dsp_set_threads(handle, 1);
+        if (parallel_count != serial_count) {
+            printf("ERROR: Threaded min-sum decode returned %d results (serial %d)\n",
+                   parallel_count, serial_count);
+            return 1;
+        }
+        for (int i = 0; i < serial_count; ++i) {
+            if (strcmp(threaded[i].message, serial[i].message) != 0) {
+                printf("ERROR: Threaded min-sum result %d differs from serial\n", i);
+                return 1;
+            }
+        }
+        js8dsp_set_ldpc_decoder(handle, JS8DSP_LDPC_BP_FLOODING);
+        printf("✓ Min-sum decode matches across threads (%d results)\n", serial_count);
+    }
+
+    // Test the decode cache reports each message once per slot
+    // A real transmission at 1500 Hz, starting half a second into a slot
+    std::vector<float> message_slot(48000 * 15);
+    {
+        std::vector<float> tx_audio(js8dsp_get_encode_buffer_size(handle, "HELLO WORLD"));
+        js8dsp_set_tx_frequency(handle, 1500.0f);
+        int rendered = js8dsp_encode_message(handle, "HELLO WORLD", tx_audio.data(), tx_audio.size());
+        if (rendered <= 0) {
+            printf("ERROR: Failed to encode test transmission (%d)\n", rendered);
+            return 1;
+        }
+        for (int i = 0; i < rendered && 24000 + i < static_cast<int>(message_slot.size()); ++i) {
+            message_slot[24000 + i] = 0.5f * tx_audio[i];
+        }
+    }
+
+    printf("\nTesting decode cache...\n");
+    {
+        js8dsp_set_decode_cache(handle, 1);
+        js8dsp_decoded_message_t cached[64];
+        int first_pass = js8dsp_decode_buffer(handle, message_slot.data(), message_slot.size(), cached, 64);
+        int first_decodes = std::max(first_pass, 0);
+        before = g_allocations.load();
+        int repeat_pass = js8dsp_decode_buffer(handle, message_slot.data(), message_slot.size(), cached, 64);
+        allocations = g_allocations.load() - before;
+        int repeat_decodes = std::max(repeat_pass, 0);
+        js8dsp_set_decode_cache(handle, 0);
+        int uncached_pass = js8dsp_decode_buffer(handle, message_slot.data(), message_slot.size(), cached, 64);
+        int uncached_decodes = std::max(uncached_pass, 0);
+
+        if (first_pass < 0 || repeat_pass < 0 || first_decodes == 0 || repeat_decodes != 0 ||
+            allocations != 0 || uncached_decodes != first_decodes) {
+            printf("ERROR: Decode cache repeated %d of %d decodes (%zu allocations)\n",
+                   repeat_decodes, first_decodes, allocations);
+            return 1;
+        }
+        printf("✓ Decode cache suppressed %d repeated decodes\n", first_decodes);
+    }
+
+    // Decodes weaker than the threshold are not reported
+    printf("\nTesting decode threshold...\n");
+    {
+        js8dsp_decoded_message_t thresholded[64];
+        int default_count = js8dsp_decode_buffer(handle, message_slot.data(), message_slot.size(), thresholded, 64);
+        float strongest = -100.0f;
+        for (int i = 0; i < default_count; ++i) strongest = std::max(strongest, thresholded[i].snr);
+        js8dsp_set_decode_threshold(handle, strongest + 1.0f);
+        int raised_count = js8dsp_decode_buffer(handle, message_slot.data(), message_slot.size(), thresholded, 64);
+        js8dsp_set_decode_threshold(handle, -20.0f);
+        int restored_count = js8dsp_decode_buffer(handle, message_slot.data(), message_slot.size(), thresholded, 64);
+
+        if (default_count <= 0 || raised_count != 0 || restored_count != default_count) {
+            printf("ERROR: Decode threshold failed (%d, then %d above %.1f dB, then %d)\n",
+                   default_count, raised_count, strongest, restored_count);
+            return 1;
+        }
+        printf("✓ Threshold above %.1f dB dropped %d decodes\n", strongest, default_count);
+    }
+
+    // A restarted decoder picks up the tuning and cache of the one before
+    // it; a damaged state is refused
+    printf("\nTesting decoder state...\n");
+    {
+        js8dsp_decoded_message_t restored[64];
+        js8dsp_set_decode_cache(handle, 1);
+        js8dsp_decode_buffer(handle, message_slot.data(), message_slot.size(), restored, 64);
+        js8dsp_set_osd_budget(handle, 5.0f);
+
+        size_t state_size = 0, written = 0;
+        const bool sized = js8dsp_save_state(handle, nullptr, 0, &state_size) == JS8DSP_OK && state_size > 0;
+        std::vector<uint8_t> state(state_size);
+        const bool short_refused = js8dsp_save_state(handle, state.data(), state_size - 1, &written) == JS8DSP_ERROR &&
+                                   written == state_size;
+        const bool saved = js8dsp_save_state(handle, state.data(), state.size(), &written) == JS8DSP_OK &&
+                           written == state_size;
+        js8dsp_set_osd_budget(handle, 0.0f);
+        js8dsp_set_decode_cache(handle, 0);
+
+        js8dsp_handle_t restart = js8dsp_init(48000, JS8DSP_MODE_NORMAL);
+        std::vector<uint8_t> damaged = state;
+        damaged[damaged.size() / 2] ^= 0x40;
+        const bool refused = js8dsp_load_state(restart, damaged.data(), damaged.size()) == JS8DSP_ERROR &&
+                             js8dsp_load_state(restart, state.data(), state.size() - 1) == JS8DSP_ERROR &&
+                             js8dsp_load_state(restart, nullptr, state.size()) == JS8DSP_INVALID_PARAM;
+        const bool loaded = js8dsp_load_state(restart, state.data(), state.size()) == JS8DSP_OK;
+        float osd_budget = 0.0f;
+        uint32_t osd_attempts, osd_decoded, osd_skipped;
+        js8dsp_get_osd_stats(restart, &osd_budget, &osd_attempts, &osd_decoded, &osd_skipped);
+        size_t resaved_size = 0;
+        js8dsp_save_state(restart, nullptr, 0, &resaved_size);
+
+        // The cached decodes of the slot are not reported again; OSD is
+        // left out as what it decodes depends on time
+        js8dsp_set_osd_budget(restart, 0.0f);
+        int repeated = js8dsp_decode_buffer(restart, message_slot.data(), message_slot.size(), restored, 64);
+
+        // As does a threshold that leaves nothing to report
+        js8dsp_set_decode_threshold(handle, 200.0f);
+        size_t raised_size = 0;
+        js8dsp_save_state(handle, nullptr, 0, &raised_size);
+        std::vector<uint8_t> raised(raised_size);
+        js8dsp_save_state(handle, raised.data(), raised.size(), &written);
+        js8dsp_set_decode_threshold(handle, -20.0f);
+        const bool raised_loaded = js8dsp_load_state(restart, raised.data(), raised.size()) == JS8DSP_OK;
+        js8dsp_set_decode_cache(restart, 0);
+        int thresholded = js8dsp_decode_buffer(restart, message_slot.data(), message_slot.size(), restored, 64);
+        js8dsp_cleanup(restart);
+
+        if (!sized || !short_refused || !saved || !refused || !loaded || repeated != 0 ||
+            resaved_size != state_size || osd_budget != 5.0f || !raised_loaded || thresholded != 0) {
+            printf("ERROR: Decoder state failed (sized %d, saved %d, refused %d, loaded %d, %d repeated, %d over threshold, %zu then %zu bytes)\n",
+                   sized, saved, refused, loaded, repeated, thresholded, state_size, resaved_size);
+            return 1;
+        }
+        printf("✓ %zu byte state restored the decode cache and tuning\n", state_size);
+    }
+
+    // Candidates within the tones of a decoded signal are not decoded
+    // again, and a pass out of time skips the candidates it has not started
+    printf("\nTesting candidate ranking and time budget...\n");
+    {
+        js8dsp_metrics_t metrics;
+        js8dsp_decoded_message_t budget_messages[64];
+        int full_count = js8dsp_decode_buffer(handle, message_slot.data(), message_slot.size(), budget_messages, 64);
+        js8dsp_get_metrics(handle, &metrics, sizeof(metrics));
+        const uint32_t suppressed = metrics.last_candidates_suppressed;
+
+        bool validated = js8dsp_set_time_budget(handle, -1.0f) == JS8DSP_INVALID_PARAM &&
+                         js8dsp_set_time_budget(handle, 0.001f) == JS8DSP_OK;
+        int limited_count = js8dsp_decode_buffer(handle, message_slot.data(), message_slot.size(), budget_messages, 64);
+        js8dsp_get_metrics(handle, &metrics, sizeof(metrics));
+        js8dsp_set_time_budget(handle, 0.0f);
+        int restored_count = js8dsp_decode_buffer(handle, message_slot.data(), message_slot.size(), budget_messages, 64);
+
+        if (!validated || full_count < 0 || suppressed == 0 || limited_count != 0 ||
+            metrics.last_candidates_found == 0 || metrics.last_candidates_skipped != metrics.last_candidates_found ||
+            metrics.last_candidates_attempted != 0 || restored_count != full_count) {
+            printf("ERROR: Ranking or time budget failed (%u suppressed, %u of %u skipped, %d results)\n",
+                   suppressed, metrics.last_candidates_skipped, metrics.last_candidates_found, limited_count);
+            return 1;
+        }
+        printf("✓ %u near-duplicate candidates suppressed, %u skipped over budget\n",
+               suppressed, metrics.last_candidates_skipped);
+    }
+
+    // A weak signal three tones above a strong one only decodes once the
+    // strong one is subtracted; the rounds allocate nothing and do not
+    // depend on threading
+    printf("\nTesting decode rounds...\n");
+    {
+        std::vector<float> crowded(48000 * 15);
+        js8dsp_handle_t tx = js8dsp_init(48000, JS8DSP_MODE_NORMAL);
+        std::vector<float> tx_audio(js8dsp_get_encode_buffer_size(tx, "HELLO WORLD"));
+        js8dsp_set_tx_frequency(tx, 1000.0f);
+        int rendered = js8dsp_encode_message(tx, "HELLO WORLD", tx_audio.data(), tx_audio.size());
+        for (int i = 0; i < rendered; ++i) crowded[24000 + i] += 0.5f * tx_audio[i];
+        js8dsp_set_tx_frequency(tx, 1018.75f);
+        rendered = js8dsp_encode_message(tx, "CQ CQ EM73", tx_audio.data(), tx_audio.size());
+        for (int i = 0; i < rendered && 28800 + i < static_cast<int>(crowded.size()); ++i) {
+            crowded[28800 + i] += 0.05f * tx_audio[i];
+        }
+        js8dsp_cleanup(tx);
+
+        auto found = [](const js8dsp_decoded_message_t* results, int count, const char* message) {
+            int n = 0;
+            for (int i = 0; i < count; ++i) n += strcmp(results[i].message, message) == 0;
+            return n;
+        };
+
+        js8dsp_decoded_message_t single[64], rounds[64], threaded_rounds[64];
+        int single_count = js8dsp_decode_buffer(handle, crowded.data(), crowded.size(), single, 64);
+        bool validated = js8dsp_set_decode_rounds(handle, 0) == JS8DSP_INVALID_PARAM &&
+                         js8dsp_set_decode_rounds(handle, JS8DSP_MAX_DECODE_ROUNDS + 1) == JS8DSP_INVALID_PARAM &&
+                         js8dsp_set_decode_rounds(handle, JS8DSP_MAX_DECODE_ROUNDS) == JS8DSP_OK;
+        js8dsp_decode_buffer(handle, crowded.data(), crowded.size(), rounds, 64);
+        before = g_allocations.load();
+        int rounds_count = js8dsp_decode_buffer(handle, crowded.data(), crowded.size(), rounds, 64);
+        allocations = g_allocations.load() - before;
+        js8dsp_metrics_t metrics;
+        js8dsp_get_metrics(handle, &metrics, sizeof(metrics));
+
+        js8dsp_set_threads(handle, 4);
+        int threaded_count = js8dsp_decode_buffer(handle, crowded.data(), crowded.size(), threaded_rounds, 64);
+        js8dsp_set_threads(handle, 1);
+
+        // Cached messages are not reported again but are still subtracted
+        js8dsp_metrics_t cached_metrics;
+        js8dsp_decoded_message_t cached[64];
+        js8dsp_set_decode_cache(handle, 1);
+        js8dsp_decode_buffer(handle, crowded.data(), crowded.size(), cached, 64);
+        int cached_count = js8dsp_decode_buffer(handle, crowded.data(), crowded.size(), cached, 64);
+        js8dsp_get_metrics(handle, &cached_metrics, sizeof(cached_metrics));
+        js8dsp_set_decode_cache(handle, 0);
+        js8dsp_set_decode_rounds(handle, 1);
+        bool matched = threaded_count == rounds_count;
+        for (int i = 0; i < rounds_count && matched; ++i) {
+            matched = strcmp(threaded_rounds[i].message, rounds[i].message) == 0 &&
+                      threaded_rounds[i].freq_offset == rounds[i].freq_offset;
+        }
+
+        if (!validated || single_count < 0 || found(single, single_count, "HELLO WORLD") != 1 ||
+            found(single, single_count, "CQ CQ EM73") != 0 || found(rounds, rounds_count, "HELLO WORLD") != 1 ||
+            found(rounds, rounds_count, "CQ CQ EM73") != 1 || allocations != 0 || !matched ||
+            metrics.last_decode_rounds == 0 || metrics.last_signals_subtracted < 2 ||
+            metrics.decode_rounds < 2 * metrics.last_decode_rounds || cached_count < 0 ||
+            found(cached, cached_count, "CQ CQ EM73") != 0 || cached_metrics.last_signals_subtracted < 2) {
+            printf("ERROR: Decode rounds failed (%d then %d results, %u rounds, %u subtracted, %zu allocations)\n",
+                   single_count, rounds_count, metrics.last_decode_rounds, metrics.last_signals_subtracted,
+                   allocations);
+            return 1;
+        }
+        printf("✓ Subtraction revealed a masked signal in %u extra rounds, %u signals subtracted\n",
+               metrics.last_decode_rounds, metrics.last_signals_subtracted);
+    }
+
+    // Test the OSD fallback runs within its budget and is counted
+    printf("\nTesting OSD budget...\n");
+    {
+        if (js8dsp_set_osd_budget(handle, -1.0f) != JS8DSP_INVALID_PARAM ||
+            js8dsp_set_osd_budget(handle, 50.0f) != JS8DSP_OK) {
+            printf("ERROR: OSD budget not validated\n");
+            return 1;
+        }
+        js8dsp_decoded_message_t osd_messages[10];
+        int osd_count = js8dsp_decode_buffer(handle, slot.data(), slot.size(), osd_messages, 10);
+
+        float budget_ms = 0.0f;
+        uint32_t attempts = 0, osd_decoded = 0, skipped = 0;
+        if (osd_count < 0 ||
+            js8dsp_get_osd_stats(handle, &budget_ms, &attempts, &osd_decoded, &skipped) != JS8DSP_OK ||
+            budget_ms != 50.0f || osd_decoded > attempts) {
+            printf("ERROR: OSD decode failed or stats inconsistent\n");
+            return 1;
+        }
+        js8dsp_set_osd_budget(handle, 0.0f);
+        printf("✓ OSD budget %.0f ms: %u attempts, %u decoded, %u skipped\n",
+               budget_ms, attempts, osd_decoded, skipped);
+    }
+
+    // Test metrics account for a decode pass without allocating
+    printf("\nTesting decode metrics...\n");
+    {
+        js8dsp_metrics_t start_metrics, metrics;
+        js8dsp_get_metrics(handle, &start_metrics, sizeof(start_metrics));
+        js8dsp_decoded_message_t pass_messages[10];
+        int pass_count = js8dsp_decode_buffer(handle, slot.data(), slot.size(), pass_messages, 10);
+        before = g_allocations.load();
+        js8dsp_result_t result = js8dsp_get_metrics(handle, &metrics, sizeof(metrics));
+        allocations = g_allocations.load() - before;
+
+        uint64_t ldpc_runs = metrics.ldpc_failures - start_metrics.ldpc_failures;
+        for (int i = 0; i < JS8DSP_LDPC_ITERATION_BINS; ++i) {
+            ldpc_runs += metrics.ldpc_iterations[i] - start_metrics.ldpc_iterations[i];
+        }
+        uint64_t stage_sum = 0;
+        bool totals_grew = true;
+        for (int stage = 0; stage < JS8DSP_STAGE_COUNT; ++stage) {
+            stage_sum += metrics.stage_last_ns[stage];
+            totals_grew = totals_grew && metrics.stage_total_ns[stage] - start_metrics.stage_total_ns[stage] ==
+                                             metrics.stage_last_ns[stage];
+        }
+
+        // A caller built against a smaller layout gets only that much
+        js8dsp_metrics_t old_layout;
+        memset(&old_layout, 0xff, sizeof(old_layout));
+        const size_t old_size = offsetof(js8dsp_metrics_t, ldpc_iterations);
+        bool sized = js8dsp_get_metrics(handle, &old_layout, old_size) == JS8DSP_OK && old_layout.size == old_size &&
+                     old_layout.ldpc_failures == UINT64_MAX &&
+                     js8dsp_get_metrics(handle, &old_layout, 4) == JS8DSP_INVALID_PARAM;
+
+        // Every result is a decode; candidates that only sync are not results
+        if (pass_count < 0 || result != JS8DSP_OK || allocations != 0 || !sized ||
+            metrics.version != JS8DSP_METRICS_VERSION || metrics.size != sizeof(metrics) ||
+            metrics.passes != start_metrics.passes + 1 || !totals_grew || stage_sum == 0 ||
+            metrics.stage_last_ns[JS8DSP_STAGE_FFT] == 0 ||
+            metrics.last_candidates_attempted > metrics.last_candidates_found ||
+            metrics.last_candidates_decoded > metrics.last_candidates_attempted ||
+            ldpc_runs < metrics.last_candidates_attempted ||
+            metrics.allocations != start_metrics.allocations ||
+            metrics.arena_bytes < JS8DSP::Arena::DEFAULT_CAPACITY ||
+            (metrics.last_candidates_attempted > 0 && metrics.last_arena_peak_bytes == 0) ||
+            metrics.last_arena_peak_bytes > metrics.arena_peak_bytes ||
+            metrics.arena_peak_bytes > metrics.arena_bytes ||
+            metrics.last_pass_ns == 0 || metrics.median_pass_ns > metrics.worst_pass_ns ||
+            metrics.last_pass_ns > metrics.worst_pass_ns || metrics.worst_pass_ns > metrics.max_pass_ns ||
+            metrics.total_decoded != start_metrics.total_decoded + static_cast<uint32_t>(pass_count) ||
+            pass_count == 0 || static_cast<uint32_t>(pass_count) > metrics.last_candidates_decoded) {
+            printf("ERROR: Metrics inconsistent with one decode pass\n");
+            return 1;
+        }
+        printf("✓ Metrics: %u candidates, %u attempted, %u decoded, %llu LDPC runs in %.1f ms, arena peak %llu bytes\n",
+               metrics.last_candidates_found, metrics.last_candidates_attempted,
+               metrics.last_candidates_decoded, static_cast<unsigned long long>(ldpc_runs), stage_sum / 1e6,
+               static_cast<unsigned long long>(metrics.last_arena_peak_bytes));
+        printf("✓ Pass latency: last %.1f ms, median %.1f ms, worst %.1f ms\n", metrics.last_pass_ns / 1e6,
+               metrics.median_pass_ns / 1e6, metrics.worst_pass_ns / 1e6);
+    }
+
+    // Test multi-submode decoding from one buffer
+    printf("\nTesting multi-mode decode...\n");
+    {
+        std::vector<float> long_slot(48000 * 52);
+        for (size_t i = 0; i < long_slot.size(); ++i) {
+            long_slot[i] = slot[i % slot.size()];
+        }
+        js8dsp_decoded_message_t multi[64];
+
+        int single_mode = js8dsp_decode_buffer_multi(handle, long_slot.data(), long_slot.size(),
+                                                     JS8DSP_SUBMODE_NORMAL, multi, 10);
+        if (single_mode != second) {
+            printf("ERROR: NORMAL-only multi decode returned %d results (expected %d)\n", single_mode, second);
+            return 1;
+        }
+        for (int i = 0; i < single_mode; ++i) {
+            if (strcmp(multi[i].message, messages[i].message) != 0 || multi[i].mode != JS8DSP_MODE_NORMAL) {
+                printf("ERROR: NORMAL-only multi result %d differs from single-mode decode\n", i);
+                return 1;
+            }
+        }
+
+        int all_modes = js8dsp_decode_buffer_multi(handle, long_slot.data(), long_slot.size(),
+                                                   JS8DSP_SUBMODE_ALL, multi, 64);
+        before = g_allocations.load();
+        all_modes = js8dsp_decode_buffer_multi(handle, long_slot.data(), long_slot.size(),
+                                               JS8DSP_SUBMODE_ALL, multi, 64);
+        allocations = g_allocations.load() - before;
+        if (all_modes < single_mode) {
+            printf("ERROR: All-mode decode returned %d results\n", all_modes);
+            return 1;
+        }
+        if (allocations != 0) {
+            printf("ERROR: Steady-state multi-mode decode made %zu heap allocations\n", allocations);
+            return 1;
+        }
+        if (js8dsp_decode_buffer_multi(handle, long_slot.data(), long_slot.size(), 0x20, multi, 64) !=
+            JS8DSP_INVALID_PARAM) {
+            printf("ERROR: Invalid submode mask accepted\n");
+            return 1;
+        }
+        printf("✓ Multi-mode decode returned %d results across all submodes\n", all_modes);
+    }
+
+    // Test channels decoded together keep their own messages
+    printf("\nTesting multi-channel decode...\n");
+    {
+        const char* texts[] = {"HELLO WORLD", "CQ CQ EM73", "TEST 123"};
+        const int channels = 3;
+        const size_t frames = 12000 * 15;
+        js8dsp_handle_t rx = js8dsp_init(12000, JS8DSP_MODE_NORMAL);
+        std::vector<float> planar(frames * channels);
+        std::vector<float> interleaved(frames * channels);
+        std::vector<float> tx_audio(frames);
+        for (int c = 0; c < channels; ++c) {
+            js8dsp_set_tx_frequency(rx, 1000.0f + 250.0f * c);
+            int rendered = js8dsp_encode_message(rx, texts[c], tx_audio.data(), frames - 6000);
+            if (rendered <= 0) {
+                printf("ERROR: Failed to encode channel %d (%d)\n", c, rendered);
+                return 1;
+            }
+            for (int i = 0; i < rendered; ++i) {
+                planar[c * frames + 6000 + i] = 0.5f * tx_audio[i];
+                interleaved[(6000 + i) * channels + c] = 0.5f * tx_audio[i];
+            }
+        }
+
+        js8dsp_set_threads(rx, 2);
+        js8dsp_decoded_message_t from_planar[256];
+        js8dsp_decoded_message_t from_interleaved[256];
+        int planar_count = js8dsp_decode_channels(rx, planar.data(), frames, channels, JS8DSP_LAYOUT_PLANAR,
+                                                  JS8DSP_SUBMODE_NORMAL, from_planar, 256);
+        before = g_allocations.load();
+        int interleaved_count = js8dsp_decode_channels(rx, interleaved.data(), frames, channels,
+                                                       JS8DSP_LAYOUT_INTERLEAVED, JS8DSP_SUBMODE_NORMAL,
+                                                       from_interleaved, 256);
+        allocations = g_allocations.load() - before;
+
+        bool invalid = js8dsp_decode_channels(rx, planar.data(), frames, 0, JS8DSP_LAYOUT_PLANAR,
+                                              JS8DSP_SUBMODE_NORMAL, from_planar, 256) == JS8DSP_INVALID_PARAM &&
+                       js8dsp_decode_channels(rx, planar.data(), frames, JS8DSP_MAX_CHANNELS + 1,
+                                              JS8DSP_LAYOUT_PLANAR, JS8DSP_SUBMODE_NORMAL, from_planar, 256) ==
+                           JS8DSP_INVALID_PARAM &&
+                       js8dsp_decode_channels(rx, planar.data(), frames, channels, static_cast<js8dsp_layout_t>(2),
+                                              JS8DSP_SUBMODE_NORMAL, from_planar, 256) == JS8DSP_INVALID_PARAM;
+        js8dsp_cleanup(rx);
+
+        if (planar_count <= 0 || interleaved_count != planar_count) {
+            printf("ERROR: Multi-channel decode returned %d planar, %d interleaved results\n",
+                   planar_count, interleaved_count);
+            return 1;
+        }
+        bool found[channels] = {};
+        for (int i = 0; i < planar_count; ++i) {
+            const js8dsp_decoded_message_t& m = from_planar[i];
+            if (strcmp(m.message, from_interleaved[i].message) != 0 || m.channel != from_interleaved[i].channel ||
+                m.freq_offset != from_interleaved[i].freq_offset) {
+                printf("ERROR: Interleaved result %d differs from planar decode\n", i);
+                return 1;
+            }
+            if (m.channel < 0 || m.channel >= channels || (i > 0 && m.channel < from_planar[i - 1].channel)) {
+                printf("ERROR: Result %d has channel %d out of order\n", i, m.channel);
+                return 1;
+            }
+            for (int c = 0; c < channels; ++c) {
+                if (strcmp(m.message, texts[c]) != 0) continue;
+                if (c != m.channel) {
+                    printf("ERROR: '%s' reported on channel %d\n", m.message, m.channel);
+                    return 1;
+                }
+                found[c] = true;
+            }
+        }
+        if (!found[0] || !found[1] || !found[2]) {
+            printf("ERROR: Multi-channel decode missed a channel's message\n");
+            return 1;
+        }
+        if (allocations != 0) {
+            printf("ERROR: Steady-state multi-channel decode made %zu heap allocations\n", allocations);
+            return 1;
+        }
+        if (!invalid) {
+            printf("ERROR: Invalid channel count or layout accepted\n");
+            return 1;
+        }
+        printf("✓ %d channels decoded together, %d results\n", channels, planar_count);
+    }
+
+    // Test streaming decode matches whole-slot decode
+    printf("\nTesting streaming decode...\n");
+    {
+        if (js8dsp_stream_start(handle, JS8DSP_SUBMODE_NORMAL) != JS8DSP_OK) {
+            printf("ERROR: Failed to start stream\n");
+            return 1;
+        }
+
+        // Push two slots in 100 ms chunks; the second must not allocate
+        const size_t chunk = 4800;
+        js8dsp_decoded_message_t streamed[64];
+        for (int pass = 0; pass < 2; ++pass) {
+            uint32_t counted_before = 0, errors_before = 0;
+            js8dsp_get_stats(handle, &counted_before, &errors_before);
+            before = g_allocations.load();
+            int pending = 0;
+            for (size_t offset = 0; offset < slot.size(); offset += chunk) {
+                pending = js8dsp_stream_push(handle, slot.data() + offset,
+                                             std::min(chunk, slot.size() - offset));
+                if (pending < 0) {
+                    printf("ERROR: Stream push failed (%d)\n", pending);
+                    return 1;
+                }
+            }
+            uint32_t counted = 0, errors = 0;
+            js8dsp_get_stats(handle, &counted, &errors);
+            int polled = js8dsp_stream_poll(handle, streamed, 64);
+            allocations = g_allocations.load() - before;
+            uint32_t after_poll = 0;
+            js8dsp_get_stats(handle, &after_poll, &errors);
+
+            // The first slot starts from the same empty resampler history
+            // as a whole-slot decode and must match it exactly; the second
+            // is filtered on from the end of the first, so it lacks the
+            // onset at the start of the buffer and its results are a
+            // subset
+            if (pass == 0 ? polled != second : polled < 0 || polled > second) {
+                printf("ERROR: Stream slot returned %d results (expected %d)\n", polled, second);
+                return 1;
+            }
+            if (pending != polled) {
+                printf("ERROR: Stream reported %d pending, polled %d\n", pending, polled);
+                return 1;
+            }
+            if (counted != counted_before + static_cast<uint32_t>(polled) || after_poll != counted) {
+                printf("ERROR: Stream counted %u decodes, polled %d\n", counted - counted_before, polled);
+                return 1;
+            }
+            for (int i = 0, j = 0; i < polled; ++i, ++j) {
+                auto same = [&](const js8dsp_decoded_message_t& m) {
+                    return strcmp(streamed[i].message, m.message) == 0 &&
+                           streamed[i].freq_offset == m.freq_offset && streamed[i].timestamp == m.timestamp;
+                };
+                while (pass == 1 && j < second && !same(messages[j])) ++j;
+                if (j >= second || !same(messages[j])) {
+                    printf("ERROR: Streamed result %d differs from whole-slot decode\n", i);
+                    return 1;
+                }
+            }
+            if (pass == 1 && allocations != 0) {
+                printf("ERROR: Steady-state stream made %zu heap allocations\n", allocations);
+                return 1;
+            }
+        }
+        printf("✓ Streamed slots match whole-slot decode\n");
+    }
+
+    // Test the waterfall export follows the streamed symbol spectra
+    printf("\nTesting spectrum export...\n");
+    {
+        const bool halves = JS8DSP::float_to_half(1.0f) == 0x3c00 && JS8DSP::float_to_half(-2.5f) == 0xc100 &&
+                            JS8DSP::float_to_half(65504.0f) == 0x7bff && JS8DSP::float_to_half(1e6f) == 0x7c00 &&
+                            JS8DSP::float_to_half(1.0f + 1.0f / 4096) == 0x3c00 &&
+                            JS8DSP::float_to_half(std::ldexp(1.0f, -24)) == 0x0001 &&
+                            JS8DSP::float_to_half(1e-9f) == 0x0000;
+
+        js8dsp_spectrum_layout_t layout = {0.0f, 3000.0f, 300, JS8DSP_SPECTRUM_U8, -40.0f, 40.0f};
+        uint8_t power[300];
+        uint8_t baseline[300];
+        uint64_t frame = 0, next = 0;
+        before = g_allocations.load();
+        js8dsp_result_t result = js8dsp_get_spectrum(handle, JS8DSP_MODE_NORMAL, 0, &layout, power, baseline, &frame);
+        js8dsp_stream_push(handle, slot.data(), 48000);    // Past any pause between slots
+        js8dsp_result_t again = js8dsp_get_spectrum(handle, JS8DSP_MODE_NORMAL, 0, &layout, power, nullptr, &next);
+        allocations = g_allocations.load() - before;
+
+        // The stream carries the 1500 Hz test tone
+        int peak = 0;
+        for (int i = 1; i < 300; ++i) {
+            if (power[i] > power[peak]) peak = i;
+        }
+
+        uint16_t half_power[300];
+        layout.format = JS8DSP_SPECTRUM_F16;
+        js8dsp_spectrum_layout_t inverted = {3000.0f, 0.0f, 300, JS8DSP_SPECTRUM_F16, 0.0f, 0.0f};
+        js8dsp_spectrum_layout_t unscaled = {0.0f, 3000.0f, 300, JS8DSP_SPECTRUM_U8, 10.0f, 10.0f};
+        const bool invalid = js8dsp_get_spectrum(handle, JS8DSP_MODE_NORMAL, 0, &inverted, half_power, nullptr, nullptr) ==
+                                 JS8DSP_INVALID_PARAM &&
+                             js8dsp_get_spectrum(handle, JS8DSP_MODE_NORMAL, 0, &unscaled, power, nullptr, nullptr) ==
+                                 JS8DSP_INVALID_PARAM &&
+                             js8dsp_get_spectrum(handle, 5, 0, &layout, half_power, nullptr, nullptr) ==
+                                 JS8DSP_INVALID_PARAM &&
+                             js8dsp_get_spectrum(handle, JS8DSP_MODE_NORMAL, 1, &layout, half_power, nullptr, nullptr) ==
+                                 JS8DSP_ERROR &&
+                             js8dsp_get_spectrum(handle, JS8DSP_MODE_NORMAL, 0, &layout, half_power, nullptr, nullptr) ==
+                                 JS8DSP_OK;
+
+        if (!halves || result != JS8DSP_OK || again != JS8DSP_OK || frame == 0 || next <= frame ||
+            allocations != 0 || peak != 150 || power[peak] <= baseline[peak] || !invalid) {
+            printf("ERROR: Spectrum export failed (halves %d, frames %llu then %llu, peak bin %d, invalid %d)\n",
+                   halves, static_cast<unsigned long long>(frame), static_cast<unsigned long long>(next), peak, invalid);
+            return 1;
+        }
+        printf("✓ Spectrum peak at %d Hz, %u above baseline, %llu frames computed\n",
+               peak * 10, power[peak] - baseline[peak], static_cast<unsigned long long>(next));
+    }
+
+    // Test 16-bit PCM decode matches decoding the same samples as float
+    printf("\nTesting int16 decode...\n");
+    {
+        std::vector<int16_t> pcm(slot.size());
+        std::vector<float> pcm_float(slot.size());
+        for (size_t i = 0; i < slot.size(); ++i) {
+            pcm[i] = static_cast<int16_t>(std::lrint(slot[i] * 32767.0f));
+        }
+        pcm[1] = -32768;
+
+        // Odd length exercises the converter's scalar tail
+        JS8DSP::convert_samples(pcm.data(), pcm_float.data(), 1003);
+        for (size_t i = 0; i < 1003; ++i) {
+            if (pcm_float[i] != pcm[i] / 32768.0f) {
+                printf("ERROR: int16 sample %zu converted to %g\n", i, pcm_float[i]);
+                return 1;
+            }
+        }
+        JS8DSP::convert_samples(pcm.data(), pcm_float.data(), pcm.size());
+
+        js8dsp_decoded_message_t from_float[10];
+        js8dsp_decoded_message_t from_s16[10];
+        int float_count = js8dsp_decode_buffer(handle, pcm_float.data(), pcm_float.size(), from_float, 10);
+        before = g_allocations.load();
+        int s16_count = js8dsp_decode_buffer_s16(handle, pcm.data(), pcm.size(), from_s16, 10);
+        allocations = g_allocations.load() - before;
+        if (s16_count < 0 || s16_count != float_count) {
+            printf("ERROR: int16 decode returned %d results (float %d)\n", s16_count, float_count);
+            return 1;
+        }
+        for (int i = 0; i < s16_count; ++i) {
+            if (strcmp(from_s16[i].message, from_float[i].message) != 0 ||
+                from_s16[i].freq_offset != from_float[i].freq_offset) {
+                printf("ERROR: int16 result %d differs from float decode\n", i);
+                return 1;
+            }
+        }
+        if (allocations != 0) {
+            printf("ERROR: int16 decode made %zu heap allocations\n", allocations);
+            return 1;
+        }
+        printf("✓ int16 decode matches float decode (%d results)\n", s16_count);
+    }
+
+    // Test decode events are reported without an output array
+    printf("\nTesting decode events...\n");
+    {
+        EventCounts counts;
+        js8dsp_set_event_callback(handle, count_event, &counts, 1);
+        before = g_allocations.load();
+        int total = js8dsp_decode_buffer(handle, slot.data(), slot.size(), nullptr, 0);
+        allocations = g_allocations.load() - before;
+        js8dsp_set_event_callback(handle, nullptr, nullptr, 0);
+        js8dsp_metrics_t metrics;
+        js8dsp_get_metrics(handle, &metrics, sizeof(metrics));
+
+        if (total != second || counts.decoded != second) {
+            printf("ERROR: Event decode reported %d/%d results (expected %d)\n", total, counts.decoded, second);
+            return 1;
+        }
+        if (counts.started != 1 || counts.finished != 1 || counts.sync_start != 1 ||
+            counts.finished_total != static_cast<uint32_t>(second) || counts.sync_state < second ||
+            counts.finished_ns == 0 || counts.finished_ns != metrics.last_pass_ns) {
+            printf("ERROR: Unexpected event sequence\n");
+            return 1;
+        }
+        if (allocations != 0) {
+            printf("ERROR: Event decode made %zu heap allocations\n", allocations);
+            return 1;
+        }
+        printf("✓ Decode events reported %d results\n", counts.decoded);
+
+        // Streamed decodes reported as events are counted as their slot is
+        // decoded, and not queued as well
+        EventCounts stream_counts;
+        uint32_t decoded_before = 0, decoded_after = 0, errors = 0;
+        js8dsp_get_stats(handle, &decoded_before, &errors);
+        js8dsp_stream_start(handle, JS8DSP_SUBMODE_NORMAL);
+        js8dsp_set_event_callback(handle, count_event, &stream_counts, 0);
+        int pending = 0;
+        for (size_t offset = 0; offset < slot.size() && pending >= 0; offset += 4800) {
+            pending = std::max(pending, js8dsp_stream_push(handle, slot.data() + offset,
+                                                           std::min<size_t>(4800, slot.size() - offset)));
+        }
+        js8dsp_set_event_callback(handle, nullptr, nullptr, 0);
+        js8dsp_get_stats(handle, &decoded_after, &errors);
+        js8dsp_decoded_message_t unpolled[64];
+        int polled = js8dsp_stream_poll(handle, unpolled, 64);
+
+        if (stream_counts.decoded != second || pending != 0 || polled != 0 ||
+            decoded_after - decoded_before != static_cast<uint32_t>(second)) {
+            printf("ERROR: Streamed events reported %d results, counted %u, %d queued (expected %d)\n",
+                   stream_counts.decoded, decoded_after - decoded_before, std::max(pending, polled), second);
+            return 1;
+        }
+        printf("✓ Streamed events counted %d results without queueing them\n", stream_counts.decoded);
+    }
+
+    // Test every mode's buffer sizing through the full decode path
+    printf("\nTesting all modes...\n");
+    {
+        const int periods[] = {13, 7, 4, 26, 52};
+        for (int mode = JS8DSP_MODE_NORMAL; mode <= JS8DSP_MODE_ULTRA; ++mode) {
+            js8dsp_handle_t mode_handle = js8dsp_init(12000, static_cast<js8dsp_mode_t>(mode));
+            if (!mode_handle) {
+                printf("ERROR: Failed to initialize mode %d\n", mode);
+                return 1;
+            }
+            std::vector<float> mode_slot(12000 * periods[mode]);
+            for (size_t i = 0; i < mode_slot.size(); ++i) {
+                mode_slot[i] = 0.1f * std::sin(2.0f * static_cast<float>(M_PI) * 1000.0f * i / 12000.0f);
+            }
+            int result = js8dsp_decode_buffer(mode_handle, mode_slot.data(), mode_slot.size(), messages, 10);
+            js8dsp_cleanup(mode_handle);
+            if (result < 0) {
+                printf("ERROR: Decode failed in mode %d\n", mode);
+                return 1;
+            }
+        }
+        printf("✓ All modes decode without error\n");
     }
 
     // Test statistics
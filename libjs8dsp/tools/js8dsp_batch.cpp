@@ -0,0 +1,478 @@
+/**
+ * Offline batch decoder for slot recordings
+ *
+ * Memory-maps mono 16-bit WAV files, or headerless little-endian int16
+ * audio at a given rate, cuts them into back to back transmission
+ * periods starting at the first sample and decodes the periods on every
+ * core, with one js8dsp context per worker. Decodes are written to stdout
+ * as NDJSON in file and slot order as soon as every earlier slot is done;
+ * a summary with the throughput in slots per second goes to stderr as one
+ * JSON object. Each context carries its noise floor fit from one slot to
+ * the next, so SNRs can differ by a fraction of a dB with the job count.
+ */
+
+#include "js8dsp.h"
+#include <fcntl.h>
+#include <getopt.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr int DEFAULT_RAW_RATE = 12000;
+constexpr int DECODER_RATE = 12000;     // Rate of decoded timestamps
+constexpr int MAX_RESULTS = 256;        // Decodes kept per slot
+
+const char* const MODE_NAMES[] = {"normal", "fast", "turbo", "slow", "ultra"};
+constexpr int PERIOD_SECONDS[] = {15, 10, 6, 30, 60};
+
+// One mapped recording and its slots' place in the run
+struct Archive {
+    std::string path;
+    void* map = nullptr;
+    size_t map_size = 0;
+    const int16_t* samples = nullptr;
+    size_t count = 0;
+    int rate = 0;
+    size_t period = 0;          // Samples per slot
+    size_t first_slot = 0;      // Index of its first slot over all files
+    size_t slots = 0;
+};
+
+uint16_t read_u16(const unsigned char* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t read_u32(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// Find the samples of a mono 16-bit PCM WAV file; a data chunk size
+// beyond the end of the file, as left by recorders that were stopped,
+// is taken to mean the rest of the file
+bool parse_wav(Archive& archive, std::string& error) {
+    const auto* bytes = static_cast<const unsigned char*>(archive.map);
+    const size_t size = archive.map_size;
+    bool have_format = false;
+
+    size_t pos = 12;
+    while (pos + 8 <= size) {
+        const unsigned char* chunk = bytes + pos;
+        const size_t length = read_u32(chunk + 4);
+        const size_t body = pos + 8;
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            if (length < 16 || body + length > size) {
+                error = "truncated fmt chunk";
+                return false;
+            }
+            uint16_t format = read_u16(bytes + body);
+            const uint16_t channels = read_u16(bytes + body + 2);
+            const uint32_t rate = read_u32(bytes + body + 4);
+            const uint16_t bits = read_u16(bytes + body + 14);
+            if (format == 0xfffe && length >= 26) format = read_u16(bytes + body + 24);
+            if (format != 1 || channels != 1 || bits != 16) {
+                error = "not mono 16-bit PCM";
+                return false;
+            }
+            if (rate == 0 || rate > 1000000) {
+                error = "bad sample rate";
+                return false;
+            }
+            archive.rate = static_cast<int>(rate);
+            have_format = true;
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            if (!have_format) {
+                error = "data chunk before fmt chunk";
+                return false;
+            }
+            archive.samples = reinterpret_cast<const int16_t*>(bytes + body);
+            archive.count = std::min(length, size - body) / sizeof(int16_t);
+            return true;
+        }
+
+        // Chunks are padded to an even length, which keeps samples aligned
+        pos = body + length + (length & 1);
+    }
+
+    error = "no data chunk";
+    return false;
+}
+
+bool open_archive(Archive& archive, int raw_rate, std::string& error) {
+    int fd = open(archive.path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = std::strerror(errno);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        error = std::strerror(errno);
+        close(fd);
+        return false;
+    }
+    archive.map_size = static_cast<size_t>(st.st_size);
+    archive.rate = raw_rate;
+    if (archive.map_size == 0) {
+        close(fd);
+        return true;
+    }
+
+    archive.map = mmap(nullptr, archive.map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (archive.map == MAP_FAILED) {
+        archive.map = nullptr;
+        error = std::strerror(errno);
+        return false;
+    }
+    // Workers take slots in order, so the file is read nearly front to back
+    madvise(archive.map, archive.map_size, MADV_SEQUENTIAL);
+
+    const auto* bytes = static_cast<const unsigned char*>(archive.map);
+    if (archive.map_size >= 12 && std::memcmp(bytes, "RIFF", 4) == 0 && std::memcmp(bytes + 8, "WAVE", 4) == 0) {
+        return parse_wav(archive, error);
+    }
+
+    archive.samples = static_cast<const int16_t*>(archive.map);
+    archive.count = archive.map_size / sizeof(int16_t);
+    return true;
+}
+
+void close_archive(Archive& archive) {
+    if (archive.map) munmap(archive.map, archive.map_size);
+    archive.map = nullptr;
+}
+
+void append_json_string(std::string& out, const char* text) {
+    out += '"';
+    for (const char* p = text; *p; ++p) {
+        const auto c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += *p;
+        } else if (c < 0x20) {
+            char escape[8];
+            std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+            out += escape;
+        } else {
+            out += *p;
+        }
+    }
+    out += '"';
+}
+
+/**
+ * Writes each slot's lines once all earlier slots have been written, so
+ * output order does not depend on which worker finished first
+ */
+class OrderedWriter {
+public:
+    explicit OrderedWriter(size_t slots) : lines_(slots), done_(slots, 0) {}
+
+    void complete(size_t slot, std::string&& lines) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        lines_[slot] = std::move(lines);
+        done_[slot] = 1;
+        while (next_ < done_.size() && done_[next_]) {
+            std::fwrite(lines_[next_].data(), 1, lines_[next_].size(), stdout);
+            std::string().swap(lines_[next_]);
+            ++next_;
+        }
+        std::fflush(stdout);
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::string> lines_;
+    std::vector<char> done_;
+    size_t next_ = 0;
+};
+
+struct Totals {
+    std::atomic<uint64_t> decodes{0};
+    std::atomic<uint64_t> messages{0};     // Distinct texts per slot
+    std::atomic<uint64_t> sync_only{0};
+    std::atomic<uint64_t> errors{0};
+};
+
+// Every candidate that synced is reported by a SYNC_CANDIDATE event, and
+// again by a SYNC_DECODED event with the same frequency and time if it
+// decoded; the decoder does not return the others as results
+bool same_candidate(const js8dsp_sync_state_t& a, const js8dsp_sync_state_t& b) {
+    return a.mode == b.mode && a.channel == b.channel && a.frequency == b.frequency && a.dt == b.dt;
+}
+
+// A worker's decoder contexts, one per input sample rate seen
+class Worker {
+public:
+    Worker(js8dsp_mode_t mode, bool include_sync) : mode_(mode), include_sync_(include_sync) {}
+    Worker(const Worker&) = delete;
+    Worker& operator=(const Worker&) = delete;
+
+    ~Worker() {
+        for (auto& entry : contexts_) js8dsp_cleanup(entry.second);
+    }
+
+    js8dsp_handle_t context(int rate) {
+        for (auto& entry : contexts_) {
+            if (entry.first == rate) return entry.second;
+        }
+        js8dsp_handle_t handle = js8dsp_init(rate, mode_);
+        if (handle) {
+            // Parallelism is across slots; each slot decodes serially
+            js8dsp_set_threads(handle, 1);
+            js8dsp_set_event_callback(handle, collect_sync, this, 1);
+            contexts_.emplace_back(rate, handle);
+        }
+        return handle;
+    }
+
+    void decode(const Archive& archive, size_t slot, OrderedWriter& writer, Totals& totals) {
+        std::string lines;
+        js8dsp_handle_t handle = context(archive.rate);
+        int count = -1;
+        candidates_.clear();
+        decoded_.clear();
+        if (handle) {
+            count = js8dsp_decode_buffer_s16(handle, archive.samples + slot * archive.period, archive.period,
+                                             results_, MAX_RESULTS);
+        }
+
+        if (count < 0) {
+            std::fprintf(stderr, "js8dsp_batch: %s slot %zu: %s\n", archive.path.c_str(), slot,
+                         handle ? js8dsp_get_error(handle) : "cannot create decoder");
+            totals.errors.fetch_add(1, std::memory_order_relaxed);
+            count = 0;
+        }
+
+        const double start = static_cast<double>(slot * archive.period) / archive.rate;
+        uint64_t decodes = 0;
+        uint64_t messages = 0;
+        uint64_t sync_only = 0;
+        for (int i = 0; i < count; ++i) {
+            const js8dsp_decoded_message_t& result = results_[i];
+            ++decodes;
+            bool repeat = false;
+            for (int j = 0; j < i && !repeat; ++j) {
+                repeat = std::strcmp(results_[j].message, result.message) == 0;
+            }
+            if (!repeat) ++messages;
+
+            const int mode = result.mode >= 0 && result.mode <= JS8DSP_MODE_ULTRA ? result.mode : mode_;
+            char fields[224];
+            lines += "{\"file\":";
+            append_json_string(lines, archive.path.c_str());
+            std::snprintf(fields, sizeof(fields),
+                          ",\"slot\":%zu,\"time\":%.3f,\"mode\":\"%s\",\"freq_offset\":%.1f,\"snr\":%.1f,"
+                          "\"offset\":%.3f,\"confidence\":%d,\"decoded\":true,\"message\":",
+                          slot, start, MODE_NAMES[mode], result.freq_offset, result.snr,
+                          static_cast<double>(result.timestamp) / DECODER_RATE, result.confidence);
+            lines += fields;
+            append_json_string(lines, result.message);
+            lines += "}\n";
+        }
+
+        for (const js8dsp_sync_state_t& candidate : candidates_) {
+            bool decoded = false;
+            for (size_t j = 0; j < decoded_.size() && !decoded; ++j) decoded = same_candidate(candidate, decoded_[j]);
+            if (decoded) continue;
+
+            ++sync_only;
+            if (!include_sync_) continue;
+
+            const int mode = candidate.mode >= 0 && candidate.mode <= JS8DSP_MODE_ULTRA ? candidate.mode : mode_;
+            char fields[224];
+            lines += "{\"file\":";
+            append_json_string(lines, archive.path.c_str());
+            std::snprintf(fields, sizeof(fields),
+                          ",\"slot\":%zu,\"time\":%.3f,\"mode\":\"%s\",\"freq_offset\":%.1f,"
+                          "\"offset\":%.3f,\"sync\":%.1f,\"decoded\":false}\n",
+                          slot, start, MODE_NAMES[mode], candidate.frequency - 1500.0f, candidate.dt, candidate.sync);
+            lines += fields;
+        }
+
+        totals.decodes.fetch_add(decodes, std::memory_order_relaxed);
+        totals.messages.fetch_add(messages, std::memory_order_relaxed);
+        totals.sync_only.fetch_add(sync_only, std::memory_order_relaxed);
+        writer.complete(archive.first_slot + slot, std::move(lines));
+    }
+
+private:
+    static void collect_sync(const js8dsp_event_t* event, void* user_data) {
+        if (event->type != JS8DSP_EVENT_SYNC_STATE) return;
+
+        Worker* worker = static_cast<Worker*>(user_data);
+        const js8dsp_sync_state_t& state = event->data.sync_state;
+        (state.type == JS8DSP_SYNC_DECODED ? worker->decoded_ : worker->candidates_).push_back(state);
+    }
+
+    js8dsp_mode_t mode_;
+    bool include_sync_;
+    std::vector<std::pair<int, js8dsp_handle_t>> contexts_;
+    js8dsp_decoded_message_t results_[MAX_RESULTS];
+
+    // SYNC_STATE events of the slot being decoded
+    std::vector<js8dsp_sync_state_t> candidates_;
+    std::vector<js8dsp_sync_state_t> decoded_;
+};
+
+void usage(FILE* out) {
+    std::fprintf(out,
+                 "Usage: js8dsp_batch [options] file...\n"
+                 "Decode slot recordings: mono 16-bit WAV, or raw little-endian int16\n"
+                 "\n"
+                 "  -m, --mode MODE     normal, fast, turbo, slow or ultra (default normal)\n"
+                 "  -j, --jobs N        decode N slots at once (default one per CPU)\n"
+                 "  -r, --rate HZ       sample rate of raw files (default %d)\n"
+                 "  -s, --sync          also write candidates that synced but did not decode\n"
+                 "  -h, --help          show this help\n",
+                 DEFAULT_RAW_RATE);
+}
+
+bool parse_mode(const char* name, js8dsp_mode_t& mode) {
+    for (int i = 0; i <= JS8DSP_MODE_ULTRA; ++i) {
+        if (std::strcmp(name, MODE_NAMES[i]) == 0) {
+            mode = static_cast<js8dsp_mode_t>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parse_positive(const char* text, int& value) {
+    char* end = nullptr;
+    errno = 0;
+    const long parsed = std::strtol(text, &end, 10);
+    if (errno != 0 || end == text || *end != '\0' || parsed <= 0 || parsed > 1000000) return false;
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    js8dsp_mode_t mode = JS8DSP_MODE_NORMAL;
+    int jobs = static_cast<int>(std::thread::hardware_concurrency());
+    int raw_rate = DEFAULT_RAW_RATE;
+    bool include_sync = false;
+
+    static const option options[] = {
+        {"mode", required_argument, nullptr, 'm'},
+        {"jobs", required_argument, nullptr, 'j'},
+        {"rate", required_argument, nullptr, 'r'},
+        {"sync", no_argument, nullptr, 's'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0},
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "m:j:r:sh", options, nullptr)) != -1) {
+        switch (opt) {
+        case 'm':
+            if (!parse_mode(optarg, mode)) {
+                std::fprintf(stderr, "js8dsp_batch: unknown mode '%s'\n", optarg);
+                return 2;
+            }
+            break;
+        case 'j':
+            if (!parse_positive(optarg, jobs)) {
+                std::fprintf(stderr, "js8dsp_batch: bad job count '%s'\n", optarg);
+                return 2;
+            }
+            break;
+        case 'r':
+            if (!parse_positive(optarg, raw_rate)) {
+                std::fprintf(stderr, "js8dsp_batch: bad sample rate '%s'\n", optarg);
+                return 2;
+            }
+            break;
+        case 's':
+            include_sync = true;
+            break;
+        case 'h':
+            usage(stdout);
+            return 0;
+        default:
+            usage(stderr);
+            return 2;
+        }
+    }
+    if (optind == argc) {
+        usage(stderr);
+        return 2;
+    }
+    jobs = std::max(jobs, 1);
+
+    // Map every file up front so slots can be numbered across the run
+    std::vector<Archive> archives;
+    size_t total_slots = 0;
+    int status = 0;
+    for (int i = optind; i < argc; ++i) {
+        Archive archive;
+        archive.path = argv[i];
+        std::string error;
+        if (!open_archive(archive, raw_rate, error)) {
+            std::fprintf(stderr, "js8dsp_batch: %s: %s\n", argv[i], error.c_str());
+            close_archive(archive);
+            status = 1;
+            continue;
+        }
+        archive.period = static_cast<size_t>(archive.rate) * PERIOD_SECONDS[mode];
+        archive.first_slot = total_slots;
+        archive.slots = archive.count / archive.period;
+        total_slots += archive.slots;
+        archives.push_back(std::move(archive));
+    }
+
+    OrderedWriter writer(total_slots);
+    Totals totals;
+    std::atomic<size_t> next_slot{0};
+    jobs = static_cast<int>(std::min<size_t>(static_cast<size_t>(jobs), std::max<size_t>(total_slots, 1)));
+
+    const auto started = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < jobs; ++t) {
+        threads.emplace_back([&] {
+            Worker worker(mode, include_sync);
+            for (;;) {
+                const size_t slot = next_slot.fetch_add(1, std::memory_order_relaxed);
+                if (slot >= total_slots) break;
+                auto archive = std::upper_bound(archives.begin(), archives.end(), slot,
+                                                [](size_t s, const Archive& a) { return s < a.first_slot; }) - 1;
+                worker.decode(*archive, slot - archive->first_slot, writer, totals);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    for (auto& archive : archives) close_archive(archive);
+
+    const uint64_t errors = totals.errors.load();
+    std::fprintf(stderr,
+                 "{\"files\":%zu,\"slots\":%zu,\"decodes\":%llu,\"messages\":%llu,\"sync_only\":%llu,"
+                 "\"errors\":%llu,\"mode\":\"%s\",\"jobs\":%d,"
+                 "\"seconds\":%.3f,\"slots_per_second\":%.2f,\"version\":\"%s\"}\n",
+                 archives.size(), total_slots, static_cast<unsigned long long>(totals.decodes.load()),
+                 static_cast<unsigned long long>(totals.messages.load()),
+                 static_cast<unsigned long long>(totals.sync_only.load()),
+                 static_cast<unsigned long long>(errors), MODE_NAMES[mode], jobs, seconds,
+                 seconds > 0.0 ? total_slots / seconds : 0.0, js8dsp_get_version());
+
+    return errors ? 1 : status;
+}
@@ -3,6 +3,7 @@ package config
 import (
 	"fmt"
 	"os"
+	"path/filepath"
 
 	"gopkg.in/yaml.v2"
 )
@@ -72,8 +73,9 @@ type Config struct {
 	} `yaml:"api"`
 
 	Storage struct {
-		DatabasePath string `yaml:"database_path"`
-		MaxMessages  int    `yaml:"max_messages"`
+		DatabasePath     string `yaml:"database_path"`
+		MaxMessages      int    `yaml:"max_messages"`
+		DecoderStatePath string `yaml:"decoder_state_path"` // decoder state kept over restarts
 	} `yaml:"storage"`
 
 	Logging struct {
@@ -174,6 +176,9 @@ func LoadConfig(path string) (*Config, error) {
 	if config.Storage.MaxMessages == 0 {
 		config.Storage.MaxMessages = 10000
 	}
+	if config.Storage.DecoderStatePath == "" && config.Storage.DatabasePath != "" {
+		config.Storage.DecoderStatePath = filepath.Join(filepath.Dir(config.Storage.DatabasePath), "decoder.state")
+	}
 
 	// Set logging defaults
 	if config.Logging.Level == "" {
@@ -78,6 +78,9 @@ logging:
 		if config.Storage.MaxMessages != 5000 {
 			t.Errorf("Expected max messages 5000, got %d", config.Storage.MaxMessages)
 		}
+		if config.Storage.DecoderStatePath != "/tmp/decoder.state" {
+			t.Errorf("Expected decoder state beside the database, got %s", config.Storage.DecoderStatePath)
+		}
 		if config.Logging.Level != "debug" {
 			t.Errorf("Expected log level debug, got %s", config.Logging.Level)
 		}
@@ -24,6 +24,84 @@ type DSPEngine interface {
 	GetToneCount(mode JS8Mode) int
 }
 
+// StreamingDSP is implemented by engines that can decode audio as it
+// arrives instead of from whole buffers
+type StreamingDSP interface {
+	StreamStart(modes []JS8Mode) error
+	StreamPush(audioData []int16, callback func(*DecodeResult)) (int, error)
+}
+
+// MetricsDSP is implemented by engines that can report where decode time
+// goes
+type MetricsDSP interface {
+	GetMetrics() (*DecoderMetrics, error)
+}
+
+// SpectrumDSP is implemented by engines that can share the symbol spectra
+// their decoder computes, so a waterfall needs no transform of its own
+type SpectrumDSP interface {
+	GetSpectrum(mode JS8Mode, lowHz, highHz float32, bins int, dbMin, dbMax float32) (*Spectrum, error)
+}
+
+// StateDSP is implemented by engines that can carry what their decoder
+// has learned over a restart
+type StateDSP interface {
+	SaveState() ([]byte, error)
+	LoadState(state []byte) error
+}
+
+// Spectrum is one waterfall row: the power spectrum of the decoder's latest
+// symbol frame and the noise baseline of its latest slot, in bins evenly
+// splitting LowHz to HighHz. Levels are dB scaled from DBMin to DBMax onto
+// 0 to 255. Frame counts the frames the decoder has computed, so a row
+// with the same Frame as the last one read is not new.
+type Spectrum struct {
+	Frame    uint64  `json:"frame"`
+	LowHz    float32 `json:"low_hz"`
+	HighHz   float32 `json:"high_hz"`
+	DBMin    float32 `json:"db_min"`
+	DBMax    float32 `json:"db_max"`
+	Power    []uint8 `json:"power"`
+	Baseline []uint8 `json:"baseline"`
+}
+
+// DecoderMetrics reports decoder work since the engine was initialized.
+// Times are in nanoseconds, keyed by stage name; the Last fields cover the
+// most recent decode pass. CallNs is the time spent in decode calls as
+// seen from Go, including delivering decodes to callbacks, so comparing
+// it with the stage times separates library work from Go side work.
+// MedianPassNs and WorstPassNs rank the wall clock time of recent decode
+// passes, from the end of a slot until its decodes are ready.
+type DecoderMetrics struct {
+	Passes                  uint64            `json:"passes"`
+	StageTotalNs            map[string]uint64 `json:"stage_total_ns"`
+	StageLastNs             map[string]uint64 `json:"stage_last_ns"`
+	CandidatesFound         uint64            `json:"candidates_found"`
+	CandidatesAttempted     uint64            `json:"candidates_attempted"`
+	CandidatesDecoded       uint64            `json:"candidates_decoded"`
+	LastCandidatesFound     uint32            `json:"last_candidates_found"`
+	LastCandidatesAttempted uint32            `json:"last_candidates_attempted"`
+	LastCandidatesDecoded   uint32            `json:"last_candidates_decoded"`
+	CandidatesSuppressed    uint64            `json:"candidates_suppressed"`
+	CandidatesSkipped       uint64            `json:"candidates_skipped"`
+	LDPCIterations          []uint64          `json:"ldpc_iterations"`
+	LDPCFailures            uint64            `json:"ldpc_failures"`
+	Allocations             uint64            `json:"allocations"`
+	ArenaBytes              uint64            `json:"arena_bytes"`
+	ArenaPeakBytes          uint64            `json:"arena_peak_bytes"`
+	DecodeRounds            uint64            `json:"decode_rounds"`
+	SignalsSubtracted       uint64            `json:"signals_subtracted"`
+	LastPassNs              uint64            `json:"last_pass_ns"`
+	MedianPassNs            uint64            `json:"median_pass_ns"`
+	WorstPassNs             uint64            `json:"worst_pass_ns"`
+	MaxPassNs               uint64            `json:"max_pass_ns"`
+	LockedBytes             uint64            `json:"locked_bytes"`
+	TotalDecoded            uint32            `json:"total_decoded"`
+	TotalErrors             uint32            `json:"total_errors"`
+	CallTotalNs             uint64            `json:"call_total_ns"`
+	CallLastNs              uint64            `json:"call_last_ns"`
+}
+
 // JS8Mode represents JS8 submodes
 type JS8Mode int
 
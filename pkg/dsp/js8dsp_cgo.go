@@ -5,10 +5,14 @@ package dsp
 #cgo LDFLAGS: -L/home/doug/bin/js8d/libjs8dsp/build -ljs8dsp -lstdc++ -lm
 #include "js8dsp.h"
 #include <stdlib.h>
+
+extern void goJS8Event(js8dsp_event_t* event, void* userData);
 */
 import "C"
 import (
 	"fmt"
+	"runtime/cgo"
+	"sync/atomic"
 	"time"
 	"unsafe"
 )
@@ -17,12 +21,31 @@ import (
 type CppDSP struct {
 	handle     C.js8dsp_handle_t
 	sampleRate int
+	threads    int
+
+	// Thread policy, applied by Initialize once set
+	policySet        bool
+	cpus             []int
+	realtimePriority int
+	lockMemory       bool
+
+	// Decodes are delivered through the library's event callback. events
+	// is C memory holding a handle to this CppDSP, passed as user data.
+	events    *C.uintptr_t
+	onDecoded func(*DecodeResult)
+	decoded   int
+
+	// Time spent in decode and push calls, read by GetMetrics from any
+	// goroutine
+	callTotalNs atomic.Uint64
+	callLastNs  atomic.Uint64
 }
 
 // NewCppDSP creates a new C++ DSP instance
 func NewCppDSP() *CppDSP {
 	return &CppDSP{
 		sampleRate: 48000, // Default to 48kHz
+		threads:    1,     // Serial candidate decode
 	}
 }
 
@@ -32,6 +55,26 @@ func (d *CppDSP) Initialize() error {
 	if d.handle == nil {
 		return fmt.Errorf("failed to initialize JS8DSP library")
 	}
+	if d.threads != 1 {
+		if result := C.js8dsp_set_threads(d.handle, C.int(d.threads)); result != C.JS8DSP_OK {
+			return fmt.Errorf("failed to set decode threads: %d", int(result))
+		}
+	}
+	if d.policySet {
+		if err := d.applyThreadPolicy(); err != nil {
+			return err
+		}
+	}
+
+	// The buffered engine decodes a growing buffer several times per slot
+	C.js8dsp_set_decode_cache(d.handle, 1)
+
+	// Weak signals beside strong ones decode once the strong are subtracted
+	C.js8dsp_set_decode_rounds(d.handle, C.JS8DSP_MAX_DECODE_ROUNDS)
+
+	d.events = (*C.uintptr_t)(C.malloc(C.sizeof_uintptr_t))
+	*d.events = C.uintptr_t(cgo.NewHandle(d))
+	C.js8dsp_set_event_callback(d.handle, C.js8dsp_event_callback_t(C.goJS8Event), unsafe.Pointer(d.events), 0)
 	return nil
 }
 
@@ -41,6 +84,41 @@ func (d *CppDSP) Close() {
 		C.js8dsp_cleanup(d.handle)
 		d.handle = nil
 	}
+	if d.events != nil {
+		cgo.Handle(*d.events).Delete()
+		C.free(unsafe.Pointer(d.events))
+		d.events = nil
+	}
+}
+
+// goJS8Event receives decode events from the library. Calls never overlap,
+// though they may come from decoder worker threads, and all of them happen
+// before the decode or push call that caused them returns.
+//
+//export goJS8Event
+func goJS8Event(event *C.js8dsp_event_t, userData unsafe.Pointer) {
+	d := cgo.Handle(*(*C.uintptr_t)(userData)).Value().(*CppDSP)
+	if event._type != C.JS8DSP_EVENT_DECODED || d.onDecoded == nil {
+		return
+	}
+
+	msg := (*C.js8dsp_decoded_message_t)(unsafe.Pointer(&event.data[0]))
+	d.decoded++
+	d.onDecoded(decodeResult(msg))
+}
+
+// deliver runs fn with decode events routed to callback and returns the
+// number of messages delivered
+func (d *CppDSP) deliver(callback func(*DecodeResult), fn func()) int {
+	d.onDecoded = callback
+	d.decoded = 0
+	start := time.Now()
+	fn()
+	elapsed := uint64(time.Since(start).Nanoseconds())
+	d.callTotalNs.Add(elapsed)
+	d.callLastNs.Store(elapsed)
+	d.onDecoded = nil
+	return d.decoded
 }
 
 // SetSampleRate sets the audio sample rate
@@ -53,13 +131,129 @@ func (d *CppDSP) SetSampleRate(rate int) {
 	}
 }
 
+// SetThreads sets the number of threads used to decode candidates;
+// 0 uses one per CPU
+func (d *CppDSP) SetThreads(threads int) error {
+	if threads < 0 {
+		return fmt.Errorf("invalid thread count: %d", threads)
+	}
+	d.threads = threads
+	if d.handle != nil {
+		if result := C.js8dsp_set_threads(d.handle, C.int(threads)); result != C.JS8DSP_OK {
+			return fmt.Errorf("failed to set decode threads: %d", int(result))
+		}
+	}
+	return nil
+}
+
+// SetThreadPolicy pins decode workers to CPUs, worker i to
+// cpus[i % len(cpus)] and the calling thread counting as worker 0, runs
+// decode passes at the given SCHED_FIFO priority when it is above 0, and
+// locks decoder memory in RAM, so that decode latency holds up beside
+// other work on the machine. Real-time priority and locked memory need
+// privilege; if the system refuses, decoding carries on as before and
+// the error says why.
+func (d *CppDSP) SetThreadPolicy(cpus []int, realtimePriority int, lockMemory bool) error {
+	if len(cpus) > C.JS8DSP_MAX_PINNED_CPUS {
+		return fmt.Errorf("too many CPUs to pin to: %d", len(cpus))
+	}
+	if realtimePriority < 0 {
+		return fmt.Errorf("invalid real-time priority: %d", realtimePriority)
+	}
+	d.policySet = true
+	d.cpus = append([]int(nil), cpus...)
+	d.realtimePriority = realtimePriority
+	d.lockMemory = lockMemory
+	if d.handle != nil {
+		return d.applyThreadPolicy()
+	}
+	return nil
+}
+
+func (d *CppDSP) applyThreadPolicy() error {
+	var policy C.js8dsp_thread_policy_t
+	policy.cpu_count = C.int(len(d.cpus))
+	for i, cpu := range d.cpus {
+		policy.cpus[i] = C.int(cpu)
+	}
+	if d.realtimePriority > 0 {
+		policy.sched = C.JS8DSP_SCHED_FIFO
+		policy.priority = C.int(d.realtimePriority)
+	}
+	if d.lockMemory {
+		policy.lock_memory = 1
+	}
+
+	if result := C.js8dsp_set_thread_policy(d.handle, &policy); result != C.JS8DSP_OK {
+		return fmt.Errorf("failed to set thread policy: %s", d.GetError())
+	}
+	return nil
+}
+
 // GetSampleRate returns the current sample rate
 func (d *CppDSP) GetSampleRate() int {
 	return d.sampleRate
 }
 
+// cModeToJS8Mode maps a js8dsp_mode_t to the JS8Call submode number
+func cModeToJS8Mode(mode C.int) JS8Mode {
+	switch mode {
+	case C.JS8DSP_MODE_FAST:
+		return ModeFast
+	case C.JS8DSP_MODE_TURBO:
+		return ModeTurbo
+	case C.JS8DSP_MODE_SLOW:
+		return ModeSlow
+	case C.JS8DSP_MODE_ULTRA:
+		return ModeUltra
+	default:
+		return ModeNormal
+	}
+}
+
+// js8ModeToSubmode maps a JS8Call submode number to its JS8DSP_SUBMODE_* bit
+func js8ModeToSubmode(mode JS8Mode) (C.uint32_t, error) {
+	switch mode {
+	case ModeNormal:
+		return C.JS8DSP_SUBMODE_NORMAL, nil
+	case ModeFast:
+		return C.JS8DSP_SUBMODE_FAST, nil
+	case ModeTurbo:
+		return C.JS8DSP_SUBMODE_TURBO, nil
+	case ModeSlow:
+		return C.JS8DSP_SUBMODE_SLOW, nil
+	case ModeUltra:
+		return C.JS8DSP_SUBMODE_ULTRA, nil
+	default:
+		return 0, fmt.Errorf("unknown mode: %d", mode)
+	}
+}
+
 // DecodeBuffer decodes audio samples and calls the callback for each decoded message
 func (d *CppDSP) DecodeBuffer(audioData []int16, callback func(*DecodeResult)) (int, error) {
+	return d.decode(audioData, 0, callback)
+}
+
+// DecodeBufferMulti decodes the same audio in each of the given modes in one
+// pass and calls the callback for each decoded message
+func (d *CppDSP) DecodeBufferMulti(audioData []int16, modes []JS8Mode, callback func(*DecodeResult)) (int, error) {
+	var submodes C.uint32_t
+	for _, mode := range modes {
+		bit, err := js8ModeToSubmode(mode)
+		if err != nil {
+			return 0, err
+		}
+		submodes |= bit
+	}
+	if submodes == 0 {
+		return 0, fmt.Errorf("no modes selected")
+	}
+	return d.decode(audioData, submodes, callback)
+}
+
+// decode runs a single-mode decode when submodes is 0, otherwise a
+// multi-mode decode over the given submode mask
+func (d *CppDSP) decode(audioData []int16, submodes C.uint32_t, callback func(*DecodeResult)) (int, error) {
 	if d.handle == nil {
 		return 0, fmt.Errorf("DSP not initialized")
 	}
@@ -72,24 +266,32 @@ func (d *CppDSP) DecodeBuffer(audioData []int16, callback func(*DecodeResult)) (
 		return 0, fmt.Errorf("callback function required")
 	}
 
-	// Convert int16 to float32 for C++ API
-	floatData := make([]float32, len(audioData))
-	for i, sample := range audioData {
-		floatData[i] = float32(sample) / 32768.0
-	}
-
-	// Prepare output buffer for decoded messages
-	const maxMessages = 10
-	messages := make([]C.js8dsp_decoded_message_t, maxMessages)
-
-	// Call C++ decode function
-	decodeCount := C.js8dsp_decode_buffer(
-		d.handle,
-		(*C.float)(unsafe.Pointer(&floatData[0])),
-		C.size_t(len(floatData)),
-		&messages[0],
-		C.int(maxMessages),
-	)
+	// Call C++ decode function on the int16 samples in place; the library
+	// converts them into its own buffers and only reads them during the
+	// call. Messages arrive through goJS8Event as each candidate decodes,
+	// so no output array is needed.
+	samples := (*C.int16_t)(unsafe.Pointer(&audioData[0]))
+	var decodeCount C.int
+	d.deliver(callback, func() {
+		if submodes == 0 {
+			decodeCount = C.js8dsp_decode_buffer_s16(
+				d.handle,
+				samples,
+				C.size_t(len(audioData)),
+				nil,
+				0,
+			)
+		} else {
+			decodeCount = C.js8dsp_decode_buffer_multi_s16(
+				d.handle,
+				samples,
+				C.size_t(len(audioData)),
+				submodes,
+				nil,
+				0,
+			)
+		}
+	})
 
 	if decodeCount < 0 {
 		errorMsg := C.js8dsp_get_error(d.handle)
@@ -99,23 +301,82 @@ func (d *CppDSP) DecodeBuffer(audioData []int16, callback func(*DecodeResult)) (
 		return 0, fmt.Errorf("decode failed with code %d", int(decodeCount))
 	}
 
-	// Convert C messages to Go and call callback
-	for i := 0; i < int(decodeCount); i++ {
-		msg := &messages[i]
-		result := &DecodeResult{
-			UTC:       int(time.Now().Unix()),
-			SNR:       int(msg.snr),
-			DT:        0.0, // Not used in current implementation
-			Frequency: float32(msg.freq_offset),
-			Message:   C.GoString(&msg.message[0]),
-			Type:      0,
-			Quality:   float32(msg.confidence) / 100.0,
-			Mode:      int(ModeNormal),
+	return int(decodeCount), nil
+}
+
+// decodeResult converts a C message to Go
+func decodeResult(msg *C.js8dsp_decoded_message_t) *DecodeResult {
+	return &DecodeResult{
+		UTC:       int(time.Now().Unix()),
+		SNR:       int(msg.snr),
+		DT:        0.0, // Not used in current implementation
+		Frequency: float32(msg.freq_offset),
+		Message:   C.GoString(&msg.message[0]),
+		Type:      0,
+		Quality:   float32(msg.confidence) / 100.0,
+		Mode:      int(cModeToJS8Mode(msg.mode)),
+	}
+}
+
+// StreamStart starts, or restarts, streaming decode in the given modes. The
+// first slot of every mode begins with the next pushed sample.
+func (d *CppDSP) StreamStart(modes []JS8Mode) error {
+	if d.handle == nil {
+		return fmt.Errorf("DSP not initialized")
+	}
+
+	var submodes C.uint32_t
+	for _, mode := range modes {
+		bit, err := js8ModeToSubmode(mode)
+		if err != nil {
+			return err
 		}
-		callback(result)
+		submodes |= bit
+	}
+	if submodes == 0 {
+		return fmt.Errorf("no modes selected")
 	}
 
-	return int(decodeCount), nil
+	if result := C.js8dsp_stream_start(d.handle, submodes); result != C.JS8DSP_OK {
+		return fmt.Errorf("failed to start stream: %d", int(result))
+	}
+	return nil
+}
+
+// StreamPush feeds a chunk of audio into the running stream and calls the
+// callback for every message decoded from slots the chunk completed
+func (d *CppDSP) StreamPush(audioData []int16, callback func(*DecodeResult)) (int, error) {
+	if d.handle == nil {
+		return 0, fmt.Errorf("DSP not initialized")
+	}
+
+	if callback == nil {
+		return 0, fmt.Errorf("callback function required")
+	}
+
+	if len(audioData) == 0 {
+		return 0, nil
+	}
+
+	// Slots completed by this chunk report their decodes as events; the
+	// poll queue is left to callers of the C API that do not use them
+	var pending C.int
+	delivered := d.deliver(callback, func() {
+		pending = C.js8dsp_stream_push_s16(
+			d.handle,
+			(*C.int16_t)(unsafe.Pointer(&audioData[0])),
+			C.size_t(len(audioData)),
+		)
+	})
+	if pending < 0 {
+		errorMsg := C.js8dsp_get_error(d.handle)
+		if errorMsg != nil {
+			return 0, fmt.Errorf("stream error: %s", C.GoString(errorMsg))
+		}
+		return 0, fmt.Errorf("stream push failed with code %d", int(pending))
+	}
+
+	return delivered, nil
 }
 
 // EncodeMessage encodes a text message to audio samples using C++ DSP
@@ -249,4 +510,136 @@ func (d *CppDSP) GetStats() (totalDecoded, totalErrors uint32, err error) {
 	}
 
 	return uint32(decoded), uint32(errors), nil
-}
\ No newline at end of file
+}
+
+// stageNames are the js8dsp_stage_t stages, in order
+var stageNames = [C.JS8DSP_STAGE_COUNT]string{
+	"ingest", "fft", "baseline", "candidates", "sync", "llr", "ldpc", "unpack",
+}
+
+// GetMetrics returns decoder stage timings and counters. It does not block
+// on a running decode, so it is safe to call from a status handler.
+func (d *CppDSP) GetMetrics() (*DecoderMetrics, error) {
+	if d.handle == nil {
+		return nil, fmt.Errorf("DSP not initialized")
+	}
+
+	var m C.js8dsp_metrics_t
+	if result := C.js8dsp_get_metrics(d.handle, &m, C.sizeof_js8dsp_metrics_t); result != C.JS8DSP_OK {
+		return nil, fmt.Errorf("failed to get metrics: %d", int(result))
+	}
+
+	metrics := &DecoderMetrics{
+		Passes:                  uint64(m.passes),
+		StageTotalNs:            make(map[string]uint64, len(stageNames)),
+		StageLastNs:             make(map[string]uint64, len(stageNames)),
+		CandidatesFound:         uint64(m.candidates_found),
+		CandidatesAttempted:     uint64(m.candidates_attempted),
+		CandidatesDecoded:       uint64(m.candidates_decoded),
+		LastCandidatesFound:     uint32(m.last_candidates_found),
+		LastCandidatesAttempted: uint32(m.last_candidates_attempted),
+		LastCandidatesDecoded:   uint32(m.last_candidates_decoded),
+		CandidatesSuppressed:    uint64(m.candidates_suppressed),
+		CandidatesSkipped:       uint64(m.candidates_skipped),
+		LDPCIterations:          make([]uint64, len(m.ldpc_iterations)),
+		LDPCFailures:            uint64(m.ldpc_failures),
+		Allocations:             uint64(m.allocations),
+		ArenaBytes:              uint64(m.arena_bytes),
+		ArenaPeakBytes:          uint64(m.arena_peak_bytes),
+		DecodeRounds:            uint64(m.decode_rounds),
+		SignalsSubtracted:       uint64(m.signals_subtracted),
+		LastPassNs:              uint64(m.last_pass_ns),
+		MedianPassNs:            uint64(m.median_pass_ns),
+		WorstPassNs:             uint64(m.worst_pass_ns),
+		MaxPassNs:               uint64(m.max_pass_ns),
+		LockedBytes:             uint64(m.locked_bytes),
+		TotalDecoded:            uint32(m.total_decoded),
+		TotalErrors:             uint32(m.total_errors),
+		CallTotalNs:             d.callTotalNs.Load(),
+		CallLastNs:              d.callLastNs.Load(),
+	}
+	for i, name := range stageNames {
+		metrics.StageTotalNs[name] = uint64(m.stage_total_ns[i])
+		metrics.StageLastNs[name] = uint64(m.stage_last_ns[i])
+	}
+	for i, count := range m.ldpc_iterations {
+		metrics.LDPCIterations[i] = uint64(count)
+	}
+	return metrics, nil
+}
+
+// GetSpectrum returns the latest waterfall row of a submode's decoder. It
+// does not block on a running decode, so it is safe to call from a
+// handler serving the web UI.
+func (d *CppDSP) GetSpectrum(mode JS8Mode, lowHz, highHz float32, bins int, dbMin, dbMax float32) (*Spectrum, error) {
+	if d.handle == nil {
+		return nil, fmt.Errorf("DSP not initialized")
+	}
+	if bins <= 0 {
+		return nil, fmt.Errorf("invalid bin count: %d", bins)
+	}
+
+	layout := C.js8dsp_spectrum_layout_t{
+		low_hz:  C.float(lowHz),
+		high_hz: C.float(highHz),
+		bins:    C.uint32_t(bins),
+		format:  C.JS8DSP_SPECTRUM_U8,
+		db_min:  C.float(dbMin),
+		db_max:  C.float(dbMax),
+	}
+	spectrum := &Spectrum{
+		LowHz:    lowHz,
+		HighHz:   highHz,
+		DBMin:    dbMin,
+		DBMax:    dbMax,
+		Power:    make([]uint8, bins),
+		Baseline: make([]uint8, bins),
+	}
+
+	var frame C.uint64_t
+	result := C.js8dsp_get_spectrum(d.handle, C.int(mode), 0, &layout,
+		unsafe.Pointer(&spectrum.Power[0]), unsafe.Pointer(&spectrum.Baseline[0]), &frame)
+	if result != C.JS8DSP_OK {
+		return nil, fmt.Errorf("failed to get spectrum: %d", int(result))
+	}
+
+	spectrum.Frame = uint64(frame)
+	return spectrum, nil
+}
+
+// SaveState returns what the decoder has learned, its tuning, noise floor
+// fits, decode cache and FFT wisdom, for LoadState after a restart. The
+// state only suits this library build on this machine.
+func (d *CppDSP) SaveState() ([]byte, error) {
+	if d.handle == nil {
+		return nil, fmt.Errorf("DSP not initialized")
+	}
+
+	var size C.size_t
+	if result := C.js8dsp_save_state(d.handle, nil, 0, &size); result != C.JS8DSP_OK {
+		return nil, fmt.Errorf("failed to size decoder state: %d", int(result))
+	}
+
+	state := make([]byte, int(size))
+	if result := C.js8dsp_save_state(d.handle, unsafe.Pointer(&state[0]), size, &size); result != C.JS8DSP_OK {
+		return nil, fmt.Errorf("failed to save decoder state: %s", d.GetError())
+	}
+	return state[:int(size)], nil
+}
+
+// LoadState restores a state returned by SaveState, so that the first slot
+// decodes as it would in steady state. A damaged state, or one from
+// another library version, is refused and changes nothing.
+func (d *CppDSP) LoadState(state []byte) error {
+	if d.handle == nil {
+		return fmt.Errorf("DSP not initialized")
+	}
+	if len(state) == 0 {
+		return fmt.Errorf("empty decoder state")
+	}
+
+	if result := C.js8dsp_load_state(d.handle, unsafe.Pointer(&state[0]), C.size_t(len(state))); result != C.JS8DSP_OK {
+		return fmt.Errorf("failed to load decoder state: %s", d.GetError())
+	}
+	return nil
+}
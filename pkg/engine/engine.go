@@ -136,6 +136,7 @@ func (e *CoreEngine) Start() error {
 		return fmt.Errorf("failed to initialize DSP engine: %w", err)
 	}
 	log.Printf("DSP engine initialized successfully (sample rate: %d Hz)", e.hardwareManager.GetConfig().SampleRate)
+	e.loadDecoderState()
 
 	// Initialize hardware manager
 	if err := e.hardwareManager.Initialize(); err != nil {
@@ -385,6 +386,13 @@ func (e *CoreEngine) handleStatus() *protocol.Response {
 		data["hardware"] = hardwareStatus
 	}
 
+	// Decoder stage timings, to tell a slow FFT or LDPC from a slow Go side
+	if reporter, ok := e.dspEngine.(dsp.MetricsDSP); ok {
+		if metrics, err := reporter.GetMetrics(); err == nil {
+			data["dsp"] = metrics
+		}
+	}
+
 	return protocol.NewSuccessResponse(data)
 }
 
@@ -642,6 +650,19 @@ func (e *CoreEngine) audioProcessor() {
 		return
 	}
 
+	// Engines that decode incrementally get every chunk as it arrives, so
+	// the DSP work is spread across the slot instead of landing at its end.
+	// Starting the stream here only checks that it can be; streamProcessor
+	// starts it again on a period boundary
+	if streamer, ok := e.dspEngine.(dsp.StreamingDSP); ok {
+		err := streamer.StreamStart([]dsp.JS8Mode{dsp.ModeNormal})
+		if err == nil {
+			e.streamProcessor(streamer, inputSamples)
+			return
+		}
+		log.Printf("Streaming decode unavailable, using buffered decode: %v", err)
+	}
+
 	// Buffer for accumulating samples for decoding
 	var audioBuffer []int16
 	const bufferLimit = 15 * 48000 // 15 seconds at 48kHz max
@@ -682,6 +703,97 @@ func (e *CoreEngine) audioProcessor() {
 	}
 }
 
+// streamGapTolerance is how far the audio may fall behind or run ahead of
+// the clock before the stream is taken to have lost its slot phase
+const streamGapTolerance = 500 * time.Millisecond
+
+// streamProcessor pushes incoming audio straight into a streaming decoder.
+// The stream's slots follow back to back from its first sample, so it is
+// started on a UTC transmission period boundary: the clock places the
+// boundary once, and counting the samples dropped before it makes the
+// phase exact. A gap in the input starts it again the same way.
+func (e *CoreEngine) streamProcessor(streamer dsp.StreamingDSP, inputSamples <-chan []int16) {
+	sampleRate := e.dspEngine.GetSampleRate()
+	period := e.dspEngine.EstimateAudioDuration(dsp.ModeNormal)
+
+	streaming := false
+	aligning := false
+	skip := 0               // Samples still to drop before the boundary
+	var slotStart time.Time // Boundary the stream started on
+	var pushed int64        // Samples pushed since then
+
+	for e.isRunning() {
+		select {
+		case samples := <-inputSamples:
+			now := time.Now()
+			if streaming {
+				expected := slotStart.Add(samplesDuration(pushed+int64(len(samples)), sampleRate))
+				if drift := now.Sub(expected); drift > streamGapTolerance || drift < -streamGapTolerance {
+					log.Printf("Audio stream drifted %v from the clock, realigning to the next period", drift)
+					streaming = false
+				}
+			}
+
+			chunk := samples
+			if !streaming {
+				if !aligning {
+					// The chunk's first sample was taken as long before now
+					// as the chunk lasts
+					first := now.Add(-samplesDuration(int64(len(samples)), sampleRate))
+					slotStart = nextPeriodBoundary(first, period)
+					skip = int(slotStart.Sub(first).Seconds()*float64(sampleRate) + 0.5)
+					aligning = true
+				}
+				if skip >= len(samples) {
+					skip -= len(samples)
+					hardware.RecycleAudioSamples(samples)
+					continue
+				}
+				if err := streamer.StreamStart([]dsp.JS8Mode{dsp.ModeNormal}); err != nil {
+					log.Printf("Failed to start audio stream: %v", err)
+					aligning = false
+					hardware.RecycleAudioSamples(samples)
+					continue
+				}
+				chunk = samples[skip:]
+				streaming = true
+				aligning = false
+				pushed = 0
+			}
+
+			decodeCount, err := streamer.StreamPush(chunk, e.handleDecodeResult)
+			pushed += int64(len(chunk))
+			hardware.RecycleAudioSamples(samples)
+
+			if err != nil {
+				log.Printf("Decode error: %v", err)
+			} else if decodeCount > 0 {
+				log.Printf("Decoded %d message(s) from audio stream", decodeCount)
+			}
+
+		case <-time.After(1 * time.Second):
+			// No audio for a second; the slots in progress are lost
+			streaming = false
+			aligning = false
+		}
+	}
+}
+
+// nextPeriodBoundary returns the first UTC transmission period boundary at
+// or after t
+func nextPeriodBoundary(t time.Time, period time.Duration) time.Time {
+	boundary := t.Truncate(period)
+	if boundary.Before(t) {
+		boundary = boundary.Add(period)
+	}
+	return boundary
+}
+
+// samplesDuration returns how long count samples last at sampleRate
+func samplesDuration(count int64, sampleRate int) time.Duration {
+	return time.Duration(count * int64(time.Second) / int64(sampleRate))
+}
+
 // attemptDecode tries to decode JS8 messages from audio buffer
 func (e *CoreEngine) attemptDecode(audioBuffer []int16) {
 	if len(audioBuffer) == 0 {
@@ -689,19 +801,7 @@ func (e *CoreEngine) attemptDecode(audioBuffer []int16) {
 	}
 
 	// Use DSP to decode the audio buffer
-	decodeCount, err := e.dspEngine.DecodeBuffer(audioBuffer, func(result *dsp.DecodeResult) {
-		// Parse JS8 message to extract callsigns and determine message type
-		msg := e.parseJS8Message(result)
-
-		// Queue the received message
-		select {
-		case e.rxMessages <- msg:
-			log.Printf("RX decoded: %s (SNR: %ddB, Freq: %.1fHz, Type: %s)",
-				result.Message, result.SNR, result.Frequency, e.getMessageType(result.Message))
-		default:
-			log.Printf("RX buffer full, dropping message: %s", result.Message)
-		}
-	})
+	decodeCount, err := e.dspEngine.DecodeBuffer(audioBuffer, e.handleDecodeResult)
 
 	if err != nil {
 		log.Printf("Decode error: %v", err)
@@ -710,6 +810,21 @@ func (e *CoreEngine) attemptDecode(audioBuffer []int16) {
 	}
 }
 
+// handleDecodeResult queues a decoded message for delivery
+func (e *CoreEngine) handleDecodeResult(result *dsp.DecodeResult) {
+	// Parse JS8 message to extract callsigns and determine message type
+	msg := e.parseJS8Message(result)
+
+	// Queue the received message
+	select {
+	case e.rxMessages <- msg:
+		log.Printf("RX decoded: %s (SNR: %ddB, Freq: %.1fHz, Type: %s)",
+			result.Message, result.SNR, result.Frequency, e.getMessageType(result.Message))
+	default:
+		log.Printf("RX buffer full, dropping message: %s", result.Message)
+	}
+}
+
 // parseJS8Message parses a JS8 decode result into a protocol message
 func (e *CoreEngine) parseJS8Message(result *dsp.DecodeResult) protocol.Message {
 	message := result.Message
@@ -1116,10 +1231,62 @@ func (e *CoreEngine) Stop() error {
 		e.hardwareManager.Close()
 	}
 
+	// With audio stopped, keep what the decoder has learned for the next start
+	e.saveDecoderState()
+
 	log.Printf("Core engine stopped")
 	return nil
 }
 
+// loadDecoderState restores the decoder state saved by the last run, so
+// that the first slot after a restart decodes at steady-state speed. A
+// missing or unusable state only costs that speed.
+func (e *CoreEngine) loadDecoderState() {
+	saver, ok := e.dspEngine.(dsp.StateDSP)
+	path := e.config.Storage.DecoderStatePath
+	if !ok || path == "" {
+		return
+	}
+
+	state, err := os.ReadFile(path)
+	if err != nil {
+		if !os.IsNotExist(err) {
+			log.Printf("Warning: failed to read decoder state: %v", err)
+		}
+		return
+	}
+	if err := saver.LoadState(state); err != nil {
+		log.Printf("Warning: %v; starting with a fresh decoder", err)
+		return
+	}
+	log.Printf("Decoder state restored from %s (%d bytes)", path, len(state))
+}
+
+// saveDecoderState writes the decoder state for loadDecoderState, through
+// a temporary file so that a crash never leaves a partial state behind
+func (e *CoreEngine) saveDecoderState() {
+	saver, ok := e.dspEngine.(dsp.StateDSP)
+	path := e.config.Storage.DecoderStatePath
+	if !ok || path == "" {
+		return
+	}
+
+	state, err := saver.SaveState()
+	if err != nil {
+		log.Printf("Warning: failed to save decoder state: %v", err)
+		return
+	}
+	temp := path + ".tmp"
+	if err := os.WriteFile(temp, state, 0644); err != nil {
+		log.Printf("Warning: failed to write decoder state: %v", err)
+		return
+	}
+	if err := os.Rename(temp, path); err != nil {
+		os.Remove(temp)
+		log.Printf("Warning: failed to write decoder state: %v", err)
+	}
+}
+
 // classifyMessage determines the type of a JS8 message
 func (e *CoreEngine) classifyMessage(message string) string {
 	message = strings.ToUpper(strings.TrimSpace(message))
@@ -457,6 +457,37 @@ func TestCoreEngineErrorHandling(t *testing.T) {
 	})
 }
 
+func TestStreamAlignment(t *testing.T) {
+	period := 15 * time.Second
+	base := time.Date(2024, 1, 1, 12, 0, 0, 0, time.UTC)
+
+	t.Run("Next Period Boundary", func(t *testing.T) {
+		cases := []struct {
+			at, want time.Time
+		}{
+			{base, base},
+			{base.Add(time.Millisecond), base.Add(period)},
+			{base.Add(14 * time.Second), base.Add(period)},
+			{base.Add(period), base.Add(period)},
+			{base.Add(59 * time.Second), base.Add(time.Minute)},
+		}
+		for _, c := range cases {
+			if got := nextPeriodBoundary(c.at, period); !got.Equal(c.want) {
+				t.Errorf("Boundary after %v: expected %v, got %v", c.at, c.want, got)
+			}
+		}
+	})
+
+	t.Run("Samples Duration", func(t *testing.T) {
+		if got := samplesDuration(48000, 48000); got != time.Second {
+			t.Errorf("Expected 48000 samples to last 1s, got %v", got)
+		}
+		if got := samplesDuration(1200, 48000); got != 25*time.Millisecond {
+			t.Errorf("Expected 1200 samples to last 25ms, got %v", got)
+		}
+	})
+}
+
 // Helper function to create a basic test configuration
 func createTestConfig(tempDir string) *config.Config {
 	cfg := &config.Config{}